@@ -0,0 +1,448 @@
+#include "item_serializer.h"
+#include "item_store.h"
+#include <charconv>
+#include <cmath>
+#include <array>
+
+namespace openai_agents {
+
+namespace {
+
+template<typename... Ts>
+struct Overloaded : Ts... { using Ts::operator()...; };
+template<typename... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+using ToolCallFields = std::array<std::string_view, 3>;
+
+std::optional<std::string_view> view_of(const std::optional<std::string>& value) {
+    if (!value) return std::nullopt;
+    return std::string_view(*value);
+}
+
+// Escapes without the surrounding quotes, copying unescaped runs in one go
+void append_json_chars(std::string& out, std::string_view value) {
+    static const char* hex = "0123456789abcdef";
+
+    size_t run = 0;
+    for (size_t i = 0; i < value.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(value[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        out.append(value.data() + run, i - run);
+        run = i + 1;
+        switch (c) {
+        case '"': out.append("\\\""); break;
+        case '\\': out.append("\\\\"); break;
+        case '\n': out.append("\\n"); break;
+        case '\r': out.append("\\r"); break;
+        case '\t': out.append("\\t"); break;
+        case '\b': out.append("\\b"); break;
+        case '\f': out.append("\\f"); break;
+        default:
+            out.append("\\u00");
+            out.push_back(hex[c >> 4]);
+            out.push_back(hex[c & 0xf]);
+        }
+    }
+    out.append(value.data() + run, value.size() - run);
+}
+
+template<typename T>
+void append_number(std::string& out, T value) {
+    char digits[32];
+    auto result = std::to_chars(digits, digits + sizeof(digits), value);
+    out.append(digits, result.ptr);
+}
+
+void append_double(std::string& out, double value) {
+    // JSON has no NaN or infinity
+    if (!std::isfinite(value)) {
+        out.append("null");
+        return;
+    }
+    append_number(out, value);
+}
+
+} // namespace
+
+void ItemSerializer::append_json_string(std::string& out, std::string_view value) {
+    out.push_back('"');
+    append_json_chars(out, value);
+    out.push_back('"');
+}
+
+const std::string& ItemSerializer::serialize(const Item& item) {
+    buffer_.clear();
+    append(item);
+    return buffer_;
+}
+
+const std::string& ItemSerializer::serialize(const ItemView& item) {
+    buffer_.clear();
+    append(item);
+    return buffer_;
+}
+
+void ItemSerializer::append(const Item& item) {
+    item.accept(*this);
+}
+
+void ItemSerializer::append(const ItemView& item) {
+    const Item* source = item.get_source();
+    item.visit(Overloaded{
+        [this, source](const MessageRecord& r) {
+            write_message(r.role, r.content, r.name,
+                          source ? &static_cast<const MessageItem*>(source)->get_metadata() : nullptr);
+        },
+        [this](const ToolCallRecord& r) {
+            write_tool_call(r.tool_call_id, r.function_name, r.arguments);
+        },
+        [this](const ToolResponseRecord& r) {
+            write_tool_response(r.tool_call_id, r.content, r.is_error);
+        },
+        [this](const ImageRecord& r) {
+            write_image(r.url, r.detail, r.mime_type);
+        },
+        [this](const FileRecord& r) {
+            write_file(r.path, r.filename, r.mime_type, r.size);
+        },
+        [this, source](const CustomRecord& r) {
+            write_custom(r.type_name, static_cast<const CustomItem*>(source)->get_data());
+        }
+    });
+}
+
+const std::string& ItemSerializer::serialize_list(const std::vector<std::shared_ptr<Item>>& items) {
+    buffer_.clear();
+    if (format_ == ItemFormat::ChatMessage) {
+        write_chat_list(items, [](const std::shared_ptr<Item>& item) -> std::optional<ToolCallFields> {
+            if (item->get_type() != ItemType::Tool) return std::nullopt;
+            const auto& call = static_cast<const ToolCallItem&>(*item);
+            return ToolCallFields{call.get_tool_call_id(), call.get_function_name(), call.get_arguments()};
+        });
+        return buffer_;
+    }
+
+    buffer_.push_back('[');
+    bool first = true;
+    for (const auto& item : items) {
+        if (!item) continue;
+        if (!first) buffer_.push_back(',');
+        first = false;
+        append(*item);
+    }
+    buffer_.push_back(']');
+    return buffer_;
+}
+
+const std::string& ItemSerializer::serialize_list(const ItemStore& items) {
+    buffer_.clear();
+    if (format_ == ItemFormat::ChatMessage) {
+        write_chat_list(items, [](const ItemView& item) -> std::optional<ToolCallFields> {
+            auto* call = item.get_if<ToolCallRecord>();
+            if (!call) return std::nullopt;
+            return ToolCallFields{call->tool_call_id, call->function_name, call->arguments};
+        });
+        return buffer_;
+    }
+
+    buffer_.push_back('[');
+    for (size_t i = 0; i < items.size(); i++) {
+        if (i > 0) buffer_.push_back(',');
+        append(items[i]);
+    }
+    buffer_.push_back(']');
+    return buffer_;
+}
+
+// Consecutive tool calls are one assistant turn in the chat format, so
+// they are merged into a single message
+template<typename Items, typename ToolCallOf>
+void ItemSerializer::write_chat_list(const Items& items, ToolCallOf tool_call_of) {
+    buffer_.push_back('[');
+    bool first = true;
+    bool in_tool_calls = false;
+    for (const auto& item : items) {
+        constexpr bool is_pointer = std::is_same_v<std::decay_t<decltype(item)>, std::shared_ptr<Item>>;
+        if constexpr (is_pointer) {
+            if (!item) continue;
+        }
+
+        auto call = tool_call_of(item);
+        if (call && in_tool_calls) {
+            buffer_.push_back(',');
+            write_tool_call_entry((*call)[0], (*call)[1], (*call)[2]);
+            continue;
+        }
+        if (in_tool_calls) {
+            buffer_.append("]}");
+            in_tool_calls = false;
+        }
+
+        if (!first) buffer_.push_back(',');
+        first = false;
+        if (call) {
+            buffer_.append("{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[");
+            write_tool_call_entry((*call)[0], (*call)[1], (*call)[2]);
+            in_tool_calls = true;
+        } else if constexpr (is_pointer) {
+            append(*item);
+        } else {
+            append(item);
+        }
+    }
+    if (in_tool_calls) {
+        buffer_.append("]}");
+    }
+    buffer_.push_back(']');
+}
+
+// ItemVisitor overrides
+void ItemSerializer::visit(const MessageItem& item) {
+    write_message(item.get_role(), item.get_content(), view_of(item.get_name()), &item.get_metadata());
+}
+
+void ItemSerializer::visit(const ToolCallItem& item) {
+    write_tool_call(item.get_tool_call_id(), item.get_function_name(), item.get_arguments());
+}
+
+void ItemSerializer::visit(const ToolResponseItem& item) {
+    write_tool_response(item.get_tool_call_id(), item.get_content(), item.is_error());
+}
+
+void ItemSerializer::visit(const ImageItem& item) {
+    write_image(item.get_url(), view_of(item.get_detail()), view_of(item.get_mime_type()));
+}
+
+void ItemSerializer::visit(const FileItem& item) {
+    write_file(item.get_path(), item.get_filename(), view_of(item.get_mime_type()), item.get_size());
+}
+
+void ItemSerializer::visit(const CustomItem& item) {
+    write_custom(item.get_type_name(), item.get_data());
+}
+
+// Writers
+void ItemSerializer::write_message(std::string_view role, std::string_view content,
+                                   const std::optional<std::string_view>& name,
+                                   const std::map<std::string, std::any>* metadata) {
+    if (format_ == ItemFormat::Json) {
+        buffer_.append("{\"type\":\"message\"");
+        write_key("role");
+    } else {
+        buffer_.append("{\"role\":");
+    }
+    append_json_string(buffer_, role);
+    write_key("content");
+    append_json_string(buffer_, content);
+    if (name) {
+        write_key("name");
+        append_json_string(buffer_, *name);
+    }
+    // Metadata is local bookkeeping and is not sent to models
+    if (format_ == ItemFormat::Json && metadata && !metadata->empty()) {
+        write_key("metadata");
+        write_map(*metadata);
+    }
+    buffer_.push_back('}');
+}
+
+void ItemSerializer::write_tool_call(std::string_view tool_call_id, std::string_view function_name,
+                                     std::string_view arguments) {
+    if (format_ == ItemFormat::ChatMessage) {
+        buffer_.append("{\"role\":\"assistant\",\"content\":null,\"tool_calls\":[");
+        write_tool_call_entry(tool_call_id, function_name, arguments);
+        buffer_.append("]}");
+        return;
+    }
+
+    buffer_.append("{\"type\":\"tool_call\"");
+    write_key("tool_call_id");
+    append_json_string(buffer_, tool_call_id);
+    write_key("function_name");
+    append_json_string(buffer_, function_name);
+    write_key("arguments");
+    append_json_string(buffer_, arguments);
+    buffer_.push_back('}');
+}
+
+void ItemSerializer::write_tool_call_entry(std::string_view tool_call_id, std::string_view function_name,
+                                           std::string_view arguments) {
+    buffer_.append("{\"id\":");
+    append_json_string(buffer_, tool_call_id);
+    buffer_.append(",\"type\":\"function\",\"function\":{\"name\":");
+    append_json_string(buffer_, function_name);
+    write_key("arguments");
+    append_json_string(buffer_, arguments);
+    buffer_.append("}}");
+}
+
+void ItemSerializer::write_tool_response(std::string_view tool_call_id, std::string_view content, bool is_error) {
+    if (format_ == ItemFormat::ChatMessage) {
+        // The chat format has no error flag; the content carries the error text
+        buffer_.append("{\"role\":\"tool\",\"tool_call_id\":");
+        append_json_string(buffer_, tool_call_id);
+        write_key("content");
+        append_json_string(buffer_, content);
+        buffer_.push_back('}');
+        return;
+    }
+
+    buffer_.append("{\"type\":\"tool_response\"");
+    write_key("tool_call_id");
+    append_json_string(buffer_, tool_call_id);
+    write_key("content");
+    append_json_string(buffer_, content);
+    buffer_.append(is_error ? ",\"is_error\":true}" : ",\"is_error\":false}");
+}
+
+void ItemSerializer::write_image(std::string_view url, const std::optional<std::string_view>& detail,
+                                 const std::optional<std::string_view>& mime_type) {
+    if (format_ == ItemFormat::ChatMessage) {
+        buffer_.append("{\"role\":\"user\",\"content\":[{\"type\":\"image_url\",\"image_url\":{\"url\":");
+        append_json_string(buffer_, url);
+        if (detail) {
+            write_key("detail");
+            append_json_string(buffer_, *detail);
+        }
+        buffer_.append("}}]}");
+        return;
+    }
+
+    buffer_.append("{\"type\":\"image\"");
+    write_key("url");
+    append_json_string(buffer_, url);
+    if (detail) {
+        write_key("detail");
+        append_json_string(buffer_, *detail);
+    }
+    if (mime_type) {
+        write_key("mime_type");
+        append_json_string(buffer_, *mime_type);
+    }
+    buffer_.push_back('}');
+}
+
+void ItemSerializer::write_file(std::string_view path, std::string_view filename,
+                                const std::optional<std::string_view>& mime_type,
+                                const std::optional<size_t>& size) {
+    if (format_ == ItemFormat::ChatMessage) {
+        // Files are referenced by path, which models cannot open; describe
+        // them as text the same way FileItem::to_string() does
+        buffer_.append("{\"role\":\"user\",\"content\":\"[FILE] ");
+        append_json_chars(buffer_, filename);
+        buffer_.append(" (");
+        append_json_chars(buffer_, path);
+        buffer_.push_back(')');
+        if (size) {
+            buffer_.append(" [");
+            append_number(buffer_, *size);
+            buffer_.append(" bytes]");
+        }
+        buffer_.append("\"}");
+        return;
+    }
+
+    buffer_.append("{\"type\":\"file\"");
+    write_key("path");
+    append_json_string(buffer_, path);
+    write_key("filename");
+    append_json_string(buffer_, filename);
+    if (mime_type) {
+        write_key("mime_type");
+        append_json_string(buffer_, *mime_type);
+    }
+    if (size) {
+        write_key("size");
+        append_number(buffer_, *size);
+    }
+    buffer_.push_back('}');
+}
+
+void ItemSerializer::write_custom(std::string_view type_name, const std::map<std::string, std::any>& data) {
+    // Custom items define their own shape, so both formats use the to_dict()
+    // layout; a "type" entry in the data overrides the type name there too
+    buffer_.append("{\"type\":");
+    auto type_override = data.find("type");
+    if (type_override != data.end()) {
+        write_value(type_override->second);
+    } else {
+        append_json_string(buffer_, type_name);
+    }
+    for (const auto& [key, value] : data) {
+        if (key == "type") continue;
+        write_key(key);
+        write_value(value);
+    }
+    buffer_.push_back('}');
+}
+
+void ItemSerializer::write_key(std::string_view key) {
+    buffer_.push_back(',');
+    append_json_string(buffer_, key);
+    buffer_.push_back(':');
+}
+
+void ItemSerializer::write_map(const std::map<std::string, std::any>& map) {
+    buffer_.push_back('{');
+    bool first = true;
+    for (const auto& [key, value] : map) {
+        if (!first) buffer_.push_back(',');
+        first = false;
+        append_json_string(buffer_, key);
+        buffer_.push_back(':');
+        write_value(value);
+    }
+    buffer_.push_back('}');
+}
+
+// Same value types ItemCodec persists; anything else is written as null
+void ItemSerializer::write_value(const std::any& value) {
+    if (!value.has_value()) {
+        buffer_.append("null");
+    } else if (auto v = std::any_cast<std::string>(&value)) {
+        append_json_string(buffer_, *v);
+    } else if (auto v = std::any_cast<const char*>(&value)) {
+        append_json_string(buffer_, *v ? *v : "");
+    } else if (auto v = std::any_cast<bool>(&value)) {
+        buffer_.append(*v ? "true" : "false");
+    } else if (auto v = std::any_cast<int>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<long>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<long long>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<unsigned int>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<unsigned long>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<unsigned long long>(&value)) {
+        append_number(buffer_, *v);
+    } else if (auto v = std::any_cast<double>(&value)) {
+        append_double(buffer_, *v);
+    } else if (auto v = std::any_cast<float>(&value)) {
+        append_double(buffer_, *v);
+    } else if (auto v = std::any_cast<std::map<std::string, std::any>>(&value)) {
+        write_map(*v);
+    } else if (auto v = std::any_cast<std::vector<std::any>>(&value)) {
+        buffer_.push_back('[');
+        for (size_t i = 0; i < v->size(); i++) {
+            if (i > 0) buffer_.push_back(',');
+            write_value((*v)[i]);
+        }
+        buffer_.push_back(']');
+    } else if (auto v = std::any_cast<std::vector<std::string>>(&value)) {
+        buffer_.push_back('[');
+        for (size_t i = 0; i < v->size(); i++) {
+            if (i > 0) buffer_.push_back(',');
+            append_json_string(buffer_, (*v)[i]);
+        }
+        buffer_.push_back(']');
+    } else {
+        buffer_.append("null");
+    }
+}
+
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,92 @@
+#pragma once
+
+/**
+ * Direct serialization of conversation items
+ *
+ * ItemSerializer walks items with ItemVisitor and appends text straight to
+ * a buffer it keeps between calls, so serializing a history allocates
+ * nothing once the buffer has grown to size. Two formats are supported:
+ *
+ *   Json         - the object Item::to_dict() describes, e.g.
+ *                  {"type":"message","role":"user","content":"hi"}
+ *   ChatMessage  - the message objects the Chat Completions API accepts;
+ *                  tool calls become assistant "tool_calls" entries and
+ *                  tool responses become "tool" role messages
+ */
+
+#include "items.h"
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace openai_agents {
+
+class ItemView;
+class ItemStore;
+
+enum class ItemFormat {
+    Json,
+    ChatMessage
+};
+
+class ItemSerializer : private ItemVisitor {
+private:
+    ItemFormat format_;
+    std::string buffer_;
+
+public:
+    explicit ItemSerializer(ItemFormat format = ItemFormat::Json) : format_(format) {}
+
+    ItemFormat get_format() const { return format_; }
+    void set_format(ItemFormat format) { format_ = format; }
+
+    // Serialize into a fresh buffer; the reference is valid until the next call
+    const std::string& serialize(const Item& item);
+    const std::string& serialize(const ItemView& item);
+    const std::string& serialize_list(const std::vector<std::shared_ptr<Item>>& items);
+    const std::string& serialize_list(const ItemStore& items);
+
+    // Append one value to whatever the buffer already holds
+    void append(const Item& item);
+    void append(const ItemView& item);
+
+    const std::string& str() const { return buffer_; }
+    std::string take() { return std::move(buffer_); }
+    void clear() { buffer_.clear(); }
+    void reserve(size_t size) { buffer_.reserve(size); }
+
+    // JSON string literal for a value, with quotes
+    static void append_json_string(std::string& out, std::string_view value);
+
+private:
+    void visit(const MessageItem& item) override;
+    void visit(const ToolCallItem& item) override;
+    void visit(const ToolResponseItem& item) override;
+    void visit(const ImageItem& item) override;
+    void visit(const FileItem& item) override;
+    void visit(const CustomItem& item) override;
+
+    // Shared by the Item and ItemView paths
+    void write_message(std::string_view role, std::string_view content,
+                       const std::optional<std::string_view>& name,
+                       const std::map<std::string, std::any>* metadata);
+    void write_tool_call(std::string_view tool_call_id, std::string_view function_name,
+                         std::string_view arguments);
+    void write_tool_call_entry(std::string_view tool_call_id, std::string_view function_name,
+                               std::string_view arguments);
+    void write_tool_response(std::string_view tool_call_id, std::string_view content, bool is_error);
+    void write_image(std::string_view url, const std::optional<std::string_view>& detail,
+                     const std::optional<std::string_view>& mime_type);
+    void write_file(std::string_view path, std::string_view filename,
+                    const std::optional<std::string_view>& mime_type, const std::optional<size_t>& size);
+    void write_custom(std::string_view type_name, const std::map<std::string, std::any>& data);
+
+    void write_key(std::string_view key);
+    void write_value(const std::any& value);
+    void write_map(const std::map<std::string, std::any>& map);
+
+    template<typename Items, typename ToolCallOf>
+    void write_chat_list(const Items& items, ToolCallOf tool_call_of);
+};
+
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,315 @@
+#include "item_store.h"
+#include "exceptions.h"
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace openai_agents {
+
+namespace {
+
+template<typename... Ts>
+struct Overloaded : Ts... { using Ts::operator()...; };
+template<typename... Ts>
+Overloaded(Ts...) -> Overloaded<Ts...>;
+
+std::optional<std::string> to_optional_string(const std::optional<std::string_view>& value) {
+    if (!value) return std::nullopt;
+    return std::string(*value);
+}
+
+} // namespace
+
+// StringArena implementation
+StringArena::StringArena(size_t chunk_size) : chunk_size_(std::max<size_t>(chunk_size, 256)) {}
+
+StringArena::StringArena(StringArena&& other) noexcept
+    : chunk_size_(other.chunk_size_) {
+    *this = std::move(other);
+}
+
+StringArena& StringArena::operator=(StringArena&& other) noexcept {
+    // The moved-from arena must not keep bumping into chunks it gave away
+    chunks_ = std::move(other.chunks_);
+    cursor_ = std::exchange(other.cursor_, nullptr);
+    remaining_ = std::exchange(other.remaining_, 0);
+    chunk_size_ = other.chunk_size_;
+    bytes_used_ = std::exchange(other.bytes_used_, 0);
+    bytes_reserved_ = std::exchange(other.bytes_reserved_, 0);
+    other.chunks_.clear();
+    return *this;
+}
+
+std::string_view StringArena::store(std::string_view value) {
+    if (value.empty()) {
+        return std::string_view();
+    }
+
+    bytes_used_ += value.size();
+    if (value.size() > remaining_) {
+        if (value.size() > chunk_size_ / 4) {
+            // Large strings get their own chunk so the current one is not wasted
+            auto chunk = std::make_unique<char[]>(value.size());
+            std::memcpy(chunk.get(), value.data(), value.size());
+            std::string_view stored(chunk.get(), value.size());
+            chunks_.insert(chunks_.end() - (chunks_.empty() ? 0 : 1), std::move(chunk));
+            bytes_reserved_ += value.size();
+            return stored;
+        }
+        chunks_.push_back(std::make_unique<char[]>(chunk_size_));
+        cursor_ = chunks_.back().get();
+        remaining_ = chunk_size_;
+        bytes_reserved_ += chunk_size_;
+    }
+
+    std::memcpy(cursor_, value.data(), value.size());
+    std::string_view stored(cursor_, value.size());
+    cursor_ += value.size();
+    remaining_ -= value.size();
+    return stored;
+}
+
+void StringArena::reset() {
+    bytes_used_ = 0;
+
+    // Keep the active bump chunk; it is always last and always full-sized
+    if (cursor_) {
+        auto active = std::move(chunks_.back());
+        chunks_.clear();
+        chunks_.push_back(std::move(active));
+        cursor_ = chunks_.back().get();
+        remaining_ = chunk_size_;
+        bytes_reserved_ = chunk_size_;
+    } else {
+        chunks_.clear();
+        bytes_reserved_ = 0;
+    }
+}
+
+// ItemView implementation
+std::string_view ItemView::get_role() const {
+    if (auto* message = std::get_if<MessageRecord>(record_)) {
+        return message->role;
+    }
+    return std::string_view();
+}
+
+std::string_view ItemView::get_content() const {
+    if (auto* message = std::get_if<MessageRecord>(record_)) {
+        return message->content;
+    }
+    if (auto* response = std::get_if<ToolResponseRecord>(record_)) {
+        return response->content;
+    }
+    return std::string_view();
+}
+
+const Item* ItemView::get_source() const {
+    uint32_t source = std::visit(Overloaded{
+        [](const MessageRecord& r) { return r.source; },
+        [](const ToolCallRecord& r) { return r.source; },
+        [](const CustomRecord& r) { return r.source; },
+        [](const auto&) { return ItemStore::kNoSource; }
+    }, *record_);
+    return source == ItemStore::kNoSource ? nullptr : store_->sources_[source].get();
+}
+
+std::string ItemView::to_string() const {
+    std::string out;
+    append_to_string(out);
+    return out;
+}
+
+void ItemView::append_to_string(std::string& out) const {
+    std::visit(Overloaded{
+        [&out](const MessageRecord& r) {
+            out.append("[").append(r.role).append("]");
+            if (r.name) {
+                out.append(" (").append(*r.name).append(")");
+            }
+            out.append(": ").append(r.content);
+        },
+        [&out](const ToolCallRecord& r) {
+            out.append("[TOOL_CALL] ").append(r.function_name).append("(").append(r.arguments).append(")");
+        },
+        [&out](const ToolResponseRecord& r) {
+            out.append(r.is_error ? "[TOOL_RESPONSE_ERROR] " : "[TOOL_RESPONSE] ").append(r.content);
+        },
+        [&out](const ImageRecord& r) {
+            out.append("[IMAGE] ").append(r.url);
+            if (r.detail) {
+                out.append(" (detail: ").append(*r.detail).append(")");
+            }
+        },
+        [&out](const FileRecord& r) {
+            out.append("[FILE] ").append(r.filename).append(" (").append(r.path).append(")");
+            if (r.size) {
+                out.append(" [").append(std::to_string(*r.size)).append(" bytes]");
+            }
+        },
+        [&out](const CustomRecord& r) {
+            out.append("[").append(r.type_name).append("]");
+        }
+    }, *record_);
+}
+
+std::shared_ptr<Item> ItemView::to_item() const {
+    const Item* source = get_source();
+    return std::visit(Overloaded{
+        [source](const MessageRecord& r) -> std::shared_ptr<Item> {
+            auto* original = static_cast<const MessageItem*>(source);
+            return std::make_shared<MessageItem>(
+                std::string(r.role), std::string(r.content), to_optional_string(r.name),
+                original ? original->get_metadata() : std::map<std::string, std::any>());
+        },
+        [source](const ToolCallRecord& r) -> std::shared_ptr<Item> {
+            auto* original = static_cast<const ToolCallItem*>(source);
+            return std::make_shared<ToolCallItem>(
+                std::string(r.tool_call_id), std::string(r.function_name), std::string(r.arguments),
+                original ? original->get_tool() : nullptr);
+        },
+        [](const ToolResponseRecord& r) -> std::shared_ptr<Item> {
+            return std::make_shared<ToolResponseItem>(std::string(r.tool_call_id), std::string(r.content), r.is_error);
+        },
+        [](const ImageRecord& r) -> std::shared_ptr<Item> {
+            return std::make_shared<ImageItem>(std::string(r.url), to_optional_string(r.detail),
+                                               to_optional_string(r.mime_type));
+        },
+        [](const FileRecord& r) -> std::shared_ptr<Item> {
+            return std::make_shared<FileItem>(std::string(r.path), std::string(r.filename),
+                                              to_optional_string(r.mime_type), r.size);
+        },
+        [source](const CustomRecord&) -> std::shared_ptr<Item> {
+            return std::make_shared<CustomItem>(*static_cast<const CustomItem*>(source));
+        }
+    }, *record_);
+}
+
+// ItemStore implementation
+ItemStore::ItemStore(size_t arena_chunk_size) : arena_(arena_chunk_size) {}
+
+uint32_t ItemStore::add_source(std::shared_ptr<const Item> source) {
+    sources_.push_back(std::move(source));
+    return static_cast<uint32_t>(sources_.size() - 1);
+}
+
+std::optional<std::string_view> ItemStore::store_optional(const std::optional<std::string>& value) {
+    if (!value) return std::nullopt;
+    return arena_.store(*value);
+}
+
+void ItemStore::add_item(const Item& item) {
+    add_record(item, nullptr);
+}
+
+void ItemStore::add_item(const std::shared_ptr<Item>& item) {
+    if (item) {
+        add_record(*item, item);
+    }
+}
+
+void ItemStore::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    records_.reserve(records_.size() + items.size());
+    for (const auto& item : items) {
+        add_item(item);
+    }
+}
+
+void ItemStore::add_record(const Item& item, const std::shared_ptr<Item>& shared) {
+    // Keeps the caller's object when available, otherwise a copy of it
+    auto source_of = [&shared](const auto& typed) -> std::shared_ptr<const Item> {
+        if (shared) return shared;
+        return std::make_shared<std::decay_t<decltype(typed)>>(typed);
+    };
+
+    if (auto* message = dynamic_cast<const MessageItem*>(&item)) {
+        records_.push_back(MessageRecord{
+            arena_.store(message->get_role()), arena_.store(message->get_content()),
+            store_optional(message->get_name()),
+            message->get_metadata().empty() ? kNoSource : add_source(source_of(*message))});
+    } else if (auto* call = dynamic_cast<const ToolCallItem*>(&item)) {
+        records_.push_back(ToolCallRecord{
+            arena_.store(call->get_tool_call_id()), arena_.store(call->get_function_name()),
+            arena_.store(call->get_arguments()),
+            call->get_tool() ? add_source(source_of(*call)) : kNoSource});
+    } else if (auto* response = dynamic_cast<const ToolResponseItem*>(&item)) {
+        records_.push_back(ToolResponseRecord{
+            arena_.store(response->get_tool_call_id()), arena_.store(response->get_content()),
+            response->is_error()});
+    } else if (auto* image = dynamic_cast<const ImageItem*>(&item)) {
+        records_.push_back(ImageRecord{
+            arena_.store(image->get_url()), store_optional(image->get_detail()),
+            store_optional(image->get_mime_type())});
+    } else if (auto* file = dynamic_cast<const FileItem*>(&item)) {
+        records_.push_back(FileRecord{
+            arena_.store(file->get_path()), arena_.store(file->get_filename()),
+            store_optional(file->get_mime_type()), file->get_size()});
+    } else if (auto* custom = dynamic_cast<const CustomItem*>(&item)) {
+        records_.push_back(CustomRecord{arena_.store(custom->get_type_name()), add_source(source_of(*custom))});
+    } else {
+        throw AgentsException("ItemStore cannot store item: " + item.to_string());
+    }
+}
+
+void ItemStore::add_message(std::string_view role, std::string_view content,
+                            const std::optional<std::string_view>& name) {
+    std::optional<std::string_view> stored_name;
+    if (name) {
+        stored_name = arena_.store(*name);
+    }
+    records_.push_back(MessageRecord{arena_.store(role), arena_.store(content), stored_name, kNoSource});
+}
+
+void ItemStore::add_tool_call(std::string_view tool_call_id, std::string_view function_name,
+                              std::string_view arguments) {
+    records_.push_back(ToolCallRecord{
+        arena_.store(tool_call_id), arena_.store(function_name), arena_.store(arguments), kNoSource});
+}
+
+void ItemStore::add_tool_response(std::string_view tool_call_id, std::string_view content, bool is_error) {
+    records_.push_back(ToolResponseRecord{arena_.store(tool_call_id), arena_.store(content), is_error});
+}
+
+size_t ItemStore::count(ItemType type) const {
+    return static_cast<size_t>(std::count_if(records_.begin(), records_.end(), [type](const ItemRecord& record) {
+        return record.index() == static_cast<size_t>(type);
+    }));
+}
+
+std::vector<std::shared_ptr<Item>> ItemStore::to_items() const {
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(records_.size());
+    for (auto view : *this) {
+        items.push_back(view.to_item());
+    }
+    return items;
+}
+
+std::string ItemStore::to_string() const {
+    std::string out;
+    out.reserve(arena_.bytes_used() + records_.size() * 16);
+    for (size_t i = 0; i < records_.size(); ++i) {
+        if (i > 0) out.push_back('\n');
+        (*this)[i].append_to_string(out);
+    }
+    return out;
+}
+
+void ItemStore::pop_back() {
+    if (records_.empty()) return;
+
+    // Sources are appended in record order, so the last one can go too
+    const Item* source = back().get_source();
+    records_.pop_back();
+    if (source) {
+        sources_.pop_back();
+    }
+}
+
+void ItemStore::clear() {
+    records_.clear();
+    sources_.clear();
+    arena_.reset();
+}
+
+} // namespace openai_agents
\ No newline at end of file
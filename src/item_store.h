@@ -0,0 +1,208 @@
+#pragma once
+
+/**
+ * Contiguous storage for conversation items
+ *
+ * ItemStore keeps a history as a vector of tagged records whose strings
+ * live in an arena owned by the store, so a long conversation costs a few
+ * large allocations instead of a heap object and refcount per item. Records
+ * are read through ItemView, a two-pointer handle that needs no virtual
+ * dispatch. Fields that cannot be flattened (message metadata, custom item
+ * data, tool pointers) stay on a shared copy of the original item.
+ */
+
+#include "items.h"
+#include <string_view>
+#include <variant>
+#include <cstdint>
+#include <iterator>
+
+namespace openai_agents {
+
+// Bump allocator for string payloads; stored bytes never move until reset()
+class StringArena {
+private:
+    std::vector<std::unique_ptr<char[]>> chunks_;
+    char* cursor_ = nullptr;
+    size_t remaining_ = 0;
+    size_t chunk_size_;
+    size_t bytes_used_ = 0;
+    size_t bytes_reserved_ = 0;
+
+public:
+    explicit StringArena(size_t chunk_size = 64 * 1024);
+
+    StringArena(StringArena&& other) noexcept;
+    StringArena& operator=(StringArena&& other) noexcept;
+    StringArena(const StringArena&) = delete;
+    StringArena& operator=(const StringArena&) = delete;
+
+    std::string_view store(std::string_view value);
+
+    // Drops every string but keeps the active chunk for reuse
+    void reset();
+
+    size_t bytes_used() const { return bytes_used_; }
+    size_t bytes_reserved() const { return bytes_reserved_; }
+};
+
+// Flattened item records; the alternative index matches ItemType
+struct MessageRecord {
+    std::string_view role;
+    std::string_view content;
+    std::optional<std::string_view> name;
+    uint32_t source;
+};
+
+struct ToolCallRecord {
+    std::string_view tool_call_id;
+    std::string_view function_name;
+    std::string_view arguments;
+    uint32_t source;
+};
+
+struct ToolResponseRecord {
+    std::string_view tool_call_id;
+    std::string_view content;
+    bool is_error;
+};
+
+struct ImageRecord {
+    std::string_view url;
+    std::optional<std::string_view> detail;
+    std::optional<std::string_view> mime_type;
+};
+
+struct FileRecord {
+    std::string_view path;
+    std::string_view filename;
+    std::optional<std::string_view> mime_type;
+    std::optional<size_t> size;
+};
+
+struct CustomRecord {
+    std::string_view type_name;
+    uint32_t source;
+};
+
+using ItemRecord = std::variant<MessageRecord, ToolCallRecord, ToolResponseRecord,
+                                ImageRecord, FileRecord, CustomRecord>;
+
+class ItemStore;
+
+// Read-only handle to one stored item; valid until the store is cleared,
+// moved or popped past it
+class ItemView {
+private:
+    const ItemStore* store_;
+    const ItemRecord* record_;
+
+public:
+    ItemView(const ItemStore* store, const ItemRecord* record) : store_(store), record_(record) {}
+
+    ItemType get_type() const { return static_cast<ItemType>(record_->index()); }
+    const ItemRecord& record() const { return *record_; }
+
+    template<typename T>
+    const T* get_if() const { return std::get_if<T>(record_); }
+
+    template<typename F>
+    decltype(auto) visit(F&& func) const { return std::visit(std::forward<F>(func), *record_); }
+
+    // Message role, or empty for other items
+    std::string_view get_role() const;
+    // Message or tool response text, or empty for other items
+    std::string_view get_content() const;
+
+    // Original item backing fields that are not flattened, or null
+    const Item* get_source() const;
+
+    // Same text as Item::to_string()
+    std::string to_string() const;
+    void append_to_string(std::string& out) const;
+
+    // Builds a standalone Item for APIs that take shared_ptr<Item>
+    std::shared_ptr<Item> to_item() const;
+};
+
+class ItemStore {
+private:
+    StringArena arena_;
+    std::vector<ItemRecord> records_;
+    std::vector<std::shared_ptr<const Item>> sources_;
+
+    friend class ItemView;
+
+public:
+    static constexpr uint32_t kNoSource = UINT32_MAX;
+
+    class const_iterator {
+    private:
+        const ItemStore* store_;
+        std::vector<ItemRecord>::const_iterator it_;
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = ItemView;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = ItemView;
+
+        const_iterator(const ItemStore* store, std::vector<ItemRecord>::const_iterator it)
+            : store_(store), it_(it) {}
+
+        ItemView operator*() const { return ItemView(store_, &*it_); }
+        const_iterator& operator++() { ++it_; return *this; }
+        const_iterator operator++(int) { auto copy = *this; ++it_; return copy; }
+        bool operator==(const const_iterator& other) const { return it_ == other.it_; }
+        bool operator!=(const const_iterator& other) const { return it_ != other.it_; }
+    };
+
+    explicit ItemStore(size_t arena_chunk_size = 64 * 1024);
+
+    ItemStore(ItemStore&&) noexcept = default;
+    ItemStore& operator=(ItemStore&&) noexcept = default;
+    ItemStore(const ItemStore&) = delete;
+    ItemStore& operator=(const ItemStore&) = delete;
+
+    // Adding copies strings into the arena; passing a shared_ptr lets the
+    // store keep the original instead of copying fields it cannot flatten
+    void add_item(const Item& item);
+    void add_item(const std::shared_ptr<Item>& item);
+    void add_items(const std::vector<std::shared_ptr<Item>>& items);
+
+    void add_message(std::string_view role, std::string_view content,
+                     const std::optional<std::string_view>& name = std::nullopt);
+    void add_tool_call(std::string_view tool_call_id, std::string_view function_name,
+                       std::string_view arguments);
+    void add_tool_response(std::string_view tool_call_id, std::string_view content, bool is_error = false);
+
+    // Access
+    size_t size() const { return records_.size(); }
+    bool empty() const { return records_.empty(); }
+    void reserve(size_t count) { records_.reserve(count); }
+    ItemView operator[](size_t index) const { return ItemView(this, &records_[index]); }
+    ItemView back() const { return ItemView(this, &records_.back()); }
+    const_iterator begin() const { return const_iterator(this, records_.begin()); }
+    const_iterator end() const { return const_iterator(this, records_.end()); }
+
+    size_t count(ItemType type) const;
+
+    // Conversion
+    std::vector<std::shared_ptr<Item>> to_items() const;
+    std::string to_string() const;
+
+    // Removing the last item leaves its strings in the arena until clear()
+    void pop_back();
+    void clear();
+
+    size_t arena_bytes_used() const { return arena_.bytes_used(); }
+    size_t arena_bytes_reserved() const { return arena_.bytes_reserved(); }
+
+private:
+    uint32_t add_source(std::shared_ptr<const Item> source);
+    void add_record(const Item& item, const std::shared_ptr<Item>& shared);
+    std::optional<std::string_view> store_optional(const std::optional<std::string>& value);
+};
+
+} // namespace openai_agents
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include "items.h"
 #include "tool.h"
+#include "item_serializer.h"
 #include <sstream>
 
 namespace openai_agents {
@@ -209,6 +210,18 @@ std::vector<std::map<std::string, std::any>> ItemCollection::to_dict_list() cons
     return dicts;
 }
 
+std::string ItemCollection::to_json() const {
+    ItemSerializer serializer(ItemFormat::Json);
+    serializer.serialize_list(items_);
+    return serializer.take();
+}
+
+std::string ItemCollection::to_chat_messages() const {
+    ItemSerializer serializer(ItemFormat::ChatMessage);
+    serializer.serialize_list(items_);
+    return serializer.take();
+}
+
 std::string ItemCollection::to_string() const {
     std::ostringstream oss;
     for (size_t i = 0; i < items_.size(); ++i) {
@@ -15,6 +15,12 @@ namespace openai_agents {
 
 // Forward declarations
 class Tool;
+class MessageItem;
+class ToolCallItem;
+class ToolResponseItem;
+class ImageItem;
+class FileItem;
+class CustomItem;
 
 // Base item types
 enum class ItemType {
@@ -26,12 +32,28 @@ enum class ItemType {
     Custom
 };
 
+// Double dispatch over the concrete item types
+class ItemVisitor {
+public:
+    virtual ~ItemVisitor() = default;
+    virtual void visit(const MessageItem& item) = 0;
+    virtual void visit(const ToolCallItem& item) = 0;
+    virtual void visit(const ToolResponseItem& item) = 0;
+    virtual void visit(const ImageItem& item) = 0;
+    virtual void visit(const FileItem& item) = 0;
+    virtual void visit(const CustomItem& item) = 0;
+};
+
 // Base item class
 class Item {
 public:
     virtual ~Item() = default;
     virtual ItemType get_type() const = 0;
     virtual std::string to_string() const = 0;
+    virtual void accept(ItemVisitor& visitor) const = 0;
+
+    // Generic form kept for compatibility; ItemSerializer writes JSON
+    // without building the intermediate map
     virtual std::map<std::string, std::any> to_dict() const = 0;
 };
 
@@ -50,6 +72,7 @@ public:
 
     ItemType get_type() const override { return ItemType::Message; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -78,6 +101,7 @@ public:
 
     ItemType get_type() const override { return ItemType::Tool; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -99,6 +123,7 @@ public:
 
     ItemType get_type() const override { return ItemType::Response; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -121,6 +146,7 @@ public:
 
     ItemType get_type() const override { return ItemType::Image; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -144,6 +170,7 @@ public:
 
     ItemType get_type() const override { return ItemType::File; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -164,6 +191,7 @@ public:
 
     ItemType get_type() const override { return ItemType::Custom; }
     std::string to_string() const override;
+    void accept(ItemVisitor& visitor) const override { visitor.visit(*this); }
     std::map<std::string, std::any> to_dict() const override;
 
     // Getters
@@ -197,6 +225,8 @@ public:
     // Conversion
     std::vector<std::map<std::string, std::any>> to_dict_list() const;
     std::string to_string() const;
+    std::string to_json() const;           // JSON array of to_dict() objects
+    std::string to_chat_messages() const;  // Chat Completions "messages" array
 
     // Clear
     void clear() { items_.clear(); }
@@ -9,7 +9,13 @@
  */
 
 // Core session interface and implementations
+#include "executor.h"
 #include "session.h"
+#include "log_session.h"
+#include "item_codec.h"
+#include "session_archive.h"
+#include "timer_wheel.h"
+#include "vector_memory.h"
 #include "util.h"
 #include "examples.h"
 
@@ -21,8 +27,25 @@ using Session = Session;
 using SessionBase = SessionBase;
 using SQLiteSession = SQLiteSession;
 using MemorySession = MemorySession;
+using RingMemorySession = RingMemorySession;
+using WriteBehindSession = WriteBehindSession;
+using VectorMemorySession = VectorMemorySession;
+using LogSession = LogSession;
 using SessionManager = SessionManager;
+using IdleExpiryOptions = IdleExpiryOptions;
+using IdleExpiryStats = IdleExpiryStats;
+using TimerWheel = TimerWheel;
+using Embedder = Embedder;
+using HashingEmbedder = HashingEmbedder;
+using HnswIndex = HnswIndex;
+using VectorMemory = VectorMemory;
 using SessionFactory = SessionFactory;
+using ItemCodec = ItemCodec;
+using SessionArchiveWriter = SessionArchiveWriter;
+using SessionArchiveReader = SessionArchiveReader;
+using SessionExecutor = SessionExecutor;
+using ThreadPoolExecutor = ThreadPoolExecutor;
+using InlineExecutor = InlineExecutor;
 
 // Utility classes
 using SessionUtils = SessionUtils;
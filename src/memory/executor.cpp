@@ -0,0 +1,89 @@
+#include "executor.h"
+#include <algorithm>
+
+namespace openai_agents {
+namespace memory {
+
+// ThreadPoolExecutor implementation
+ThreadPoolExecutor::ThreadPoolExecutor(size_t thread_count, size_t max_queue_size)
+    : max_queue_size_(max_queue_size) {
+    thread_count = std::max<size_t>(thread_count, 1);
+    workers_.reserve(thread_count);
+    for (size_t i = 0; i < thread_count; i++) {
+        workers_.emplace_back([this]() { worker_loop(); });
+    }
+}
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    for (auto& worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void ThreadPoolExecutor::execute(std::function<void()> task) {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!stopping_ && queue_.size() < max_queue_size_) {
+            queue_.push_back(std::move(task));
+            cv_.notify_one();
+            return;
+        }
+    }
+
+    // Queue full (or shutting down): run on the caller
+    task();
+}
+
+size_t ThreadPoolExecutor::queued_count() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return queue_.size();
+}
+
+void ThreadPoolExecutor::worker_loop() {
+    while (true) {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this]() { return stopping_ || !queue_.empty(); });
+            if (queue_.empty()) {
+                return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop_front();
+        }
+        task();
+    }
+}
+
+// Shared executors
+static std::mutex default_executor_mutex;
+static std::shared_ptr<SessionExecutor> default_executor;
+
+std::shared_ptr<SessionExecutor> get_default_session_executor() {
+    std::lock_guard<std::mutex> lock(default_executor_mutex);
+    if (!default_executor) {
+        default_executor = std::make_shared<ThreadPoolExecutor>(
+            std::max<size_t>(std::thread::hardware_concurrency(), 4));
+    }
+    return default_executor;
+}
+
+void set_default_session_executor(std::shared_ptr<SessionExecutor> executor) {
+    std::lock_guard<std::mutex> lock(default_executor_mutex);
+    default_executor = std::move(executor);
+}
+
+std::shared_ptr<SessionExecutor> get_inline_session_executor() {
+    static auto inline_executor = std::make_shared<InlineExecutor>();
+    return inline_executor;
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,75 @@
+#pragma once
+
+/**
+ * Executors that run session I/O off the caller's thread
+ */
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <vector>
+#include <type_traits>
+
+namespace openai_agents {
+namespace memory {
+
+// Executor interface for session operations
+class SessionExecutor {
+public:
+    virtual ~SessionExecutor() = default;
+
+    virtual void execute(std::function<void()> task) = 0;
+
+    // Run a callable on this executor and return its result as a future
+    template<typename F>
+    auto submit(F&& func) -> std::future<std::invoke_result_t<F>> {
+        using ResultType = std::invoke_result_t<F>;
+        auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+        auto future = task->get_future();
+        execute([task]() { (*task)(); });
+        return future;
+    }
+};
+
+// Runs tasks on the calling thread, so futures are ready on return
+class InlineExecutor : public SessionExecutor {
+public:
+    void execute(std::function<void()> task) override { task(); }
+};
+
+// Fixed-size worker pool with a bounded queue. When the queue is full the
+// task runs on the submitting thread, which throttles producers and keeps
+// tasks that submit more work from deadlocking the pool.
+class ThreadPoolExecutor : public SessionExecutor {
+private:
+    std::vector<std::thread> workers_;
+    std::deque<std::function<void()>> queue_;
+    size_t max_queue_size_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+
+public:
+    ThreadPoolExecutor(size_t thread_count = 4, size_t max_queue_size = 1024);
+    ~ThreadPoolExecutor();
+
+    void execute(std::function<void()> task) override;
+
+    size_t thread_count() const { return workers_.size(); }
+    size_t queued_count();
+
+private:
+    void worker_loop();
+};
+
+// Shared executors
+std::shared_ptr<SessionExecutor> get_default_session_executor();
+void set_default_session_executor(std::shared_ptr<SessionExecutor> executor);
+std::shared_ptr<SessionExecutor> get_inline_session_executor();
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,491 @@
+#include "item_codec.h"
+#include "../exceptions.h"
+#include <nlohmann/json.hpp>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+namespace openai_agents {
+namespace memory {
+
+namespace {
+
+// Tags for values held in std::any
+enum class ValueTag : uint8_t {
+    Null = 0,
+    False = 1,
+    True = 2,
+    Integer = 3,
+    Double = 4,
+    String = 5,
+    Map = 6,
+    List = 7
+};
+
+// Maps and lists nested deeper than this are rejected on both sides, so
+// decoding a crafted record cannot exhaust the stack
+constexpr int kMaxNestingDepth = 64;
+
+class RecordWriter {
+private:
+    std::string& out_;
+
+public:
+    explicit RecordWriter(std::string& out) : out_(out) {}
+
+    void put_byte(uint8_t value) {
+        out_.push_back(static_cast<char>(value));
+    }
+
+    void put_varint(uint64_t value) {
+        while (value >= 0x80) {
+            put_byte(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        put_byte(static_cast<uint8_t>(value));
+    }
+
+    void put_signed(int64_t value) {
+        // Zigzag so small negative numbers stay short
+        put_varint((static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+    }
+
+    void put_string(const std::string& value) {
+        put_varint(value.size());
+        out_.append(value);
+    }
+
+    void put_optional(const std::optional<std::string>& value) {
+        put_byte(value ? 1 : 0);
+        if (value) {
+            put_string(*value);
+        }
+    }
+
+    void put_double(double value) {
+        char bytes[sizeof(double)];
+        std::memcpy(bytes, &value, sizeof(double));
+        out_.append(bytes, sizeof(double));
+    }
+
+    void put_map(const std::map<std::string, std::any>& map, int depth = 0) {
+        if (depth > kMaxNestingDepth) {
+            throw AgentsException("Cannot encode item: values nested too deeply");
+        }
+        put_varint(map.size());
+        for (const auto& [key, value] : map) {
+            put_string(key);
+            put_value(value, depth);
+        }
+    }
+
+    // Throws for value types the record format has no tag for, rather than
+    // dropping them
+    void put_value(const std::any& value, int depth) {
+        if (!value.has_value()) {
+            put_byte(static_cast<uint8_t>(ValueTag::Null));
+        } else if (auto v = std::any_cast<std::string>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::String));
+            put_string(*v);
+        } else if (auto v = std::any_cast<const char*>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::String));
+            put_string(*v ? *v : "");
+        } else if (auto v = std::any_cast<bool>(&value)) {
+            put_byte(static_cast<uint8_t>(*v ? ValueTag::True : ValueTag::False));
+        } else if (auto v = std::any_cast<int>(&value)) {
+            put_integer(*v);
+        } else if (auto v = std::any_cast<long>(&value)) {
+            put_integer(*v);
+        } else if (auto v = std::any_cast<long long>(&value)) {
+            put_integer(*v);
+        } else if (auto v = std::any_cast<unsigned int>(&value)) {
+            put_integer(*v);
+        } else if (auto v = std::any_cast<unsigned long>(&value)) {
+            put_integer(static_cast<int64_t>(*v));
+        } else if (auto v = std::any_cast<unsigned long long>(&value)) {
+            put_integer(static_cast<int64_t>(*v));
+        } else if (auto v = std::any_cast<double>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::Double));
+            put_double(*v);
+        } else if (auto v = std::any_cast<float>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::Double));
+            put_double(*v);
+        } else if (auto v = std::any_cast<std::map<std::string, std::any>>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::Map));
+            put_map(*v, depth + 1);
+        } else if (auto v = std::any_cast<std::vector<std::any>>(&value)) {
+            if (depth + 1 > kMaxNestingDepth) {
+                throw AgentsException("Cannot encode item: values nested too deeply");
+            }
+            put_byte(static_cast<uint8_t>(ValueTag::List));
+            put_varint(v->size());
+            for (const auto& element : *v) {
+                put_value(element, depth + 1);
+            }
+        } else if (auto v = std::any_cast<std::vector<std::string>>(&value)) {
+            put_byte(static_cast<uint8_t>(ValueTag::List));
+            put_varint(v->size());
+            for (const auto& element : *v) {
+                put_byte(static_cast<uint8_t>(ValueTag::String));
+                put_string(element);
+            }
+        } else {
+            throw AgentsException(std::string("Cannot encode item: unsupported value type ") + value.type().name());
+        }
+    }
+
+private:
+    void put_integer(int64_t value) {
+        put_byte(static_cast<uint8_t>(ValueTag::Integer));
+        put_signed(value);
+    }
+};
+
+class RecordReader {
+private:
+    const char* data_;
+    size_t size_;
+    size_t pos_ = 0;
+    int depth_ = 0;
+
+public:
+    RecordReader(const char* data, size_t size) : data_(data), size_(size) {}
+
+    uint8_t get_byte() {
+        require(1);
+        return static_cast<uint8_t>(data_[pos_++]);
+    }
+
+    uint64_t get_varint() {
+        uint64_t value = 0;
+        for (int shift = 0; shift < 64; shift += 7) {
+            uint8_t byte = get_byte();
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+            if (!(byte & 0x80)) {
+                return value;
+            }
+        }
+        throw AgentsException("Corrupt item record: varint too long");
+    }
+
+    int64_t get_signed() {
+        uint64_t raw = get_varint();
+        return static_cast<int64_t>(raw >> 1) ^ -static_cast<int64_t>(raw & 1);
+    }
+
+    std::string get_string() {
+        uint64_t length = get_varint();
+        require(length);
+        std::string value(data_ + pos_, static_cast<size_t>(length));
+        pos_ += static_cast<size_t>(length);
+        return value;
+    }
+
+    std::optional<std::string> get_optional() {
+        if (get_byte() == 0) {
+            return std::nullopt;
+        }
+        return get_string();
+    }
+
+    double get_double() {
+        require(sizeof(double));
+        double value;
+        std::memcpy(&value, data_ + pos_, sizeof(double));
+        pos_ += sizeof(double);
+        return value;
+    }
+
+    std::map<std::string, std::any> get_map() {
+        enter();
+        std::map<std::string, std::any> map;
+        uint64_t count = get_varint();
+        for (uint64_t i = 0; i < count; i++) {
+            std::string key = get_string();
+            map.emplace(std::move(key), get_value());
+        }
+        depth_--;
+        return map;
+    }
+
+    std::any get_value() {
+        switch (static_cast<ValueTag>(get_byte())) {
+        case ValueTag::Null:
+            return std::any();
+        case ValueTag::False:
+            return false;
+        case ValueTag::True:
+            return true;
+        case ValueTag::Integer: {
+            int64_t value = get_signed();
+            // Small values come back as int, which is what callers usually store
+            if (value >= std::numeric_limits<int>::min() && value <= std::numeric_limits<int>::max()) {
+                return static_cast<int>(value);
+            }
+            return value;
+        }
+        case ValueTag::Double:
+            return get_double();
+        case ValueTag::String:
+            return get_string();
+        case ValueTag::Map:
+            return get_map();
+        case ValueTag::List: {
+            enter();
+            std::vector<std::any> list;
+            uint64_t count = get_varint();
+            for (uint64_t i = 0; i < count; i++) {
+                list.push_back(get_value());
+            }
+            depth_--;
+            return list;
+        }
+        }
+        throw AgentsException("Corrupt item record: unknown value tag");
+    }
+
+private:
+    // The top-level metadata map is depth 1
+    void enter() {
+        if (++depth_ > kMaxNestingDepth + 1) {
+            throw AgentsException("Corrupt item record: values nested too deeply");
+        }
+    }
+
+    void require(uint64_t bytes) const {
+        if (bytes > size_ - pos_) {
+            throw AgentsException("Corrupt item record: unexpected end of data");
+        }
+    }
+};
+
+std::any any_from_json(const nlohmann::json& value, int depth = 0) {
+    if (depth > kMaxNestingDepth) {
+        throw AgentsException("Item JSON nested too deeply");
+    }
+    if (value.is_boolean()) {
+        return value.get<bool>();
+    }
+    if (value.is_number_integer()) {
+        int64_t number = value.get<int64_t>();
+        if (number >= std::numeric_limits<int>::min() && number <= std::numeric_limits<int>::max()) {
+            return static_cast<int>(number);
+        }
+        return number;
+    }
+    if (value.is_number()) {
+        return value.get<double>();
+    }
+    if (value.is_string()) {
+        return value.get<std::string>();
+    }
+    if (value.is_object()) {
+        std::map<std::string, std::any> map;
+        for (auto it = value.begin(); it != value.end(); ++it) {
+            map[it.key()] = any_from_json(it.value(), depth + 1);
+        }
+        return map;
+    }
+    if (value.is_array()) {
+        std::vector<std::any> list;
+        for (const auto& element : value) {
+            list.push_back(any_from_json(element, depth + 1));
+        }
+        return list;
+    }
+    return std::any();
+}
+
+std::string json_string(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    return it != object.end() && it->is_string() ? it->get<std::string>() : std::string();
+}
+
+std::optional<std::string> json_optional(const nlohmann::json& object, const char* key) {
+    auto it = object.find(key);
+    if (it == object.end() || !it->is_string()) {
+        return std::nullopt;
+    }
+    return it->get<std::string>();
+}
+
+} // namespace
+
+std::string ItemCodec::encode(const Item& item) {
+    std::string out;
+    encode_to(item, out);
+    return out;
+}
+
+void ItemCodec::encode_to(const Item& item, std::string& out) {
+    RecordWriter writer(out);
+    writer.put_byte(kFormatVersion);
+    writer.put_byte(static_cast<uint8_t>(item.get_type()));
+
+    switch (item.get_type()) {
+    case ItemType::Message: {
+        const auto& message = static_cast<const MessageItem&>(item);
+        writer.put_string(message.get_role());
+        writer.put_string(message.get_content());
+        writer.put_optional(message.get_name());
+        writer.put_map(message.get_metadata());
+        break;
+    }
+    case ItemType::Tool: {
+        // The bound Tool object is runtime state and is not persisted
+        const auto& call = static_cast<const ToolCallItem&>(item);
+        writer.put_string(call.get_tool_call_id());
+        writer.put_string(call.get_function_name());
+        writer.put_string(call.get_arguments());
+        break;
+    }
+    case ItemType::Response: {
+        const auto& response = static_cast<const ToolResponseItem&>(item);
+        writer.put_string(response.get_tool_call_id());
+        writer.put_string(response.get_content());
+        writer.put_byte(response.is_error() ? 1 : 0);
+        break;
+    }
+    case ItemType::Image: {
+        const auto& image = static_cast<const ImageItem&>(item);
+        writer.put_string(image.get_url());
+        writer.put_optional(image.get_detail());
+        writer.put_optional(image.get_mime_type());
+        break;
+    }
+    case ItemType::File: {
+        const auto& file = static_cast<const FileItem&>(item);
+        writer.put_string(file.get_path());
+        writer.put_string(file.get_filename());
+        writer.put_optional(file.get_mime_type());
+        writer.put_byte(file.get_size() ? 1 : 0);
+        if (file.get_size()) {
+            writer.put_varint(*file.get_size());
+        }
+        break;
+    }
+    case ItemType::Custom: {
+        const auto& custom = static_cast<const CustomItem&>(item);
+        writer.put_string(custom.get_type_name());
+        writer.put_map(custom.get_data());
+        break;
+    }
+    }
+}
+
+std::shared_ptr<Item> ItemCodec::decode(const char* data, size_t size) {
+    RecordReader reader(data, size);
+
+    uint8_t version = reader.get_byte();
+    if (version != kFormatVersion) {
+        throw AgentsException("Unsupported item record version: " + std::to_string(version));
+    }
+
+    switch (static_cast<ItemType>(reader.get_byte())) {
+    case ItemType::Message: {
+        std::string role = reader.get_string();
+        std::string content = reader.get_string();
+        auto name = reader.get_optional();
+        auto metadata = reader.get_map();
+        return std::make_shared<MessageItem>(role, content, name, metadata);
+    }
+    case ItemType::Tool: {
+        std::string tool_call_id = reader.get_string();
+        std::string function_name = reader.get_string();
+        std::string arguments = reader.get_string();
+        return std::make_shared<ToolCallItem>(tool_call_id, function_name, arguments);
+    }
+    case ItemType::Response: {
+        std::string tool_call_id = reader.get_string();
+        std::string content = reader.get_string();
+        bool is_error = reader.get_byte() != 0;
+        return std::make_shared<ToolResponseItem>(tool_call_id, content, is_error);
+    }
+    case ItemType::Image: {
+        std::string url = reader.get_string();
+        auto detail = reader.get_optional();
+        auto mime_type = reader.get_optional();
+        return std::make_shared<ImageItem>(url, detail, mime_type);
+    }
+    case ItemType::File: {
+        std::string path = reader.get_string();
+        std::string filename = reader.get_string();
+        auto mime_type = reader.get_optional();
+        std::optional<size_t> file_size;
+        if (reader.get_byte() != 0) {
+            file_size = static_cast<size_t>(reader.get_varint());
+        }
+        return std::make_shared<FileItem>(path, filename, mime_type, file_size);
+    }
+    case ItemType::Custom: {
+        std::string type_name = reader.get_string();
+        auto custom_data = reader.get_map();
+        return std::make_shared<CustomItem>(type_name, custom_data);
+    }
+    }
+
+    throw AgentsException("Corrupt item record: unknown item type");
+}
+
+std::shared_ptr<Item> ItemCodec::decode_json(const std::string& json_text) {
+    auto object = nlohmann::json::parse(json_text);
+    if (!object.is_object()) {
+        throw AgentsException("Item JSON must be an object");
+    }
+
+    std::string type = json_string(object, "type");
+
+    if (type == "message") {
+        std::map<std::string, std::any> metadata;
+        auto it = object.find("metadata");
+        if (it != object.end() && it->is_object()) {
+            metadata = std::any_cast<std::map<std::string, std::any>>(any_from_json(*it));
+        }
+        return std::make_shared<MessageItem>(
+            json_string(object, "role"), json_string(object, "content"),
+            json_optional(object, "name"), metadata
+        );
+    }
+    if (type == "tool_call") {
+        return std::make_shared<ToolCallItem>(
+            json_string(object, "tool_call_id"), json_string(object, "function_name"),
+            json_string(object, "arguments")
+        );
+    }
+    if (type == "tool_response") {
+        auto it = object.find("is_error");
+        bool is_error = it != object.end() && it->is_boolean() && it->get<bool>();
+        return std::make_shared<ToolResponseItem>(
+            json_string(object, "tool_call_id"), json_string(object, "content"), is_error
+        );
+    }
+    if (type == "image") {
+        return std::make_shared<ImageItem>(
+            json_string(object, "url"), json_optional(object, "detail"),
+            json_optional(object, "mime_type")
+        );
+    }
+    if (type == "file") {
+        std::optional<size_t> file_size;
+        auto it = object.find("size");
+        if (it != object.end() && it->is_number_unsigned()) {
+            file_size = it->get<size_t>();
+        }
+        return std::make_shared<FileItem>(
+            json_string(object, "path"), json_string(object, "filename"),
+            json_optional(object, "mime_type"), file_size
+        );
+    }
+
+    // CustomItem::to_dict() flattens its data next to the type name
+    std::map<std::string, std::any> custom_data;
+    for (auto it = object.begin(); it != object.end(); ++it) {
+        if (it.key() != "type") {
+            custom_data[it.key()] = any_from_json(it.value());
+        }
+    }
+    return std::make_shared<CustomItem>(type, custom_data);
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
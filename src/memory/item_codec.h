@@ -0,0 +1,40 @@
+#pragma once
+
+/**
+ * Compact binary encoding of conversation items for session storage
+ *
+ * Records start with a format version byte and the item type tag, followed
+ * by the item's fields as varint-length-prefixed strings. Metadata and
+ * custom item data are encoded as tagged values (null, bool, integer,
+ * double, string, map, list), nested at most 64 levels deep. Encoding a
+ * value of any other type throws.
+ */
+
+#include "../items.h"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace openai_agents {
+namespace memory {
+
+class ItemCodec {
+public:
+    // Written as the first byte of every record
+    static constexpr uint8_t kFormatVersion = 1;
+
+    // Binary encoding
+    static std::string encode(const Item& item);
+    static void encode_to(const Item& item, std::string& out);
+
+    static std::shared_ptr<Item> decode(const char* data, size_t size);
+    static std::shared_ptr<Item> decode(const std::string& data) {
+        return decode(data.data(), data.size());
+    }
+
+    // JSON produced by Item::to_dict(), as stored by older session rows
+    static std::shared_ptr<Item> decode_json(const std::string& json_text);
+};
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,340 @@
+#include "log_session.h"
+#include "item_codec.h"
+#include "../exceptions.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace openai_agents {
+namespace memory {
+
+namespace {
+
+constexpr char kLogMagic[8] = {'O', 'A', 'L', 'O', 'G', 0, 0, 1};
+constexpr uint64_t kHeaderSize = sizeof(kLogMagic);
+constexpr uint64_t kRecordHeaderSize = 8;
+
+// Mappings grow geometrically so appends rarely remap
+constexpr size_t kMinMapSize = 1 << 20;
+
+uint32_t read_u32(const char* data) {
+    const auto* bytes = reinterpret_cast<const unsigned char*>(data);
+    return static_cast<uint32_t>(bytes[0]) |
+           static_cast<uint32_t>(bytes[1]) << 8 |
+           static_cast<uint32_t>(bytes[2]) << 16 |
+           static_cast<uint32_t>(bytes[3]) << 24;
+}
+
+void put_u32(std::string& out, uint32_t value) {
+    for (int shift = 0; shift < 32; shift += 8) {
+        out.push_back(static_cast<char>((value >> shift) & 0xff));
+    }
+}
+
+// FNV-1a; enough to tell a torn append from a complete record
+uint32_t checksum(const char* data, size_t size) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+AgentsException log_error(const std::string& what, const std::string& path) {
+    return AgentsException(what + " " + path + ": " + std::strerror(errno));
+}
+
+} // namespace
+
+// LogSession implementation
+LogSession::LogSession(const std::string& session_id, const std::string& log_dir, bool sync_writes)
+    : SessionBase(session_id), path_(path_for(log_dir, session_id)), sync_writes_(sync_writes) {
+    open_log(log_dir);
+}
+
+LogSession::~LogSession() {
+    if (map_) {
+        munmap(const_cast<char*>(map_), map_size_);
+    }
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+std::string LogSession::path_for(const std::string& log_dir, const std::string& session_id) {
+    static const char* hex = "0123456789abcdef";
+
+    std::string name;
+    name.reserve(session_id.size());
+    for (unsigned char c : session_id) {
+        if (std::isalnum(c) || c == '-' || c == '_') {
+            name.push_back(static_cast<char>(c));
+        } else {
+            name.push_back('%');
+            name.push_back(hex[c >> 4]);
+            name.push_back(hex[c & 0xf]);
+        }
+    }
+    return log_dir + "/" + name + ".log";
+}
+
+void LogSession::open_log(const std::string& log_dir) {
+    if (mkdir(log_dir.c_str(), 0755) != 0 && errno != EEXIST) {
+        throw log_error("Failed to create log directory", log_dir);
+    }
+
+    fd_ = open(path_.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd_ < 0) {
+        throw log_error("Failed to open session log", path_);
+    }
+
+    try {
+        if (flock(fd_, LOCK_EX | LOCK_NB) != 0) {
+            throw log_error("Session log is already open by another writer", path_);
+        }
+        recover();
+    } catch (...) {
+        if (map_) {
+            munmap(const_cast<char*>(map_), map_size_);
+            map_ = nullptr;
+        }
+        close(fd_);
+        fd_ = -1;
+        throw;
+    }
+}
+
+void LogSession::recover() {
+    struct stat st;
+    if (fstat(fd_, &st) != 0) {
+        throw log_error("Failed to stat session log", path_);
+    }
+    file_size_ = static_cast<uint64_t>(st.st_size);
+
+    if (file_size_ < kHeaderSize) {
+        // New file, or a crash before the header was complete
+        if (ftruncate(fd_, 0) != 0 ||
+            pwrite(fd_, kLogMagic, kHeaderSize, 0) != static_cast<ssize_t>(kHeaderSize)) {
+            throw log_error("Failed to initialize session log", path_);
+        }
+        file_size_ = kHeaderSize;
+    }
+
+    ensure_mapped(file_size_);
+    if (std::memcmp(map_, kLogMagic, kHeaderSize) != 0) {
+        throw AgentsException("Not a session log: " + path_);
+    }
+
+    // Rebuild the offset index, stopping at the first incomplete record
+    uint64_t offset = kHeaderSize;
+    while (file_size_ - offset >= kRecordHeaderSize) {
+        uint32_t length = read_u32(map_ + offset);
+        uint32_t sum = read_u32(map_ + offset + 4);
+        if (file_size_ - offset - kRecordHeaderSize < length ||
+            checksum(map_ + offset + kRecordHeaderSize, length) != sum) {
+            break;
+        }
+        offsets_.push_back(offset);
+        offset += kRecordHeaderSize + length;
+    }
+
+    if (offset < file_size_) {
+        truncate_to(offset);
+    }
+}
+
+void LogSession::ensure_mapped(uint64_t size) {
+    if (size <= map_size_) {
+        return;
+    }
+
+    // The mapping may extend past the end of the file; only bytes below
+    // file_size_ are ever read
+    size_t page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    size_t new_size = std::max<size_t>(std::max<uint64_t>(size, map_size_ * 2), kMinMapSize);
+    new_size = (new_size + page_size - 1) / page_size * page_size;
+
+    void* mapped = mmap(nullptr, new_size, PROT_READ, MAP_SHARED, fd_, 0);
+    if (mapped == MAP_FAILED) {
+        throw log_error("Failed to map session log", path_);
+    }
+    if (map_) {
+        munmap(const_cast<char*>(map_), map_size_);
+    }
+    map_ = static_cast<const char*>(mapped);
+    map_size_ = new_size;
+}
+
+void LogSession::truncate_to(uint64_t size) {
+    if (ftruncate(fd_, static_cast<off_t>(size)) != 0) {
+        throw log_error("Failed to truncate session log", path_);
+    }
+    file_size_ = size;
+    if (sync_writes_ && fdatasync(fd_) != 0) {
+        throw log_error("Failed to sync session log", path_);
+    }
+}
+
+std::shared_ptr<Item> LogSession::decode_record(uint64_t offset) const {
+    // Decoded straight from the mapping, without copying the record
+    uint32_t length = read_u32(map_ + offset);
+    return ItemCodec::decode(map_ + offset + kRecordHeaderSize, length);
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> LogSession::get_items(std::optional<size_t> limit) {
+    return submit([this, limit]() {
+        return get_items_internal(limit);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> LogSession::get_items_internal(std::optional<size_t> limit) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+
+    size_t count = limit ? std::min(*limit, offsets_.size()) : offsets_.size();
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(count);
+    for (size_t i = offsets_.size() - count; i < offsets_.size(); i++) {
+        items.push_back(decode_record(offsets_[i]));
+    }
+    return items;
+}
+
+std::future<void> LogSession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    return submit([this, items]() {
+        add_items_internal(items);
+    });
+}
+
+void LogSession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
+    if (items.empty()) return;
+
+    // Encode the whole batch outside the lock so it is appended with one
+    // sequential write
+    std::string buffer;
+    std::vector<uint64_t> record_offsets;
+    record_offsets.reserve(items.size());
+    std::string payload;
+    for (const auto& item : items) {
+        payload.clear();
+        ItemCodec::encode_to(*item, payload);
+
+        record_offsets.push_back(buffer.size());
+        put_u32(buffer, static_cast<uint32_t>(payload.size()));
+        put_u32(buffer, checksum(payload.data(), payload.size()));
+        buffer.append(payload);
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    uint64_t offset = file_size_;
+    size_t written = 0;
+    while (written < buffer.size()) {
+        ssize_t n = pwrite(fd_, buffer.data() + written, buffer.size() - written,
+                           static_cast<off_t>(offset + written));
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            auto error = log_error("Failed to append to session log", path_);
+            // Drop any partial batch so the file matches the index; if that
+            // fails too, recovery drops the torn record on reopen
+            int truncated = ftruncate(fd_, static_cast<off_t>(offset));
+            (void)truncated;
+            throw error;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    file_size_ = offset + buffer.size();
+    for (uint64_t record_offset : record_offsets) {
+        offsets_.push_back(offset + record_offset);
+    }
+    update_timestamp();
+    ensure_mapped(file_size_);
+
+    if (sync_writes_ && fdatasync(fd_) != 0) {
+        throw log_error("Failed to sync session log", path_);
+    }
+}
+
+std::future<std::shared_ptr<Item>> LogSession::pop_item() {
+    return submit([this]() {
+        return pop_item_internal();
+    });
+}
+
+std::shared_ptr<Item> LogSession::pop_item_internal() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    if (offsets_.empty()) {
+        return nullptr;
+    }
+
+    uint64_t offset = offsets_.back();
+    auto item = decode_record(offset);
+    truncate_to(offset);
+    offsets_.pop_back();
+    update_timestamp();
+    return item;
+}
+
+std::future<void> LogSession::clear_session() {
+    return submit([this]() {
+        clear_session_internal();
+    });
+}
+
+void LogSession::clear_session_internal() {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    truncate_to(kHeaderSize);
+    offsets_.clear();
+    update_timestamp();
+}
+
+std::future<ItemPage> LogSession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return submit([this, after_id, batch_size]() {
+        return scan_internal(after_id, batch_size, false);
+    });
+}
+
+std::future<ItemPage> LogSession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return submit([this, before_id, batch_size]() {
+        return scan_internal(before_id, batch_size, true);
+    });
+}
+
+ItemPage LogSession::scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse) {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return page_by_position(1, offsets_.size(), cursor, batch_size, reverse,
+                            [this](size_t i) { return decode_record(offsets_[i]); });
+}
+
+size_t LogSession::get_item_count() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return offsets_.size();
+}
+
+SessionSummary LogSession::get_summary() const {
+    SessionSummary summary;
+    summary.session_id = session_id_;
+    
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    summary.item_count = offsets_.size();
+    summary.total_bytes = file_size_ - kHeaderSize - kRecordHeaderSize * offsets_.size();
+    if (!offsets_.empty()) {
+        summary.first_item_at = created_at_;
+        summary.last_item_at = updated_at_;
+    }
+    return summary;
+}
+
+uint64_t LogSession::get_file_size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return file_size_;
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
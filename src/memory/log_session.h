@@ -0,0 +1,97 @@
+#pragma once
+
+/**
+ * Append-only log session backend
+ *
+ * Each session is stored in its own file: an 8-byte header followed by
+ * records of [u32 length][u32 checksum][ItemCodec payload], little-endian.
+ * Records are appended with sequential writes and read in place through a
+ * read-only mapping of the file. An in-memory index of record offsets lets
+ * reads jump straight to the last N records, and popping an item truncates
+ * the file. A torn record at the tail, left by a crash mid-append, is
+ * dropped when the file is reopened.
+ *
+ * A log file has a single writer: opening a session whose file is already
+ * open elsewhere throws.
+ */
+
+#include "session.h"
+#include <cstdint>
+
+namespace openai_agents {
+namespace memory {
+
+class LogSession : public SessionBase {
+private:
+    std::string path_;
+    bool sync_writes_;
+    int fd_ = -1;
+    
+    const char* map_ = nullptr;
+    size_t map_size_ = 0;
+    uint64_t file_size_ = 0;
+    std::vector<uint64_t> offsets_;  // start of each record, oldest first
+    
+    // Shared for reads; exclusive for appends, truncation and remapping
+    mutable std::shared_mutex mutex_;
+
+public:
+    LogSession(
+        const std::string& session_id,
+        const std::string& log_dir = ".",
+        bool sync_writes = false
+    );
+    ~LogSession();
+    
+    LogSession(const LogSession&) = delete;
+    LogSession& operator=(const LogSession&) = delete;
+    
+    // Session interface implementation
+    std::future<std::vector<std::shared_ptr<Item>>> get_items(
+        std::optional<size_t> limit = std::nullopt
+    ) override;
+    
+    std::future<void> add_items(
+        const std::vector<std::shared_ptr<Item>>& items
+    ) override;
+    
+    std::future<std::shared_ptr<Item>> pop_item() override;
+    std::future<void> clear_session() override;
+    
+    size_t get_item_count() const override;
+    SessionSummary get_summary() const override;
+    
+    // Cursors are 1-based record positions
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    // Log-specific methods
+    const std::string& get_path() const { return path_; }
+    uint64_t get_file_size() const;
+    
+    // File used for a session; ids are escaped so any id is a valid name
+    static std::string path_for(const std::string& log_dir, const std::string& session_id);
+
+private:
+    std::vector<std::shared_ptr<Item>> get_items_internal(std::optional<size_t> limit);
+    void add_items_internal(const std::vector<std::shared_ptr<Item>>& items);
+    std::shared_ptr<Item> pop_item_internal();
+    void clear_session_internal();
+    ItemPage scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse);
+    
+    void open_log(const std::string& log_dir);
+    void recover();
+    void ensure_mapped(uint64_t size);
+    void truncate_to(uint64_t size);
+    std::shared_ptr<Item> decode_record(uint64_t offset) const;
+};
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -1,22 +1,54 @@
 #include "session.h"
+#include "item_codec.h"
+#include "log_session.h"
+#include "timer_wheel.h"
 #include "../exceptions.h"
 #include "../logger.h"
-#include "../util/_json.h"
 #include <thread>
+#include <condition_variable>
+#include <atomic>
 #include <chrono>
 #include <sstream>
 #include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+#include <set>
+#include <tuple>
+#include <string_view>
+#include <variant>
+#include <limits>
 #include <sqlite3.h>
 
 namespace openai_agents {
 namespace memory {
 
+// Binary parameter, bound without copying
+struct SQLiteBlob {
+    std::string_view bytes;
+};
+
+// Bound parameter for prepared statements
+using SQLiteParam = std::variant<std::string, int64_t, SQLiteBlob>;
+
 // SQLite connection wrapper
 class SQLiteConnection {
 private:
     sqlite3* db_;
     std::string db_path_;
     std::mutex mutex_;
+    
+    // Prepared statements keyed by SQL text; reused via reset/rebind
+    std::unordered_map<std::string, sqlite3_stmt*> statement_cache_;
+    static constexpr size_t kMaxCachedStatements = 64;
+    
+    // Resets a cached statement once the caller is done stepping it
+    struct StatementReset {
+        sqlite3_stmt* stmt;
+        ~StatementReset() {
+            sqlite3_reset(stmt);
+            sqlite3_clear_bindings(stmt);
+        }
+    };
 
 public:
     SQLiteConnection(const std::string& db_path) : db_(nullptr), db_path_(db_path) {
@@ -27,6 +59,9 @@ public:
             throw AgentsException("Failed to open SQLite database: " + error);
         }
         
+        // Wait for competing writers instead of failing with SQLITE_BUSY
+        sqlite3_busy_timeout(db_, 5000);
+        
         // Set WAL mode for better concurrency
         execute("PRAGMA journal_mode=WAL");
         execute("PRAGMA synchronous=NORMAL");
@@ -35,6 +70,7 @@ public:
     }
     
     ~SQLiteConnection() {
+        clear_statement_cache();
         if (db_) {
             sqlite3_close(db_);
         }
@@ -51,78 +87,162 @@ public:
         }
     }
     
-    std::vector<std::vector<std::string>> query(const std::string& sql) {
+    std::vector<std::vector<std::string>> query(
+        const std::string& sql,
+        const std::vector<SQLiteParam>& params = {}
+    ) {
+        std::vector<std::vector<std::string>> results;
+        query_each(sql, params, [&results](const std::vector<std::string>& row) {
+            results.push_back(row);
+            return true;
+        });
+        return results;
+    }
+    
+    // Streams rows to on_row, reusing one row buffer; on_row returns false to stop
+    bool query_each(
+        const std::string& sql,
+        const std::vector<SQLiteParam>& params,
+        const std::function<bool(const std::vector<std::string>&)>& on_row
+    ) {
         std::lock_guard<std::mutex> lock(mutex_);
-        sqlite3_stmt* stmt;
-        int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
-        if (rc != SQLITE_OK) {
-            throw AgentsException("Failed to prepare statement: " + std::string(sqlite3_errmsg(db_)));
-        }
+        sqlite3_stmt* stmt = prepare_cached(sql);
+        StatementReset reset{stmt};
+        bind_params(stmt, params);
         
-        std::vector<std::vector<std::string>> results;
+        int rc;
+        int column_count = sqlite3_column_count(stmt);
+        std::vector<std::string> row(column_count);
         while ((rc = sqlite3_step(stmt)) == SQLITE_ROW) {
-            std::vector<std::string> row;
-            int column_count = sqlite3_column_count(stmt);
             for (int i = 0; i < column_count; i++) {
-                const char* text = reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
-                row.push_back(text ? text : "");
+                // BLOB columns are returned as raw bytes
+                const char* data = sqlite3_column_type(stmt, i) == SQLITE_BLOB
+                    ? static_cast<const char*>(sqlite3_column_blob(stmt, i))
+                    : reinterpret_cast<const char*>(sqlite3_column_text(stmt, i));
+                int size = sqlite3_column_bytes(stmt, i);
+                if (data) {
+                    row[i].assign(data, size);
+                } else {
+                    row[i].clear();
+                }
+            }
+            if (!on_row(row)) {
+                return false;
             }
-            results.push_back(row);
         }
         
-        sqlite3_finalize(stmt);
-        
         if (rc != SQLITE_DONE) {
             throw AgentsException("Query execution error: " + std::string(sqlite3_errmsg(db_)));
         }
         
-        return results;
+        return true;
     }
     
-    void execute_with_params(const std::string& sql, const std::vector<std::string>& params) {
+    void execute_with_params(const std::string& sql, const std::vector<SQLiteParam>& params) {
         std::lock_guard<std::mutex> lock(mutex_);
-        sqlite3_stmt* stmt;
-        int rc = sqlite3_prepare_v2(db_, sql.c_str(), -1, &stmt, nullptr);
-        if (rc != SQLITE_OK) {
-            throw AgentsException("Failed to prepare statement: " + std::string(sqlite3_errmsg(db_)));
-        }
-        
-        for (size_t i = 0; i < params.size(); i++) {
-            sqlite3_bind_text(stmt, static_cast<int>(i + 1), params[i].c_str(), -1, SQLITE_STATIC);
-        }
-        
-        rc = sqlite3_step(stmt);
-        sqlite3_finalize(stmt);
+        sqlite3_stmt* stmt = prepare_cached(sql);
+        StatementReset reset{stmt};
+        bind_params(stmt, params);
         
+        int rc = sqlite3_step(stmt);
         if (rc != SQLITE_DONE) {
             throw AgentsException("Statement execution error: " + std::string(sqlite3_errmsg(db_)));
         }
     }
     
     void begin_transaction() {
-        execute("BEGIN TRANSACTION");
+        execute_with_params("BEGIN TRANSACTION", {});
     }
     
     void commit() {
-        execute("COMMIT");
+        execute_with_params("COMMIT", {});
     }
     
     void rollback() {
-        execute("ROLLBACK");
+        execute_with_params("ROLLBACK", {});
+    }
+    
+    // Compile a statement into the cache ahead of its first use
+    void prepare(const std::string& sql) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        prepare_cached(sql);
+    }
+    
+    // Statement cache management
+    void clear_statement_cache() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        clear_statement_cache_locked();
+    }
+    
+    size_t cached_statement_count() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return statement_cache_.size();
+    }
+    
+    // Row id of the last row inserted; a multi-row INSERT numbers its rows
+    // consecutively up to this one
+    int64_t last_insert_rowid() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return sqlite3_last_insert_rowid(db_);
     }
     
     sqlite3* get_db() const { return db_; }
     const std::string& get_path() const { return db_path_; }
-};
 
-// Thread-local storage for SQLite connections
-thread_local std::shared_ptr<SQLiteConnection> SQLiteSession::thread_connection_ = nullptr;
+private:
+    sqlite3_stmt* prepare_cached(const std::string& sql) {
+        auto it = statement_cache_.find(sql);
+        if (it != statement_cache_.end()) {
+            return it->second;
+        }
+        
+        if (statement_cache_.size() >= kMaxCachedStatements) {
+            clear_statement_cache_locked();
+        }
+        
+        sqlite3_stmt* stmt = nullptr;
+        int rc = sqlite3_prepare_v3(db_, sql.c_str(), -1, SQLITE_PREPARE_PERSISTENT, &stmt, nullptr);
+        if (rc != SQLITE_OK) {
+            throw AgentsException("Failed to prepare statement: " + std::string(sqlite3_errmsg(db_)));
+        }
+        
+        statement_cache_.emplace(sql, stmt);
+        return stmt;
+    }
+    
+    void bind_params(sqlite3_stmt* stmt, const std::vector<SQLiteParam>& params) {
+        // Parameters outlive the step, and StatementReset clears the bindings
+        // before returning, so text can be bound without a copy
+        for (size_t i = 0; i < params.size(); i++) {
+            int index = static_cast<int>(i + 1);
+            if (const auto* text = std::get_if<std::string>(&params[i])) {
+                sqlite3_bind_text(stmt, index, text->c_str(), static_cast<int>(text->size()), SQLITE_STATIC);
+            } else if (const auto* blob = std::get_if<SQLiteBlob>(&params[i])) {
+                sqlite3_bind_blob(stmt, index, blob->bytes.data(), static_cast<int>(blob->bytes.size()), SQLITE_STATIC);
+            } else {
+                sqlite3_bind_int64(stmt, index, std::get<int64_t>(params[i]));
+            }
+        }
+    }
+    
+    void clear_statement_cache_locked() {
+        for (auto& [sql, stmt] : statement_cache_) {
+            sqlite3_finalize(stmt);
+        }
+        statement_cache_.clear();
+    }
+};
 
 // SessionBase implementation
-SessionBase::SessionBase(const std::string& session_id)
+SessionBase::SessionBase(const std::string& session_id, std::shared_ptr<SessionExecutor> executor)
     : session_id_(session_id),
       created_at_(std::chrono::system_clock::now()),
-      updated_at_(std::chrono::system_clock::now()) {
+      updated_at_(std::chrono::system_clock::now()),
+      executor_(executor ? std::move(executor) : get_default_session_executor()) {
+}
+
+void SessionBase::set_executor(std::shared_ptr<SessionExecutor> executor) {
+    executor_ = executor ? std::move(executor) : get_default_session_executor();
 }
 
 void SessionBase::set_metadata(const std::string& key, const std::any& value) {
@@ -138,6 +258,82 @@ void SessionBase::update_timestamp() {
     updated_at_ = std::chrono::system_clock::now();
 }
 
+void SessionBase::reset_identity(const std::string& session_id) {
+    session_id_ = session_id;
+    metadata_.clear();
+    created_at_ = std::chrono::system_clock::now();
+    updated_at_ = created_at_;
+}
+
+// Token counting
+size_t estimate_item_tokens(const Item& item) {
+    // Counts text fields only; images are billed separately by the model
+    size_t bytes = 0;
+    switch (item.get_type()) {
+    case ItemType::Message:
+        {
+            const auto& message = static_cast<const MessageItem&>(item);
+            bytes = message.get_role().size() + message.get_content().size() +
+                    (message.get_name() ? message.get_name()->size() : 0);
+            break;
+        }
+    case ItemType::Tool:
+        {
+            const auto& call = static_cast<const ToolCallItem&>(item);
+            bytes = call.get_function_name().size() + call.get_arguments().size();
+            break;
+        }
+    case ItemType::Response:
+        bytes = static_cast<const ToolResponseItem&>(item).get_content().size();
+        break;
+    case ItemType::Image:
+        bytes = static_cast<const ImageItem&>(item).get_url().size();
+        break;
+    case ItemType::File:
+        bytes = static_cast<const FileItem&>(item).get_filename().size();
+        break;
+    default:
+        bytes = item.to_string().size();
+        break;
+    }
+    return (bytes + 3) / 4 + 4;
+}
+
+static std::shared_ptr<const TokenCounter> token_counter;
+
+void set_token_counter(TokenCounter counter) {
+    std::shared_ptr<const TokenCounter> next;
+    if (counter) {
+        next = std::make_shared<const TokenCounter>(std::move(counter));
+    }
+    std::atomic_store(&token_counter, next);
+}
+
+size_t count_item_tokens(const Item& item) {
+    auto counter = std::atomic_load(&token_counter);
+    return counter ? (*counter)(item) : estimate_item_tokens(item);
+}
+
+std::string item_text(const Item& item) {
+    switch (item.get_type()) {
+    case ItemType::Message:
+        return static_cast<const MessageItem&>(item).get_content();
+    case ItemType::Tool:
+        {
+            const auto& call = static_cast<const ToolCallItem&>(item);
+            return call.get_function_name() + " " + call.get_arguments();
+        }
+    case ItemType::Response:
+        return static_cast<const ToolResponseItem&>(item).get_content();
+    case ItemType::Image:
+        return "";
+    case ItemType::File:
+        return static_cast<const FileItem&>(item).get_filename();
+    default:
+        return item.to_string();
+    }
+}
+
 // Session convenience methods
 std::vector<std::shared_ptr<Item>> Session::get_items_sync(std::optional<size_t> limit) {
     auto future = get_items(limit);
@@ -159,17 +355,88 @@ void Session::clear_session_sync() {
     future.wait();
 }
 
+ItemPage Session::scan_sync(std::optional<int64_t> after_id, size_t batch_size) {
+    auto future = scan(after_id, batch_size);
+    return future.get();
+}
+
+ItemPage Session::scan_reverse_sync(std::optional<int64_t> before_id, size_t batch_size) {
+    auto future = scan_reverse(before_id, batch_size);
+    return future.get();
+}
+
+std::vector<std::shared_ptr<Item>> Session::get_items_within_budget_sync(size_t max_tokens) {
+    auto future = get_items_within_budget(max_tokens);
+    return future.get();
+}
+
+std::vector<std::shared_ptr<Item>> Session::get_relevant_items_sync(const std::string& query, size_t limit) {
+    auto future = get_relevant_items(query, limit);
+    return future.get();
+}
+
+SessionSummary Session::get_summary() const {
+    SessionSummary summary;
+    summary.session_id = get_session_id();
+    summary.item_count = get_item_count();
+    if (summary.item_count > 0) {
+        summary.first_item_at = get_created_at();
+        summary.last_item_at = get_updated_at();
+    }
+    return summary;
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> Session::get_relevant_items(const std::string& /*query*/, size_t limit) {
+    return get_items(limit);
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> Session::get_items_within_budget(size_t max_tokens) {
+    return std::async(std::launch::deferred, [this, max_tokens]() {
+        auto items = get_items().get();
+        size_t used = 0;
+        size_t start = items.size();
+        while (start > 0) {
+            size_t tokens = count_item_tokens(*items[start - 1]);
+            if (used + tokens > max_tokens) break;
+            used += tokens;
+            start--;
+        }
+        items.erase(items.begin(), items.begin() + start);
+        return items;
+    });
+}
+
+// Default scans materialize the session; cursors are 1-based positions.
+// Deferred so the read happens on whichever thread waits for the page.
+std::future<ItemPage> Session::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return std::async(std::launch::deferred, [this, after_id, batch_size]() {
+        auto items = get_items().get();
+        return page_by_position(1, items.size(), after_id, batch_size, false,
+                                [&items](size_t i) { return items[i]; });
+    });
+}
+
+std::future<ItemPage> Session::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return std::async(std::launch::deferred, [this, before_id, batch_size]() {
+        auto items = get_items().get();
+        return page_by_position(1, items.size(), before_id, batch_size, true,
+                                [&items](size_t i) { return items[i]; });
+    });
+}
+
 // SQLiteSession implementation
 SQLiteSession::SQLiteSession(
     const std::string& session_id,
     const std::string& db_path,
     const std::string& sessions_table,
-    const std::string& messages_table
+    const std::string& messages_table,
+    const GroupCommitOptions& group_commit
 ) : SessionBase(session_id),
     db_path_(db_path),
     sessions_table_(sessions_table),
     messages_table_(messages_table),
-    is_memory_db_(db_path == ":memory:") {
+    is_memory_db_(db_path == ":memory:"),
+    group_commit_options_(group_commit) {
     
     init_database();
 }
@@ -178,188 +445,931 @@ SQLiteSession::~SQLiteSession() {
     close();
 }
 
-void SQLiteSession::init_database() {
-    if (is_memory_db_) {
-        // For in-memory databases, use a shared connection
-        std::lock_guard<std::mutex> lock(connection_mutex_);
-        shared_connection_ = std::make_shared<SQLiteConnection>(db_path_);
-        init_db_for_connection(shared_connection_);
-    } else {
-        // For file databases, initialize schema once
-        auto init_conn = std::make_shared<SQLiteConnection>(db_path_);
-        init_db_for_connection(init_conn);
+// Connections for one database file: a single writer, checked out
+// exclusively so transactions never interleave, plus a bounded set of
+// reader connections opened on demand. WAL lets readers run while the
+// writer is busy. In-memory databases are private to one connection, so
+// their pools have no readers and serve reads from the writer.
+class SQLiteConnectionPool : public std::enable_shared_from_this<SQLiteConnectionPool> {
+private:
+    std::string db_path_;
+    size_t max_readers_;
+    
+    std::mutex mutex_;
+    std::condition_variable writer_cv_;
+    std::condition_variable reader_cv_;
+    std::unique_ptr<SQLiteConnection> writer_;
+    bool writer_busy_ = false;
+    std::vector<std::unique_ptr<SQLiteConnection>> idle_readers_;
+    size_t open_readers_ = 0;
+    
+    // Table pairs whose schema setup has already run on this file
+    std::set<std::string> ready_schemas_;
+    
+    ConnectionPoolStats stats_;
+
+public:
+    SQLiteConnectionPool(const std::string& db_path, size_t max_readers)
+        : db_path_(db_path),
+          max_readers_(max_readers),
+          writer_(std::make_unique<SQLiteConnection>(db_path)) {
+        stats_.max_readers = max_readers;
+    }
+    
+    std::shared_ptr<SQLiteConnection> acquire_writer() {
+        auto started = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        writer_cv_.wait(lock, [this]() { return !writer_busy_; });
+        writer_busy_ = true;
+        
+        stats_.writer_checkouts++;
+        record_wait(stats_.writer_wait_time, started);
+        
+        auto self = shared_from_this();
+        return std::shared_ptr<SQLiteConnection>(writer_.get(), [self](SQLiteConnection*) {
+            self->release_writer();
+        });
+    }
+    
+    std::shared_ptr<SQLiteConnection> acquire_reader() {
+        if (max_readers_ == 0) {
+            return acquire_writer();
+        }
+        
+        auto started = std::chrono::steady_clock::now();
+        std::unique_lock<std::mutex> lock(mutex_);
+        reader_cv_.wait(lock, [this]() {
+            return !idle_readers_.empty() || open_readers_ < max_readers_;
+        });
+        
+        std::unique_ptr<SQLiteConnection> conn;
+        if (!idle_readers_.empty()) {
+            conn = std::move(idle_readers_.back());
+            idle_readers_.pop_back();
+        } else {
+            // Reserve the slot, then open outside the lock
+            open_readers_++;
+            lock.unlock();
+            try {
+                conn = std::make_unique<SQLiteConnection>(db_path_);
+            } catch (...) {
+                lock.lock();
+                open_readers_--;
+                reader_cv_.notify_one();
+                throw;
+            }
+            lock.lock();
+            stats_.reader_connections = open_readers_;
+        }
+        
+        stats_.reader_checkouts++;
+        record_wait(stats_.reader_wait_time, started);
+        
+        auto self = shared_from_this();
+        return std::shared_ptr<SQLiteConnection>(conn.release(), [self](SQLiteConnection* released) {
+            self->release_reader(released);
+        });
+    }
+    
+    ConnectionPoolStats get_stats() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+    
+    size_t get_max_readers() const { return max_readers_; }
+    
+    bool is_schema_ready(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return ready_schemas_.count(key) > 0;
+    }
+    
+    void mark_schema_ready(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_schemas_.insert(key);
+    }
+    
+    void forget_schema(const std::string& key) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        ready_schemas_.erase(key);
+    }
+    
+    // One pool per database file, shared by every session using it
+    static std::shared_ptr<SQLiteConnectionPool> for_path(const std::string& db_path, size_t max_readers) {
+        if (db_path == ":memory:") {
+            return std::make_shared<SQLiteConnectionPool>(db_path, 0);
+        }
+        
+        static std::mutex registry_mutex;
+        static std::map<std::string, std::weak_ptr<SQLiteConnectionPool>> registry;
+        
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto pool = registry[db_path].lock();
+        if (!pool) {
+            pool = std::make_shared<SQLiteConnectionPool>(db_path, max_readers);
+            registry[db_path] = pool;
+        }
+        return pool;
     }
-}
 
-void SQLiteSession::init_db_for_connection(std::shared_ptr<SQLiteConnection> conn) {
+private:
+    void release_writer() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            writer_busy_ = false;
+        }
+        writer_cv_.notify_one();
+    }
+    
+    void release_reader(SQLiteConnection* conn) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            idle_readers_.emplace_back(conn);
+        }
+        reader_cv_.notify_one();
+    }
+    
+    void record_wait(std::chrono::nanoseconds& total, std::chrono::steady_clock::time_point started) {
+        auto waited = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - started);
+        total += waited;
+        stats_.max_wait_time = std::max(stats_.max_wait_time, waited);
+    }
+};
+
+// Reader connections per pool for pools created from now on
+static std::atomic<size_t> default_max_readers{4};
+
+// Rows per multi-row INSERT; keeps bound parameters well under SQLITE_MAX_VARIABLE_NUMBER
+static constexpr size_t kMaxInsertBatchRows = 64;
+
+// Rows read per step while indexing existing messages for search
+static constexpr int64_t kSearchBackfillRows = 1000;
+
+// Session summaries buffered per connection checkout in summarize_all
+static constexpr int64_t kSummaryPageRows = 256;
+
+// Prebuilt SQL text for one (sessions_table, messages_table) pair
+struct SQLiteStatements {
+    std::string schema_key;         // connection pool keys for schema setup
+    std::string search_schema_key;  // and for the full-text index
+    std::string create_sessions_table;
+    std::string create_messages_table;
+    std::string create_messages_index;
+    std::string drop_legacy_index;
+    std::string messages_table_info;
+    std::string add_blob_column;
+    std::string sessions_table_info;
+    std::string add_item_count_column;
+    std::string backfill_item_counts;
+    std::string add_token_count_column;
+    std::string add_tokens_before_column;
+    std::string backfill_token_counts;
+    std::string backfill_tokens_before;
+    std::string add_session_token_column;
+    std::string backfill_session_tokens;
+    std::string create_tokens_index;
+    std::string insert_session;
+    std::string insert_item;
+    std::vector<std::string> insert_items; // insert_items[n - 1] inserts n rows
+    std::string select_session_tokens;
+    std::string touch_session;
+    std::string decrement_counts;
+    std::string select_all_items;
+    std::string select_last_items;
+    std::string select_last_item;
+    std::string scan_items;
+    std::string scan_items_reverse;
+    std::string select_items_within_budget;
+    std::string summarize_session;
+    std::string summarize_sessions;
+    std::string summarize_sessions_after;
+    std::string delete_item;
+    std::string delete_session_items;
+    std::string delete_session;
+    std::string count_session_items;
+    std::string count_sessions;
+    std::string count_items;
+    std::string search_table_exists;
+    std::string create_search_table;
+    std::string scan_all_items;
+    std::string insert_search_row;
+    std::string delete_search_row;
+    std::string delete_session_search_rows;
+    std::string search_items;
+    std::string search_session_items;
+};
+
+static std::shared_ptr<const SQLiteStatements> build_sqlite_statements(
+    const std::string& sessions_table,
+    const std::string& messages_table
+) {
+    auto sql = std::make_shared<SQLiteStatements>();
+    sql->schema_key = sessions_table + "/" + messages_table;
+    sql->search_schema_key = sql->schema_key + "/search";
+    
     std::ostringstream sessions_sql;
-    sessions_sql << "CREATE TABLE IF NOT EXISTS " << sessions_table_ << " ("
+    sessions_sql << "CREATE TABLE IF NOT EXISTS " << sessions_table << " ("
                  << "session_id TEXT PRIMARY KEY,"
+                 << "item_count INTEGER NOT NULL DEFAULT 0,"
+                 << "token_total INTEGER NOT NULL DEFAULT 0,"
                  << "created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
                  << "updated_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP"
                  << ")";
+    sql->create_sessions_table = sessions_sql.str();
     
     std::ostringstream messages_sql;
-    messages_sql << "CREATE TABLE IF NOT EXISTS " << messages_table_ << " ("
+    messages_sql << "CREATE TABLE IF NOT EXISTS " << messages_table << " ("
                  << "id INTEGER PRIMARY KEY AUTOINCREMENT,"
                  << "session_id TEXT NOT NULL,"
                  << "message_data TEXT NOT NULL,"
+                 << "message_blob BLOB,"
+                 << "token_count INTEGER NOT NULL DEFAULT 0,"
+                 << "tokens_before INTEGER NOT NULL DEFAULT 0,"
                  << "created_at TIMESTAMP DEFAULT CURRENT_TIMESTAMP,"
-                 << "FOREIGN KEY (session_id) REFERENCES " << sessions_table_ << " (session_id) ON DELETE CASCADE"
+                 << "FOREIGN KEY (session_id) REFERENCES " << sessions_table << " (session_id) ON DELETE CASCADE"
                  << ")";
+    sql->create_messages_table = messages_sql.str();
     
     std::ostringstream index_sql;
-    index_sql << "CREATE INDEX IF NOT EXISTS idx_" << messages_table_ << "_session_id "
-              << "ON " << messages_table_ << " (session_id, created_at)";
+    index_sql << "CREATE INDEX IF NOT EXISTS idx_" << messages_table << "_session_item "
+              << "ON " << messages_table << " (session_id, id)";
+    sql->create_messages_index = index_sql.str();
+    // Running token offsets grow with id, so a budget maps to one index range
+    sql->create_tokens_index = "CREATE INDEX IF NOT EXISTS idx_" + messages_table + "_session_tokens "
+                               "ON " + messages_table + " (session_id, tokens_before)";
+    // Items are ordered by id now, so the old (session_id, created_at) index only slows writes
+    sql->drop_legacy_index = "DROP INDEX IF EXISTS idx_" + messages_table + "_session_id";
+    
+    // Tables created before item records moved to message_blob lack the column
+    sql->messages_table_info = "PRAGMA table_info(" + messages_table + ")";
+    sql->add_blob_column = "ALTER TABLE " + messages_table + " ADD COLUMN message_blob BLOB";
+    
+    // Likewise for the maintained item count, which is backfilled once
+    sql->sessions_table_info = "PRAGMA table_info(" + sessions_table + ")";
+    sql->add_item_count_column = "ALTER TABLE " + sessions_table + " ADD COLUMN item_count INTEGER NOT NULL DEFAULT 0";
+    sql->backfill_item_counts = "UPDATE " + sessions_table + " SET item_count = "
+                                "(SELECT COUNT(*) FROM " + messages_table + " m WHERE m.session_id = " +
+                                sessions_table + ".session_id)";
+    
+    // Token columns; older rows get a length-based estimate
+    sql->add_token_count_column = "ALTER TABLE " + messages_table + " ADD COLUMN token_count INTEGER NOT NULL DEFAULT 0";
+    sql->add_tokens_before_column = "ALTER TABLE " + messages_table + " ADD COLUMN tokens_before INTEGER NOT NULL DEFAULT 0";
+    sql->backfill_token_counts = "UPDATE " + messages_table + " SET token_count = "
+                                 "(LENGTH(message_data) + COALESCE(LENGTH(message_blob), 0) + 3) / 4 + 4";
+    sql->backfill_tokens_before = "UPDATE " + messages_table + " SET tokens_before = totals.running FROM "
+                                  "(SELECT id, SUM(token_count) OVER (PARTITION BY session_id ORDER BY id) - token_count AS running FROM " +
+                                  messages_table + ") AS totals WHERE " + messages_table + ".id = totals.id";
+    sql->add_session_token_column = "ALTER TABLE " + sessions_table + " ADD COLUMN token_total INTEGER NOT NULL DEFAULT 0";
+    sql->backfill_session_tokens = "UPDATE " + sessions_table + " SET token_total = "
+                                   "(SELECT COALESCE(SUM(token_count), 0) FROM " + messages_table + " m WHERE m.session_id = " +
+                                   sessions_table + ".session_id)";
+    
+    sql->insert_session = "INSERT OR IGNORE INTO " + sessions_table + " (session_id) VALUES (?)";
+    // message_data is left empty for binary records; it holds JSON only in legacy rows
+    sql->insert_item = "INSERT INTO " + messages_table +
+                       " (session_id, message_data, message_blob, token_count, tokens_before) VALUES (?, '', ?, ?, ?)";
+    
+    sql->insert_items.reserve(kMaxInsertBatchRows);
+    std::string rows_sql = sql->insert_item;
+    for (size_t rows = 1; rows <= kMaxInsertBatchRows; rows++) {
+        if (rows > 1) {
+            rows_sql += ", (?, '', ?, ?, ?)";
+        }
+        sql->insert_items.push_back(rows_sql);
+    }
+    // Item and token counts are kept in step with every insert and delete
+    sql->select_session_tokens = "SELECT token_total FROM " + sessions_table + " WHERE session_id = ?";
+    sql->touch_session = "UPDATE " + sessions_table + " SET updated_at = CURRENT_TIMESTAMP, "
+                         "item_count = item_count + ?, token_total = token_total + ? WHERE session_id = ?";
+    sql->decrement_counts = "UPDATE " + sessions_table + " SET updated_at = CURRENT_TIMESTAMP, "
+                            "item_count = item_count - 1, token_total = token_total - ? WHERE session_id = ?";
     
-    conn->execute(sessions_sql.str());
-    conn->execute(messages_sql.str());
-    conn->execute(index_sql.str());
+    sql->select_all_items = "SELECT message_data, message_blob FROM " + messages_table +
+                            " WHERE session_id = ? ORDER BY id ASC";
+    sql->select_last_items = "SELECT message_data, message_blob FROM " + messages_table +
+                             " WHERE session_id = ? ORDER BY id DESC LIMIT ?";
+    sql->select_last_item = "SELECT id, message_data, message_blob, token_count FROM " + messages_table +
+                            " WHERE session_id = ? ORDER BY id DESC LIMIT 1";
+    
+    // Keyset pagination; both walk the (session_id, id) index
+    sql->scan_items = "SELECT id, message_data, message_blob FROM " + messages_table +
+                      " WHERE session_id = ? AND id > ? ORDER BY id ASC LIMIT ?";
+    sql->scan_items_reverse = "SELECT id, message_data, message_blob FROM " + messages_table +
+                              " WHERE session_id = ? AND id < ? ORDER BY id DESC LIMIT ?";
+    
+    // Rows whose suffix of token counts fits the budget: the session total
+    // minus a row's tokens_before is the cost of it and every later item
+    sql->select_items_within_budget = "SELECT message_data, message_blob FROM " + messages_table +
+                                      " WHERE session_id = ?1 AND tokens_before >= "
+                                      "(SELECT token_total FROM " + sessions_table + " WHERE session_id = ?1) - ?2"
+                                      " ORDER BY tokens_before ASC, id ASC";  // id order, straight off the index
+    
+    sql->delete_item = "DELETE FROM " + messages_table + " WHERE id = ?";
+    sql->delete_session_items = "DELETE FROM " + messages_table + " WHERE session_id = ?";
+    sql->delete_session = "DELETE FROM " + sessions_table + " WHERE session_id = ?";
+    
+    // Per-session aggregates: count, tokens, stored bytes, first and last item time
+    std::string aggregates = "COUNT(*), COALESCE(SUM(token_count), 0), "
+                             "COALESCE(SUM(LENGTH(CAST(message_data AS BLOB)) + COALESCE(LENGTH(message_blob), 0)), 0), "
+                             "CAST(strftime('%s', MIN(created_at)) AS INTEGER), "
+                             "CAST(strftime('%s', MAX(created_at)) AS INTEGER)";
+    sql->summarize_session = "SELECT session_id, " + aggregates + " FROM " + messages_table + " WHERE session_id = ?";
+    sql->summarize_sessions = "SELECT session_id, " + aggregates + " FROM " + messages_table +
+                              " GROUP BY session_id ORDER BY session_id LIMIT ?";
+    sql->summarize_sessions_after = "SELECT session_id, " + aggregates + " FROM " + messages_table +
+                                    " WHERE session_id > ? GROUP BY session_id ORDER BY session_id LIMIT ?";
+    
+    sql->count_session_items = "SELECT item_count FROM " + sessions_table + " WHERE session_id = ?";
+    sql->count_sessions = "SELECT COUNT(*) FROM " + sessions_table;
+    sql->count_items = "SELECT COALESCE(SUM(item_count), 0) FROM " + sessions_table;
+    
+    // Full-text index over item text, keyed by message row id. It keeps its
+    // own copy of the text, since message_blob is binary, and is optional:
+    // writers maintain it only once it exists.
+    std::string search_table = messages_table + "_search";
+    sql->search_table_exists = "SELECT 1 FROM sqlite_master WHERE type = 'table' AND name = '" + search_table + "'";
+    sql->create_search_table = "CREATE VIRTUAL TABLE IF NOT EXISTS " + search_table +
+                               " USING fts5(content, session_id UNINDEXED)";
+    sql->scan_all_items = "SELECT id, session_id, message_data, message_blob FROM " + messages_table +
+                          " WHERE id > ? ORDER BY id ASC LIMIT ?";
+    sql->insert_search_row = "INSERT INTO " + search_table + " (rowid, content, session_id) VALUES (?, ?, ?)";
+    sql->delete_search_row = "DELETE FROM " + search_table + " WHERE rowid = ?";
+    // Goes through the (session_id, id) index; session_id is not indexed in the FTS table
+    sql->delete_session_search_rows = "DELETE FROM " + search_table + " WHERE rowid IN "
+                                      "(SELECT id FROM " + messages_table + " WHERE session_id = ?)";
+    std::string search_columns = "SELECT session_id, rowid, snippet(" + search_table + ", 0, '[', ']', '...', 16), rank FROM " +
+                                 search_table + " WHERE " + search_table + " MATCH ?";
+    sql->search_items = search_columns + " ORDER BY rank LIMIT ?";
+    sql->search_session_items = search_columns + " AND session_id = ? ORDER BY rank LIMIT ?";
+    
+    return sql;
 }
 
-std::shared_ptr<SQLiteConnection> SQLiteSession::get_connection() const {
-    if (is_memory_db_) {
-        std::lock_guard<std::mutex> lock(connection_mutex_);
-        return shared_connection_;
-    } else {
-        if (!thread_connection_) {
-            thread_connection_ = std::make_shared<SQLiteConnection>(db_path_);
-        }
-        return thread_connection_;
+// Statement text is shared by every session using the same table pair
+static std::shared_ptr<const SQLiteStatements> get_sqlite_statements(
+    const std::string& sessions_table,
+    const std::string& messages_table
+) {
+    static std::mutex registry_mutex;
+    static std::map<std::pair<std::string, std::string>, std::shared_ptr<const SQLiteStatements>> registry;
+    
+    std::lock_guard<std::mutex> lock(registry_mutex);
+    auto& entry = registry[{sessions_table, messages_table}];
+    if (!entry) {
+        entry = build_sqlite_statements(sessions_table, messages_table);
     }
+    return entry;
 }
 
-std::future<std::vector<std::shared_ptr<Item>>> SQLiteSession::get_items(std::optional<size_t> limit) {
-    return std::async(std::launch::async, [this, limit]() {
-        return get_items_internal(limit);
-    });
+// An item encoded for message_blob, with its token count. The item is
+// kept for the search index, whose text is only extracted if it exists.
+struct EncodedRow {
+    std::string record;
+    int64_t tokens;
+    std::shared_ptr<Item> item;
+};
+
+static std::vector<EncodedRow> encode_rows(const std::vector<std::shared_ptr<Item>>& items) {
+    std::vector<EncodedRow> rows;
+    rows.reserve(items.size());
+    for (const auto& item : items) {
+        rows.push_back({ItemCodec::encode(*item), static_cast<int64_t>(count_item_tokens(*item)), item});
+    }
+    return rows;
 }
 
-std::vector<std::shared_ptr<Item>> SQLiteSession::get_items_internal(std::optional<size_t> limit) {
-    auto conn = get_connection();
-    
-    std::ostringstream sql;
-    if (!limit.has_value()) {
-        sql << "SELECT message_data FROM " << messages_table_
-            << " WHERE session_id = '" << session_id_ << "'"
-            << " ORDER BY created_at ASC";
-    } else {
-        sql << "SELECT message_data FROM " << messages_table_
-            << " WHERE session_id = '" << session_id_ << "'"
-            << " ORDER BY created_at DESC LIMIT " << limit.value();
+// Whether the full-text index exists for a table pair. The answer is
+// cached on the connection pool, so per database file, and once a session
+// has opened the tables this touches no connection.
+static bool has_search_table(SQLiteConnectionPool& pool, const SQLiteStatements& sql) {
+    if (pool.is_schema_ready(sql.search_schema_key)) {
+        return true;
     }
-    
-    auto results = conn->query(sql.str());
-    
-    std::vector<std::shared_ptr<Item>> items;
-    items.reserve(results.size());
-    
-    for (const auto& row : results) {
-        if (!row.empty()) {
-            try {
-                // Parse JSON and convert to Item
-                auto json = util::JsonParser::parse(row[0]);
-                auto item = std::make_shared<MessageItem>("", ""); // Simplified for now
-                // In a real implementation, would deserialize from JSON
-                items.push_back(item);
-            } catch (const std::exception& e) {
-                auto logger = get_logger("SQLiteSession");
-                logger->warning("Failed to parse item from database: " + std::string(e.what()));
-            }
-        }
+    if (pool.is_schema_ready(sql.schema_key)) {
+        return false;
     }
-    
-    // Reverse if we used DESC order for limit
-    if (limit.has_value()) {
-        std::reverse(items.begin(), items.end());
+    if (pool.acquire_reader()->query(sql.search_table_exists).empty()) {
+        return false;
     }
-    
-    return items;
+    pool.mark_schema_ready(sql.search_schema_key);
+    return true;
 }
 
-std::future<void> SQLiteSession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
-    return std::async(std::launch::async, [this, items]() {
-        add_items_internal(items);
-    });
+// Whether SQLite failed because a table is gone, e.g. a search table
+// dropped by another connection after it was cached as present
+static bool is_missing_table_error(const std::exception& e) {
+    return std::string_view(e.what()).find("no such table") != std::string_view::npos;
 }
 
-void SQLiteSession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
-    if (items.empty()) return;
-    
-    auto conn = get_connection();
+// Runs write(indexed) with the cached answer for whether the search index
+// exists. If the index turns out to be missing, the cached answer is
+// dropped and the write is retried once without it; write must undo its
+// own changes before it throws.
+template<typename Write>
+static void with_search_index(SQLiteConnectionPool& pool, const SQLiteStatements& sql, const Write& write) {
+    bool indexed = has_search_table(pool, sql);
+    try {
+        write(indexed);
+    } catch (const std::exception& e) {
+        if (!indexed || !is_missing_table_error(e)) {
+            throw;
+        }
+        pool.forget_schema(sql.search_schema_key);
+        write(false);
+    }
+}
+
+// Ranked hits from the search table, optionally for one session only
+static std::vector<SearchResult> search_tables(
+    SQLiteConnectionPool& pool,
+    const SQLiteStatements& sql,
+    const std::string& query,
+    const std::string* session_id,
+    size_t limit
+) {
+    std::vector<SearchResult> results;
+    if (limit == 0 || !has_search_table(pool, sql)) {
+        return results;
+    }
     
+    int64_t max_rows = static_cast<int64_t>(std::min<uint64_t>(limit, std::numeric_limits<int64_t>::max()));
+    auto conn = pool.acquire_reader();
+    auto on_row = [&results](const std::vector<std::string>& row) {
+        SearchResult result;
+        result.session_id = row[0];
+        result.item_id = std::stoll(row[1]);
+        result.snippet = row[2];
+        result.score = std::stod(row[3]);
+        results.push_back(std::move(result));
+        return true;
+    };
     try {
-        conn->begin_transaction();
-        
-        // Ensure session exists
-        std::ostringstream session_sql;
-        session_sql << "INSERT OR IGNORE INTO " << sessions_table_ << " (session_id) VALUES (?)";
-        conn->execute_with_params(session_sql.str(), {session_id_});
-        
-        // Add items
-        std::ostringstream item_sql;
-        item_sql << "INSERT INTO " << messages_table_ << " (session_id, message_data) VALUES (?, ?)";
-        
-        for (const auto& item : items) {
-            // Serialize item to JSON
-            auto json_dict = item->to_dict();
-            util::JsonBuilder builder;
-            for (const auto& [key, value] : json_dict) {
-                builder.set(key, util::JsonUtils::from_any(value));
-            }
-            std::string json_str = builder.to_string();
-            
-            conn->execute_with_params(item_sql.str(), {session_id_, json_str});
+        if (session_id) {
+            conn->query_each(sql.search_session_items, {query, *session_id, max_rows}, on_row);
+        } else {
+            conn->query_each(sql.search_items, {query, max_rows}, on_row);
         }
-        
-        // Update session timestamp
-        std::ostringstream update_sql;
-        update_sql << "UPDATE " << sessions_table_ << " SET updated_at = CURRENT_TIMESTAMP WHERE session_id = ?";
-        conn->execute_with_params(update_sql.str(), {session_id_});
-        
-        conn->commit();
-        update_timestamp();
-        
     } catch (const std::exception& e) {
-        conn->rollback();
-        throw;
+        if (!is_missing_table_error(e)) {
+            throw;
+        }
+        pool.forget_schema(sql.search_schema_key);
+        results.clear();
     }
+    return results;
 }
 
-std::future<std::shared_ptr<Item>> SQLiteSession::pop_item() {
-    return std::async(std::launch::async, [this]() {
-        return pop_item_internal();
+// Rebuild an item from a (message_data, message_blob) row
+static std::shared_ptr<Item> deserialize_row(const std::string& message_data, const std::string& message_blob) {
+    if (!message_blob.empty()) {
+        return ItemCodec::decode(message_blob);
+    }
+    return ItemCodec::decode_json(message_data);
+}
+
+// Fill a summary from a summarize_session(s) row
+static void read_summary_row(const std::vector<std::string>& row, SessionSummary& summary) {
+    summary.session_id = row[0];
+    summary.item_count = std::stoull(row[1]);
+    summary.total_tokens = std::stoull(row[2]);
+    summary.total_bytes = std::stoull(row[3]);
+    summary.first_item_at.reset();
+    summary.last_item_at.reset();
+    if (!row[4].empty()) {
+        summary.first_item_at = std::chrono::system_clock::from_time_t(std::stoll(row[4]));
+    }
+    if (!row[5].empty()) {
+        summary.last_item_at = std::chrono::system_clock::from_time_t(std::stoll(row[5]));
+    }
+}
+
+// Write one session's rows inside an already open transaction
+static void write_session_rows(
+    SQLiteConnection& conn,
+    const SQLiteStatements& sql,
+    const std::string& session_id,
+    const std::vector<EncodedRow>& rows,
+    bool indexed
+) {
+    conn.execute_with_params(sql.insert_session, {session_id});
+    
+    // Each row stores the session's token total before it
+    int64_t token_total = 0;
+    auto totals = conn.query(sql.select_session_tokens, {session_id});
+    if (!totals.empty() && !totals[0].empty()) {
+        token_total = std::stoll(totals[0][0]);
+    }
+    int64_t batch_tokens = 0;
+    
+    std::vector<SQLiteParam> params;
+    params.reserve(std::min(rows.size(), kMaxInsertBatchRows) * 4);
+    for (size_t offset = 0; offset < rows.size(); offset += kMaxInsertBatchRows) {
+        size_t count = std::min(kMaxInsertBatchRows, rows.size() - offset);
+        params.clear();
+        for (size_t i = 0; i < count; i++) {
+            const auto& row = rows[offset + i];
+            params.emplace_back(session_id);
+            params.emplace_back(SQLiteBlob{row.record});
+            params.emplace_back(row.tokens);
+            params.emplace_back(token_total + batch_tokens);
+            batch_tokens += row.tokens;
+        }
+        conn.execute_with_params(sql.insert_items[count - 1], params);
+        
+        if (indexed) {
+            int64_t first_id = conn.last_insert_rowid() - static_cast<int64_t>(count) + 1;
+            for (size_t i = 0; i < count; i++) {
+                conn.execute_with_params(sql.insert_search_row,
+                                         {first_id + static_cast<int64_t>(i), item_text(*rows[offset + i].item), session_id});
+            }
+        }
+    }
+    
+    conn.execute_with_params(sql.touch_session, {static_cast<int64_t>(rows.size()), batch_tokens, session_id});
+}
+
+// Coalesces add_items calls from every session on one database file into
+// a single durable transaction per flush
+class SQLiteGroupCommitter {
+private:
+    struct PendingWrite {
+        std::shared_ptr<const SQLiteStatements> statements;
+        std::string session_id;
+        std::vector<EncodedRow> rows;
+        std::promise<void> done;
+    };
+    
+    std::string db_path_;
+    GroupCommitOptions options_;
+    std::vector<PendingWrite> pending_;
+    size_t pending_rows_ = 0;
+    std::chrono::steady_clock::time_point first_pending_at_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool stopping_ = false;
+    std::shared_ptr<SQLiteConnectionPool> pool_;
+    std::thread flusher_;
+
+public:
+    SQLiteGroupCommitter(
+        const std::string& db_path,
+        const GroupCommitOptions& options,
+        std::shared_ptr<SQLiteConnectionPool> pool
+    ) : db_path_(db_path), options_(options), pool_(std::move(pool)) {
+        flusher_ = std::thread([this]() { run(); });
+    }
+    
+    ~SQLiteGroupCommitter() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+        cv_.notify_all();
+        if (flusher_.joinable()) {
+            flusher_.join();
+        }
+    }
+    
+    std::future<void> submit(
+        std::shared_ptr<const SQLiteStatements> statements,
+        const std::string& session_id,
+        std::vector<EncodedRow> rows
+    ) {
+        PendingWrite write{std::move(statements), session_id, std::move(rows), {}};
+        auto future = write.done.get_future();
+        
+        bool wake_flusher;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            // The flusher sleeps until the first write arms the delay timer,
+            // and is woken again only once the row threshold is reached
+            wake_flusher = pending_.empty();
+            if (wake_flusher) {
+                first_pending_at_ = std::chrono::steady_clock::now();
+            }
+            pending_rows_ += write.rows.size();
+            pending_.push_back(std::move(write));
+            wake_flusher = wake_flusher || pending_rows_ >= options_.max_rows;
+        }
+        if (wake_flusher) {
+            cv_.notify_one();
+        }
+        return future;
+    }
+    
+    // One committer per database file and option set, shared by all
+    // sessions using both. Committers with different options on the same
+    // file take turns on the pool's writer.
+    static std::shared_ptr<SQLiteGroupCommitter> for_path(
+        const std::string& db_path,
+        const GroupCommitOptions& options,
+        std::shared_ptr<SQLiteConnectionPool> pool
+    ) {
+        static std::mutex registry_mutex;
+        static std::map<std::tuple<std::string, int64_t, size_t>, std::weak_ptr<SQLiteGroupCommitter>> registry;
+        
+        auto key = std::make_tuple(db_path, static_cast<int64_t>(options.max_delay.count()), options.max_rows);
+        std::lock_guard<std::mutex> lock(registry_mutex);
+        auto committer = registry[key].lock();
+        if (!committer) {
+            committer = std::make_shared<SQLiteGroupCommitter>(db_path, options, std::move(pool));
+            registry[key] = committer;
+        }
+        return committer;
+    }
+
+private:
+    void run() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (true) {
+            cv_.wait(lock, [this]() { return stopping_ || !pending_.empty(); });
+            if (!stopping_) {
+                cv_.wait_until(lock, first_pending_at_ + options_.max_delay, [this]() {
+                    return stopping_ || pending_rows_ >= options_.max_rows;
+                });
+            }
+            if (pending_.empty()) {
+                if (stopping_) break;
+                continue;
+            }
+            
+            std::vector<PendingWrite> batch;
+            batch.swap(pending_);
+            pending_rows_ = 0;
+            
+            lock.unlock();
+            flush(*pool_->acquire_writer(), batch);
+            lock.lock();
+        }
+    }
+    
+    // Each write runs in its own savepoint, so one failing session does not
+    // fail the rest of the batch. The commit is the durability point for
+    // every write in it, so only it runs with synchronous=FULL; the shared
+    // writer goes back to NORMAL for direct writes.
+    void flush(SQLiteConnection& conn, std::vector<PendingWrite>& batch) {
+        std::vector<std::exception_ptr> errors(batch.size());
+        std::exception_ptr failure;
+        try {
+            conn.execute("PRAGMA synchronous=FULL");
+            conn.begin_transaction();
+            try {
+                for (size_t i = 0; i < batch.size(); i++) {
+                    const auto& write = batch[i];
+                    conn.execute_with_params("SAVEPOINT group_write", {});
+                    try {
+                        with_search_index(*pool_, *write.statements, [&](bool indexed) {
+                            try {
+                                write_session_rows(conn, *write.statements, write.session_id, write.rows, indexed);
+                            } catch (...) {
+                                conn.execute_with_params("ROLLBACK TO group_write", {});
+                                throw;
+                            }
+                        });
+                    } catch (...) {
+                        errors[i] = std::current_exception();
+                    }
+                    conn.execute_with_params("RELEASE group_write", {});
+                }
+                conn.commit();
+            } catch (...) {
+                conn.rollback();
+                throw;
+            }
+        } catch (...) {
+            failure = std::current_exception();
+        }
+        
+        try {
+            conn.execute("PRAGMA synchronous=NORMAL");
+        } catch (const std::exception& e) {
+            get_logger("SQLiteSession")->warning("Failed to restore synchronous mode: " + std::string(e.what()));
+        }
+        
+        if (failure) {
+            for (auto& write : batch) {
+                write.done.set_exception(failure);
+            }
+            return;
+        }
+        
+        for (size_t i = 0; i < batch.size(); i++) {
+            if (errors[i]) {
+                batch[i].done.set_exception(errors[i]);
+            } else {
+                batch[i].done.set_value();
+            }
+        }
+    }
+};
+
+void SQLiteSession::init_database() {
+    statements_ = get_sqlite_statements(sessions_table_, messages_table_);
+    pool_ = SQLiteConnectionPool::for_path(db_path_, default_max_readers.load());
+    
+    // In-memory databases are private to their connection, so there is
+    // nothing to share a group commit with
+    if (group_commit_options_.enabled && !is_memory_db_) {
+        group_committer_ = SQLiteGroupCommitter::for_path(db_path_, group_commit_options_, pool_);
+    }
+    
+    // Schema setup runs once per file and table pair; later sessions on
+    // the same pool skip the DDL and table_info checks
+    if (!pool_->is_schema_ready(statements_->schema_key)) {
+        init_db_for_connection(get_writer());
+        pool_->mark_schema_ready(statements_->schema_key);
+    }
+}
+
+void SQLiteSession::init_db_for_connection(std::shared_ptr<SQLiteConnection> conn) {
+    conn->execute(statements_->create_sessions_table);
+    conn->execute(statements_->create_messages_table);
+    
+    // Bring tables from older versions up to date; each step runs once
+    // table_info rows are (cid, name, type, notnull, dflt_value, pk)
+    auto has_column = [&conn](const std::string& table_info, const std::string& name) {
+        auto columns = conn->query(table_info);
+        return std::any_of(columns.begin(), columns.end(), [&name](const auto& column) {
+            return column.size() > 1 && column[1] == name;
+        });
+    };
+    auto migrate = [&conn](std::initializer_list<const std::string*> steps) {
+        conn->begin_transaction();
+        try {
+            for (const auto* step : steps) {
+                conn->execute(*step);
+            }
+            conn->commit();
+        } catch (...) {
+            conn->rollback();
+            throw;
+        }
+    };
+    
+    if (!has_column(statements_->messages_table_info, "message_blob")) {
+        conn->execute(statements_->add_blob_column);
+    }
+    if (!has_column(statements_->messages_table_info, "token_count")) {
+        migrate({&statements_->add_token_count_column, &statements_->add_tokens_before_column,
+                 &statements_->backfill_token_counts, &statements_->backfill_tokens_before});
+    }
+    if (!has_column(statements_->sessions_table_info, "item_count")) {
+        migrate({&statements_->add_item_count_column, &statements_->backfill_item_counts});
+    }
+    if (!has_column(statements_->sessions_table_info, "token_total")) {
+        migrate({&statements_->add_session_token_column, &statements_->backfill_session_tokens});
+    }
+    
+    conn->execute(statements_->create_messages_index);
+    conn->execute(statements_->create_tokens_index);
+    conn->execute(statements_->drop_legacy_index);
+    
+    if (!conn->query(statements_->search_table_exists).empty()) {
+        pool_->mark_schema_ready(statements_->search_schema_key);
+    }
+}
+
+std::shared_ptr<SQLiteConnection> SQLiteSession::get_reader() const {
+    if (!pool_) {
+        throw AgentsException("SQLite session is closed: " + session_id_);
+    }
+    return pool_->acquire_reader();
+}
+
+std::shared_ptr<SQLiteConnection> SQLiteSession::get_writer() const {
+    if (!pool_) {
+        throw AgentsException("SQLite session is closed: " + session_id_);
+    }
+    return pool_->acquire_writer();
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> SQLiteSession::get_items(std::optional<size_t> limit) {
+    return submit([this, limit]() {
+        return get_items_internal(limit);
     });
 }
 
-std::shared_ptr<Item> SQLiteSession::pop_item_internal() {
-    auto conn = get_connection();
+std::vector<std::shared_ptr<Item>> SQLiteSession::get_items_internal(std::optional<size_t> limit) {
+    auto conn = get_reader();
+    
+    auto results = limit.has_value()
+        ? conn->query(statements_->select_last_items, {session_id_, static_cast<int64_t>(limit.value())})
+        : conn->query(statements_->select_all_items, {session_id_});
+    
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(results.size());
+    
+    for (const auto& row : results) {
+        if (row.size() >= 2) {
+            try {
+                items.push_back(deserialize_row(row[0], row[1]));
+            } catch (const std::exception& e) {
+                auto logger = get_logger("SQLiteSession");
+                logger->warning("Failed to parse item from database: " + std::string(e.what()));
+            }
+        }
+    }
+    
+    // Reverse if we used DESC order for limit
+    if (limit.has_value()) {
+        std::reverse(items.begin(), items.end());
+    }
+    
+    return items;
+}
+
+std::future<void> SQLiteSession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    if (group_committer_) {
+        return submit_group_commit(items);
+    }
+    return submit([this, items]() {
+        add_items_internal(items);
+    });
+}
+
+std::future<void> SQLiteSession::submit_group_commit(const std::vector<std::shared_ptr<Item>>& items) {
+    auto rows = encode_rows(items);
+    
+    if (rows.empty()) {
+        std::promise<void> done;
+        done.set_value();
+        return done.get_future();
+    }
     
-    // First, get the most recent item
-    std::ostringstream select_sql;
-    select_sql << "SELECT id, message_data FROM " << messages_table_
-               << " WHERE session_id = '" << session_id_ << "'"
-               << " ORDER BY created_at DESC LIMIT 1";
+    update_timestamp();
+    return group_committer_->submit(statements_, session_id_, std::move(rows));
+}
+
+void SQLiteSession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
+    if (items.empty()) return;
+    
+    if (group_committer_) {
+        submit_group_commit(items).get();
+        return;
+    }
+    
+    // Serialize before taking the write lock
+    auto rows = encode_rows(items);
     
-    auto results = conn->query(select_sql.str());
+    auto conn = get_writer();
+    
+    with_search_index(*pool_, *statements_, [&](bool indexed) {
+        conn->begin_transaction();
+        try {
+            write_session_rows(*conn, *statements_, session_id_, rows, indexed);
+            conn->commit();
+        } catch (...) {
+            conn->rollback();
+            throw;
+        }
+    });
+    update_timestamp();
+}
+
+std::future<std::shared_ptr<Item>> SQLiteSession::pop_item() {
+    return submit([this]() {
+        return pop_item_internal();
+    });
+}
+
+std::shared_ptr<Item> SQLiteSession::pop_item_internal() {
+    auto conn = get_writer();
     
+    std::vector<std::vector<std::string>> results;
+    with_search_index(*pool_, *statements_, [&](bool indexed) {
+        conn->begin_transaction();
+        try {
+            // First, get the most recent item
+            results = conn->query(statements_->select_last_item, {session_id_});
+            if (results.empty()) {
+                conn->commit();
+                return;
+            }
+            
+            // Delete the item and keep the session's count in step
+            int64_t item_id = std::stoll(results[0][0]);
+            int64_t tokens = std::stoll(results[0][3]);
+            conn->execute_with_params(statements_->delete_item, {item_id});
+            if (indexed) {
+                conn->execute_with_params(statements_->delete_search_row, {item_id});
+            }
+            conn->execute_with_params(statements_->decrement_counts, {tokens, session_id_});
+            conn->commit();
+        } catch (...) {
+            conn->rollback();
+            throw;
+        }
+    });
     if (results.empty()) {
         return nullptr;
     }
     
-    std::string item_id = results[0][0];
-    std::string message_data = results[0][1];
-    
-    // Delete the item
-    std::ostringstream delete_sql;
-    delete_sql << "DELETE FROM " << messages_table_ << " WHERE id = ?";
-    conn->execute_with_params(delete_sql.str(), {item_id});
+    const std::string& message_data = results[0][1];
+    const std::string& message_blob = results[0][2];
     
     // Parse and return the item
     try {
-        auto json = util::JsonParser::parse(message_data);
-        auto item = std::make_shared<MessageItem>("", ""); // Simplified for now
-        // In a real implementation, would deserialize from JSON
+        auto item = deserialize_row(message_data, message_blob);
         update_timestamp();
         return item;
     } catch (const std::exception& e) {
@@ -370,254 +1380,1569 @@ std::shared_ptr<Item> SQLiteSession::pop_item_internal() {
 }
 
 std::future<void> SQLiteSession::clear_session() {
-    return std::async(std::launch::async, [this]() {
+    return submit([this]() {
         clear_session_internal();
     });
 }
 
 void SQLiteSession::clear_session_internal() {
-    auto conn = get_connection();
+    auto conn = get_writer();
+    
+    with_search_index(*pool_, *statements_, [&](bool indexed) {
+        conn->begin_transaction();
+        try {
+            if (indexed) {
+                conn->execute_with_params(statements_->delete_session_search_rows, {session_id_});
+            }
+            conn->execute_with_params(statements_->delete_session_items, {session_id_});
+            conn->execute_with_params(statements_->delete_session, {session_id_});
+            conn->commit();
+        } catch (...) {
+            conn->rollback();
+            throw;
+        }
+    });
+    update_timestamp();
+}
+
+size_t SQLiteSession::get_item_count() const {
+    return get_item_count_internal();
+}
+
+size_t SQLiteSession::get_item_count_internal() const {
+    auto conn = get_reader();
+    
+    auto results = conn->query(statements_->count_session_items, {session_id_});
+    if (!results.empty() && !results[0].empty()) {
+        return std::stoul(results[0][0]);
+    }
+    return 0;
+}
+
+std::future<ItemPage> SQLiteSession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return submit([this, after_id, batch_size]() {
+        return scan_internal(after_id, batch_size, false);
+    });
+}
+
+std::future<ItemPage> SQLiteSession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return submit([this, before_id, batch_size]() {
+        return scan_internal(before_id, batch_size, true);
+    });
+}
+
+ItemPage SQLiteSession::scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse) {
+    ItemPage page;
+    if (batch_size == 0) {
+        return page;
+    }
+    
+    auto conn = get_reader();
+    
+    // One extra row tells whether another page follows
+    int64_t key = cursor.value_or(reverse ? std::numeric_limits<int64_t>::max() : 0);
+    auto results = conn->query(
+        reverse ? statements_->scan_items_reverse : statements_->scan_items,
+        {session_id_, key, static_cast<int64_t>(batch_size) + 1});
+    
+    bool has_more = results.size() > batch_size;
+    if (has_more) {
+        results.pop_back();
+    }
+    
+    page.items.reserve(results.size());
+    for (const auto& row : results) {
+        if (row.size() >= 3) {
+            try {
+                page.items.push_back(deserialize_row(row[1], row[2]));
+            } catch (const std::exception& e) {
+                auto logger = get_logger("SQLiteSession");
+                logger->warning("Failed to parse item from database: " + std::string(e.what()));
+            }
+        }
+    }
+    
+    // The cursor advances past unparseable rows too
+    if (has_more) {
+        page.next_cursor = std::stoll(results.back()[0]);
+    }
+    return page;
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> SQLiteSession::get_items_within_budget(size_t max_tokens) {
+    return submit([this, max_tokens]() {
+        return get_items_within_budget_internal(max_tokens);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> SQLiteSession::get_items_within_budget_internal(size_t max_tokens) {
+    auto conn = get_reader();
+    
+    // Budgets beyond int64 are the same as no budget
+    int64_t budget = static_cast<int64_t>(std::min<uint64_t>(max_tokens, std::numeric_limits<int64_t>::max()));
+    auto results = conn->query(statements_->select_items_within_budget, {session_id_, budget});
+    
+    std::vector<std::shared_ptr<Item>> items;
+    items.reserve(results.size());
+    for (const auto& row : results) {
+        if (row.size() >= 2) {
+            try {
+                items.push_back(deserialize_row(row[0], row[1]));
+            } catch (const std::exception& e) {
+                auto logger = get_logger("SQLiteSession");
+                logger->warning("Failed to parse item from database: " + std::string(e.what()));
+            }
+        }
+    }
+    return items;
+}
+
+SessionSummary SQLiteSession::get_summary() const {
+    auto conn = get_reader();
+    
+    SessionSummary summary;
+    auto results = conn->query(statements_->summarize_session, {session_id_});
+    if (!results.empty()) {
+        read_summary_row(results[0], summary);
+    }
+    summary.session_id = session_id_;
+    return summary;
+}
+
+bool SQLiteSession::summarize_all(const SessionSummaryVisitor& visitor) const {
+    // Pages are keyed on session id. Each one is buffered and the
+    // connection returned before the visitor runs, since on an in-memory
+    // database the reader is the only writer.
+    std::vector<SessionSummary> page;
+    std::optional<std::string> after;
+    while (true) {
+        page.clear();
+        {
+            auto conn = get_reader();
+            auto on_row = [&page](const std::vector<std::string>& row) {
+                page.emplace_back();
+                read_summary_row(row, page.back());
+                return true;
+            };
+            if (after) {
+                conn->query_each(statements_->summarize_sessions_after, {*after, kSummaryPageRows}, on_row);
+            } else {
+                conn->query_each(statements_->summarize_sessions, {kSummaryPageRows}, on_row);
+            }
+        }
+        
+        for (const auto& summary : page) {
+            if (!visitor(summary)) {
+                return false;
+            }
+        }
+        if (page.size() < static_cast<size_t>(kSummaryPageRows)) {
+            return true;
+        }
+        after = page.back().session_id;
+    }
+}
+
+void SQLiteSession::enable_search_index() {
+    // Ask the database rather than the cache, which may predate another
+    // connection dropping or creating the index
+    auto conn = get_writer();
+    if (!conn->query(statements_->search_table_exists).empty()) {
+        pool_->mark_schema_ready(statements_->search_schema_key);
+        return;
+    }
+    pool_->forget_schema(statements_->search_schema_key);
     
+    // Index what is already stored; holding the writer keeps new rows
+    // out until the index is marked ready and writers start maintaining it
     conn->begin_transaction();
     try {
-        std::ostringstream messages_sql;
-        messages_sql << "DELETE FROM " << messages_table_ << " WHERE session_id = ?";
-        conn->execute_with_params(messages_sql.str(), {session_id_});
+        conn->execute(statements_->create_search_table);
         
-        std::ostringstream sessions_sql;
-        sessions_sql << "DELETE FROM " << sessions_table_ << " WHERE session_id = ?";
-        conn->execute_with_params(sessions_sql.str(), {session_id_});
+        int64_t cursor = 0;
+        while (true) {
+            auto rows = conn->query(statements_->scan_all_items, {cursor, kSearchBackfillRows});
+            for (const auto& row : rows) {
+                try {
+                    auto item = deserialize_row(row[2], row[3]);
+                    conn->execute_with_params(statements_->insert_search_row,
+                                              {std::stoll(row[0]), item_text(*item), row[1]});
+                } catch (const std::exception& e) {
+                    auto logger = get_logger("SQLiteSession");
+                    logger->warning("Skipping unparseable item while indexing: " + std::string(e.what()));
+                }
+            }
+            if (rows.size() < static_cast<size_t>(kSearchBackfillRows)) {
+                break;
+            }
+            cursor = std::stoll(rows.back()[0]);
+        }
         
         conn->commit();
-        update_timestamp();
-        
-    } catch (const std::exception& e) {
+    } catch (...) {
         conn->rollback();
         throw;
     }
+    pool_->mark_schema_ready(statements_->search_schema_key);
+}
+
+bool SQLiteSession::has_search_index() const {
+    return pool_ && has_search_table(*pool_, *statements_);
+}
+
+std::vector<SearchResult> SQLiteSession::search(const std::string& query, size_t limit) const {
+    if (!pool_) {
+        throw AgentsException("SQLite session is closed: " + session_id_);
+    }
+    return search_tables(*pool_, *statements_, query, &session_id_, limit);
+}
+
+std::vector<SearchResult> SQLiteSession::search_all(const std::string& query, size_t limit) const {
+    if (!pool_) {
+        throw AgentsException("SQLite session is closed: " + session_id_);
+    }
+    return search_tables(*pool_, *statements_, query, nullptr, limit);
+}
+
+std::vector<SearchResult> SQLiteSession::search_database(
+    const std::string& db_path,
+    const std::string& sessions_table,
+    const std::string& messages_table,
+    const std::string& query,
+    size_t limit
+) {
+    auto pool = SQLiteConnectionPool::for_path(db_path, default_max_readers.load());
+    return search_tables(*pool, *get_sqlite_statements(sessions_table, messages_table), query, nullptr, limit);
+}
+
+void SQLiteSession::close() {
+    // Pending group commits hold their own reference to the pool
+    group_committer_.reset();
+    pool_.reset();
+}
+
+ConnectionPoolStats SQLiteSession::get_pool_stats() const {
+    return pool_ ? pool_->get_stats() : ConnectionPoolStats{};
+}
+
+bool SQLiteSession::rebind(const std::string& session_id) {
+    if (!pool_) {
+        return false;
+    }
+    
+    if (is_memory_db_ && session_id != session_id_) {
+        clear_session_internal();
+    }
+    reset_identity(session_id);
+    return true;
+}
+
+void SQLiteSession::warm_up(size_t reader_count) {
+    const auto& sql = *statements_;
+    const std::string* reads[] = {
+        &sql.select_all_items, &sql.select_last_items, &sql.count_session_items,
+        &sql.scan_items, &sql.scan_items_reverse, &sql.select_items_within_budget,
+        &sql.summarize_session
+    };
+    const std::string* writes[] = {
+        &sql.insert_session, &sql.select_session_tokens, &sql.insert_items[0],
+        &sql.touch_session, &sql.select_last_item, &sql.delete_item, &sql.decrement_counts
+    };
+    
+    {
+        auto writer = get_writer();
+        for (const auto* statement : writes) {
+            writer->prepare(*statement);
+        }
+        if (pool_->get_max_readers() == 0) {
+            // Reads are served by the writer
+            for (const auto* statement : reads) {
+                writer->prepare(*statement);
+            }
+            return;
+        }
+    }
+    
+    // Hold every reader at once so each checkout opens or reuses a
+    // distinct connection
+    std::vector<std::shared_ptr<SQLiteConnection>> readers;
+    reader_count = std::min(reader_count, pool_->get_max_readers());
+    for (size_t i = 0; i < reader_count; i++) {
+        readers.push_back(get_reader());
+        for (const auto* statement : reads) {
+            readers.back()->prepare(*statement);
+        }
+    }
+}
+
+void SQLiteSession::set_default_max_readers(size_t max_readers) {
+    default_max_readers = max_readers;
+}
+
+void SQLiteSession::vacuum() {
+    auto conn = get_writer();
+    conn->execute("VACUUM");
+}
+
+void SQLiteSession::analyze() {
+    auto conn = get_writer();
+    conn->execute("ANALYZE");
+}
+
+std::map<std::string, std::any> SQLiteSession::get_db_stats() const {
+    auto conn = get_reader();
+    std::map<std::string, std::any> stats;
+    
+    try {
+        auto results = conn->query(statements_->count_sessions);
+        if (!results.empty() && !results[0].empty()) {
+            stats["total_sessions"] = std::stoi(results[0][0]);
+        }
+        
+        results = conn->query(statements_->count_items);
+        if (!results.empty() && !results[0].empty()) {
+            stats["total_messages"] = std::stoi(results[0][0]);
+        }
+        
+        stats["db_path"] = db_path_;
+        stats["is_memory_db"] = is_memory_db_;
+        stats["cached_statements"] = conn->cached_statement_count();
+        
+        auto pool_stats = pool_->get_stats();
+        stats["pool_reader_connections"] = pool_stats.reader_connections;
+        stats["pool_max_readers"] = pool_stats.max_readers;
+        stats["pool_reader_checkouts"] = pool_stats.reader_checkouts;
+        stats["pool_writer_checkouts"] = pool_stats.writer_checkouts;
+        stats["pool_reader_wait_ms"] = std::chrono::duration<double, std::milli>(pool_stats.reader_wait_time).count();
+        stats["pool_writer_wait_ms"] = std::chrono::duration<double, std::milli>(pool_stats.writer_wait_time).count();
+        
+    } catch (const std::exception& e) {
+        stats["error"] = std::string(e.what());
+    }
+    
+    return stats;
+}
+
+// MemorySession implementation
+// Memory operations never block on I/O, so they run inline by default
+MemorySession::MemorySession(const std::string& session_id)
+    : SessionBase(session_id, get_inline_session_executor()) {
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> MemorySession::get_items(std::optional<size_t> limit) {
+    return submit([this, limit]() {
+        return get_items_internal(limit);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> MemorySession::get_items_internal(std::optional<size_t> limit) {
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    
+    if (!limit.has_value()) {
+        return items_;
+    }
+    
+    size_t start_idx = items_.size() > limit.value() ? items_.size() - limit.value() : 0;
+    return std::vector<std::shared_ptr<Item>>(items_.begin() + start_idx, items_.end());
+}
+
+std::future<void> MemorySession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    return submit([this, items]() {
+        add_items_internal(items);
+    });
+}
+
+void MemorySession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
+    // Count outside the lock; a custom counter may be expensive
+    std::vector<size_t> tokens;
+    tokens.reserve(items.size());
+    for (const auto& item : items) {
+        tokens.push_back(count_item_tokens(*item));
+    }
+    
+    std::unique_lock<std::shared_mutex> lock(items_mutex_);
+    items_.insert(items_.end(), items.begin(), items.end());
+    for (size_t count : tokens) {
+        token_totals_.push_back(token_totals_.back() + count);
+    }
+    update_timestamp();
+}
+
+std::future<std::shared_ptr<Item>> MemorySession::pop_item() {
+    return submit([this]() {
+        return pop_item_internal();
+    });
+}
+
+std::shared_ptr<Item> MemorySession::pop_item_internal() {
+    std::unique_lock<std::shared_mutex> lock(items_mutex_);
+    
+    if (items_.empty()) {
+        return nullptr;
+    }
+    
+    auto item = items_.back();
+    items_.pop_back();
+    token_totals_.pop_back();
+    update_timestamp();
+    return item;
+}
+
+std::future<void> MemorySession::clear_session() {
+    return submit([this]() {
+        clear_session_internal();
+    });
+}
+
+void MemorySession::clear_session_internal() {
+    std::unique_lock<std::shared_mutex> lock(items_mutex_);
+    items_.clear();
+    token_totals_.resize(1);
+    update_timestamp();
+}
+
+bool MemorySession::rebind(const std::string& session_id) {
+    // Keeps the item vector's capacity for the next session
+    clear_session_internal();
+    reset_identity(session_id);
+    return true;
+}
+
+size_t MemorySession::get_item_count() const {
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    return items_.size();
+}
+
+std::future<ItemPage> MemorySession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return submit([this, after_id, batch_size]() {
+        return scan_internal(after_id, batch_size, false);
+    });
+}
+
+std::future<ItemPage> MemorySession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return submit([this, before_id, batch_size]() {
+        return scan_internal(before_id, batch_size, true);
+    });
+}
+
+ItemPage MemorySession::scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse) {
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    return page_by_position(1, items_.size(), cursor, batch_size, reverse,
+                            [this](size_t i) { return items_[i]; });
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> MemorySession::get_items_within_budget(size_t max_tokens) {
+    return submit([this, max_tokens]() {
+        return get_items_within_budget_internal(max_tokens);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> MemorySession::get_items_within_budget_internal(size_t max_tokens) {
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    
+    // Items from index i onward cost total - token_totals_[i]; find the first that fits
+    uint64_t total = token_totals_.back();
+    uint64_t floor = total > max_tokens ? total - max_tokens : 0;
+    size_t start = std::lower_bound(token_totals_.begin(), token_totals_.end(), floor) - token_totals_.begin();
+    return std::vector<std::shared_ptr<Item>>(items_.begin() + start, items_.end());
+}
+
+SessionSummary MemorySession::get_summary() const {
+    SessionSummary summary;
+    summary.session_id = session_id_;
+    
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    summary.item_count = items_.size();
+    summary.total_tokens = token_totals_.back();
+    if (!items_.empty()) {
+        summary.first_item_at = created_at_;
+        summary.last_item_at = updated_at_;
+    }
+    return summary;
+}
+
+void MemorySession::reserve_capacity(size_t capacity) {
+    std::unique_lock<std::shared_mutex> lock(items_mutex_);
+    items_.reserve(capacity);
+    token_totals_.reserve(capacity + 1);
+}
+
+size_t MemorySession::get_capacity() const {
+    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+    return items_.capacity();
+}
+
+// RingMemorySession implementation
+// Published cells are never modified, so a reader that loaded a cell
+// pointer can copy its item until the cell is reclaimed
+struct RingMemorySession::Cell {
+    std::shared_ptr<Item> item;
+};
+
+namespace {
+
+// Marks a reader as active for the cell reclamation check
+class RingReaderGuard {
+private:
+    std::atomic<uint32_t>& readers_;
+
+public:
+    explicit RingReaderGuard(std::atomic<uint32_t>& readers) : readers_(readers) {
+        readers_.fetch_add(1, std::memory_order_seq_cst);
+    }
+    ~RingReaderGuard() {
+        readers_.fetch_sub(1, std::memory_order_release);
+    }
+};
+
+} // namespace
+
+RingMemorySession::RingMemorySession(const std::string& session_id, size_t capacity)
+    : SessionBase(session_id, get_inline_session_executor()),
+      slots_(new std::atomic<Cell*>[std::max<size_t>(capacity, 1)]),
+      capacity_(std::max<size_t>(capacity, 1)) {
+    for (size_t i = 0; i < capacity_; i++) {
+        slots_[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+RingMemorySession::~RingMemorySession() {
+    for (size_t i = 0; i < capacity_; i++) {
+        delete slots_[i].load(std::memory_order_relaxed);
+    }
+    for (Cell* cell : retired_cells_) {
+        delete cell;
+    }
+    for (Cell* cell : free_cells_) {
+        delete cell;
+    }
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> RingMemorySession::get_items(std::optional<size_t> limit) {
+    return submit([this, limit]() {
+        return snapshot(limit);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> RingMemorySession::snapshot(std::optional<size_t> limit) const {
+    std::vector<std::shared_ptr<Item>> items;
+    {
+        RingReaderGuard reader(active_readers_);
+        
+        // Registering before the check pairs with reclaim_cells: either this
+        // reader sees the flag, or the writer sees it registered and waits
+        while (!reclaiming_.load(std::memory_order_seq_cst)) {
+            uint64_t sequence = sequence_.load(std::memory_order_acquire);
+            uint64_t begin = begin_.load(std::memory_order_relaxed);
+            uint64_t end = end_.load(std::memory_order_relaxed);
+            uint64_t count = end - begin;
+            if (limit.has_value()) {
+                count = std::min<uint64_t>(count, limit.value());
+            }
+            
+            // A racing write can only make the copy stale, never unsafe: the
+            // cells stay allocated while this reader is active, and the
+            // sequence check below catches the overlap
+            items.clear();
+            items.reserve(count);
+            for (uint64_t pos = end - count; pos < end; pos++) {
+                Cell* cell = slots_[pos % capacity_].load(std::memory_order_seq_cst);
+                items.push_back(cell ? cell->item : nullptr);
+            }
+            
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (!(sequence & 1) && sequence_.load(std::memory_order_relaxed) == sequence) {
+                return items;
+            }
+        }
+    }
+    
+    // A writer is waiting to reclaim cells; copy under its lock instead
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    uint64_t begin = begin_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    uint64_t count = end - begin;
+    if (limit.has_value()) {
+        count = std::min<uint64_t>(count, limit.value());
+    }
+    items.clear();
+    items.reserve(count);
+    for (uint64_t pos = end - count; pos < end; pos++) {
+        Cell* cell = slots_[pos % capacity_].load(std::memory_order_relaxed);
+        items.push_back(cell ? cell->item : nullptr);
+    }
+    return items;
+}
+
+size_t RingMemorySession::get_retired_cell_count() const {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    return retired_cells_.size();
+}
+
+std::future<void> RingMemorySession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    return submit([this, items]() {
+        add_items_internal(items);
+    });
+}
+
+void RingMemorySession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
+    if (items.empty()) return;
+    
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    begin_write();
+    
+    uint64_t begin = begin_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    for (const auto& item : items) {
+        if (end - begin == capacity_) {
+            begin++;
+            evicted_count_.fetch_add(1, std::memory_order_relaxed);
+        }
+        store_slot(end, item);
+        end++;
+    }
+    begin_.store(begin, std::memory_order_relaxed);
+    end_.store(end, std::memory_order_relaxed);
+    
+    end_write();
+    reclaim_cells();
+    update_timestamp();
+}
+
+std::future<std::shared_ptr<Item>> RingMemorySession::pop_item() {
+    return submit([this]() {
+        return pop_item_internal();
+    });
+}
+
+std::shared_ptr<Item> RingMemorySession::pop_item_internal() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    
+    uint64_t begin = begin_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    if (begin == end) {
+        return nullptr;
+    }
+    
+    begin_write();
+    end--;
+    Cell* cell = slots_[end % capacity_].load(std::memory_order_relaxed);
+    auto item = cell ? cell->item : nullptr;
+    store_slot(end, nullptr);
+    end_.store(end, std::memory_order_relaxed);
+    end_write();
+    
+    reclaim_cells();
+    update_timestamp();
+    return item;
+}
+
+std::future<void> RingMemorySession::clear_session() {
+    return submit([this]() {
+        clear_session_internal();
+    });
+}
+
+void RingMemorySession::clear_session_internal() {
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    begin_write();
+    
+    uint64_t begin = begin_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    for (uint64_t pos = begin; pos < end; pos++) {
+        store_slot(pos, nullptr);
+    }
+    begin_.store(end, std::memory_order_relaxed);
+    
+    end_write();
+    reclaim_cells();
+    update_timestamp();
+}
+
+std::future<ItemPage> RingMemorySession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return submit([this, after_id, batch_size]() {
+        return scan_internal(after_id, batch_size, false);
+    });
+}
+
+std::future<ItemPage> RingMemorySession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return submit([this, before_id, batch_size]() {
+        return scan_internal(before_id, batch_size, true);
+    });
+}
+
+ItemPage RingMemorySession::scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse) {
+    // Paging is not a hot path, so hold off writers rather than retry;
+    // no cell can be replaced while the write lock is held
+    std::lock_guard<std::mutex> lock(write_mutex_);
+    uint64_t begin = begin_.load(std::memory_order_relaxed);
+    uint64_t end = end_.load(std::memory_order_relaxed);
+    return page_by_position(static_cast<int64_t>(begin) + 1, end - begin, cursor, batch_size, reverse,
+                            [this, begin](size_t i) {
+                                Cell* cell = slots_[(begin + i) % capacity_].load(std::memory_order_relaxed);
+                                return cell ? cell->item : nullptr;
+                            });
+}
+
+bool RingMemorySession::rebind(const std::string& session_id) {
+    clear_session_internal();
+    evicted_count_.store(0, std::memory_order_relaxed);
+    reset_identity(session_id);
+    return true;
+}
+
+size_t RingMemorySession::get_item_count() const {
+    // A single consistent pair is enough here; retry if a write overlapped
+    while (true) {
+        uint64_t sequence = sequence_.load(std::memory_order_acquire);
+        uint64_t count = end_.load(std::memory_order_relaxed) - begin_.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (!(sequence & 1) && sequence_.load(std::memory_order_relaxed) == sequence) {
+            return static_cast<size_t>(count);
+        }
+    }
+}
+
+void RingMemorySession::begin_write() {
+    sequence_.fetch_add(1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+}
+
+void RingMemorySession::end_write() {
+    sequence_.fetch_add(1, std::memory_order_release);
+}
+
+void RingMemorySession::store_slot(uint64_t position, std::shared_ptr<Item> item) {
+    Cell* cell = nullptr;
+    if (item) {
+        if (free_cells_.empty()) {
+            cell = new Cell();
+        } else {
+            cell = free_cells_.back();
+            free_cells_.pop_back();
+        }
+        cell->item = std::move(item);
+    }
+    
+    Cell* replaced = slots_[position % capacity_].exchange(cell, std::memory_order_seq_cst);
+    if (replaced) {
+        retired_cells_.push_back(replaced);
+    }
+}
+
+void RingMemorySession::reclaim_cells() {
+    // The seq_cst exchange in store_slot and this load order against a
+    // reader's registration and slot loads: a reader that registered later
+    // can only see the new cells
+    if (retired_cells_.empty()) {
+        return;
+    }
+    if (active_readers_.load(std::memory_order_seq_cst) != 0) {
+        if (retired_cells_.size() < capacity_) {
+            return;
+        }
+        // Overlapping readers would otherwise keep every replaced cell
+        // alive. Send new readers to the locked path and wait out the
+        // current ones; with the write finished they cannot retry
+        reclaiming_.store(true, std::memory_order_seq_cst);
+        while (active_readers_.load(std::memory_order_seq_cst) != 0) {
+            std::this_thread::yield();
+        }
+    }
+    for (Cell* cell : retired_cells_) {
+        if (free_cells_.size() < capacity_) {
+            cell->item.reset();
+            free_cells_.push_back(cell);
+        } else {
+            delete cell;
+        }
+    }
+    retired_cells_.clear();
+    reclaiming_.store(false, std::memory_order_relaxed);
+}
+
+// WriteBehindSession implementation
+// Buffering is in-memory, so operations run inline by default
+WriteBehindSession::WriteBehindSession(std::shared_ptr<Session> backing, const WriteBehindOptions& options)
+    : SessionBase(backing->get_session_id(), get_inline_session_executor()),
+      backing_(std::move(backing)), options_(options) {
+    flusher_ = std::thread([this]() { run_flusher(); });
+}
+
+WriteBehindSession::~WriteBehindSession() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    cv_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+    
+    try {
+        flush();
+    } catch (const std::exception& e) {
+        auto logger = get_logger("WriteBehindSession");
+        logger->error("Dropping unflushed items for session " + session_id_ + ": " + e.what());
+    }
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> WriteBehindSession::get_items(std::optional<size_t> limit) {
+    return submit([this, limit]() {
+        return get_items_internal(limit);
+    });
+}
+
+std::vector<std::shared_ptr<Item>> WriteBehindSession::get_items_internal(std::optional<size_t> limit) {
+    std::shared_lock<std::shared_mutex> store_lock(store_mutex_);
+    
+    std::vector<std::shared_ptr<Item>> buffered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        size_t count = limit ? std::min(*limit, tail_.size()) : tail_.size();
+        buffered.assign(tail_.end() - count, tail_.end());
+    }
+    
+    // The newest items may all be buffered, in which case the store is not read
+    if (limit && *limit <= buffered.size()) {
+        return buffered;
+    }
+    
+    std::optional<size_t> durable_limit;
+    if (limit) {
+        durable_limit = *limit - buffered.size();
+    }
+    auto items = backing_->get_items(durable_limit).get();
+    items.insert(items.end(), buffered.begin(), buffered.end());
+    return items;
+}
+
+std::future<void> WriteBehindSession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    size_t buffered = 0;
+    if (!items.empty()) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (tail_.empty()) {
+            oldest_buffered_at_ = std::chrono::steady_clock::now();
+        }
+        tail_.insert(tail_.end(), items.begin(), items.end());
+        buffered = tail_.size();
+    }
+    
+    // Past the crash-safety bound the caller pays for the flush
+    if (options_.max_unflushed_items > 0 && buffered >= options_.max_unflushed_items) {
+        return submit([this]() {
+            flush();
+        });
+    }
+    
+    if (buffered >= options_.max_buffered_items) {
+        cv_.notify_one();
+    }
+    
+    std::promise<void> done;
+    done.set_value();
+    return done.get_future();
+}
+
+std::future<std::shared_ptr<Item>> WriteBehindSession::pop_item() {
+    return submit([this]() {
+        return pop_item_internal();
+    });
+}
+
+std::shared_ptr<Item> WriteBehindSession::pop_item_internal() {
+    std::unique_lock<std::shared_mutex> store_lock(store_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!tail_.empty()) {
+            auto item = tail_.back();
+            tail_.pop_back();
+            return item;
+        }
+    }
+    return backing_->pop_item().get();
+}
+
+std::future<void> WriteBehindSession::clear_session() {
+    return submit([this]() {
+        clear_session_internal();
+    });
+}
+
+void WriteBehindSession::clear_session_internal() {
+    std::unique_lock<std::shared_mutex> store_lock(store_mutex_);
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        tail_.clear();
+    }
+    backing_->clear_session().get();
+}
+
+size_t WriteBehindSession::get_item_count() const {
+    std::shared_lock<std::shared_mutex> store_lock(store_mutex_);
+    size_t buffered;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        buffered = tail_.size();
+    }
+    return backing_->get_item_count() + buffered;
+}
+
+std::future<ItemPage> WriteBehindSession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return submit([this, after_id, batch_size]() {
+        flush();
+        return backing_->scan(after_id, batch_size).get();
+    });
+}
+
+std::future<ItemPage> WriteBehindSession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return submit([this, before_id, batch_size]() {
+        flush();
+        return backing_->scan_reverse(before_id, batch_size).get();
+    });
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> WriteBehindSession::get_items_within_budget(size_t max_tokens) {
+    return submit([this, max_tokens]() {
+        std::shared_lock<std::shared_mutex> store_lock(store_mutex_);
+        
+        std::vector<std::shared_ptr<Item>> buffered;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            buffered = tail_;
+        }
+        
+        size_t used = 0;
+        size_t start = buffered.size();
+        while (start > 0) {
+            size_t tokens = count_item_tokens(*buffered[start - 1]);
+            if (used + tokens > max_tokens) break;
+            used += tokens;
+            start--;
+        }
+        buffered.erase(buffered.begin(), buffered.begin() + start);
+        
+        // Only reach into the store if the whole tail fit
+        if (start > 0) {
+            return buffered;
+        }
+        auto items = backing_->get_items_within_budget(max_tokens - used).get();
+        items.insert(items.end(), buffered.begin(), buffered.end());
+        return items;
+    });
+}
+
+SessionSummary WriteBehindSession::get_summary() const {
+    std::shared_lock<std::shared_mutex> store_lock(store_mutex_);
+    auto summary = backing_->get_summary();
+    
+    std::lock_guard<std::mutex> lock(mutex_);
+    summary.item_count += tail_.size();
+    for (const auto& item : tail_) {
+        summary.total_tokens += count_item_tokens(*item);
+    }
+    return summary;
 }
 
-size_t SQLiteSession::get_item_count() const {
-    return get_item_count_internal();
+void WriteBehindSession::set_metadata(const std::string& key, const std::any& value) {
+    backing_->set_metadata(key, value);
 }
 
-size_t SQLiteSession::get_item_count_internal() const {
-    auto conn = get_connection();
+size_t WriteBehindSession::get_buffered_count() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return tail_.size();
+}
+
+void WriteBehindSession::flush() {
+    std::unique_lock<std::shared_mutex> store_lock(store_mutex_);
     
-    std::ostringstream sql;
-    sql << "SELECT COUNT(*) FROM " << messages_table_ << " WHERE session_id = '" << session_id_ << "'";
+    std::vector<std::shared_ptr<Item>> batch;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        batch.swap(tail_);
+    }
+    if (batch.empty()) {
+        return;
+    }
     
-    auto results = conn->query(sql.str());
-    if (!results.empty() && !results[0].empty()) {
-        return std::stoul(results[0][0]);
+    try {
+        backing_->add_items(batch).get();
+    } catch (...) {
+        // Put the batch back ahead of anything buffered meanwhile; the
+        // flusher retries after max_delay
+        std::lock_guard<std::mutex> lock(mutex_);
+        tail_.insert(tail_.begin(), batch.begin(), batch.end());
+        oldest_buffered_at_ = std::chrono::steady_clock::now();
+        last_flush_failed_ = true;
+        throw;
     }
-    return 0;
+    
+    flushed_count_.fetch_add(batch.size(), std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(mutex_);
+    last_flush_failed_ = false;
 }
 
-void SQLiteSession::close() {
-    if (is_memory_db_) {
-        std::lock_guard<std::mutex> lock(connection_mutex_);
-        shared_connection_.reset();
-    } else {
-        thread_connection_.reset();
+void WriteBehindSession::run_flusher() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        cv_.wait(lock, [this]() { return stopping_ || !tail_.empty(); });
+        // The size trigger is ignored after a failure so retries are paced by max_delay
+        cv_.wait_until(lock, oldest_buffered_at_ + options_.max_delay, [this]() {
+            return stopping_ || (!last_flush_failed_ && tail_.size() >= options_.max_buffered_items);
+        });
+        if (stopping_) {
+            break;  // the destructor does the final flush
+        }
+        if (tail_.empty()) {
+            continue;
+        }
+        
+        lock.unlock();
+        try {
+            flush();
+        } catch (const std::exception& e) {
+            auto logger = get_logger("WriteBehindSession");
+            logger->warning("Flush failed for session " + session_id_ + ": " + e.what());
+        }
+        lock.lock();
     }
 }
 
-void SQLiteSession::vacuum() {
-    auto conn = get_connection();
-    conn->execute("VACUUM");
-}
+// Tracks when each managed session was last used, in timer wheels sharded
+// like the manager, and drops sessions from the manager once they have
+// been idle for the configured timeout
+class SessionSweeper {
+private:
+    using Clock = std::chrono::steady_clock;
+    
+    struct alignas(64) Shard {
+        std::mutex mutex;
+        TimerWheel wheel;
+    };
+    
+    SessionManager& manager_;
+    IdleExpiryOptions options_;
+    TimerWheel::Tick timeout_ticks_;
+    Clock::time_point started_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    
+    std::atomic<uint64_t> expired_{0};
+    std::atomic<uint64_t> persist_failures_{0};
+    
+    std::mutex stop_mutex_;
+    std::condition_variable stop_cv_;
+    bool stopping_ = false;
+    std::thread thread_;
 
-void SQLiteSession::analyze() {
-    auto conn = get_connection();
-    conn->execute("ANALYZE");
-}
+public:
+    SessionSweeper(SessionManager& manager, const IdleExpiryOptions& options, size_t shard_count)
+        : manager_(manager),
+          options_(options),
+          started_(Clock::now()) {
+        if (options_.resolution.count() <= 0) {
+            options_.resolution = std::chrono::milliseconds(1);
+        }
+        // Round up so sessions never expire early
+        timeout_ticks_ = std::max<TimerWheel::Tick>(
+            (options_.idle_timeout.count() + options_.resolution.count() - 1) / options_.resolution.count(), 1);
+        
+        shards_.reserve(shard_count);
+        for (size_t i = 0; i < shard_count; i++) {
+            shards_.push_back(std::make_unique<Shard>());
+        }
+    }
+    
+    ~SessionSweeper() {
+        stop();
+    }
+    
+    void start() {
+        thread_ = std::thread([this]() { run(); });
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(stop_mutex_);
+            stopping_ = true;
+        }
+        stop_cv_.notify_all();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    
+    void touch(const std::string& session_id) {
+        auto deadline = now_tick() + timeout_ticks_;
+        auto& shard = shard_for(session_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.wheel.schedule(session_id, deadline);
+    }
+    
+    void forget(const std::string& session_id) {
+        auto& shard = shard_for(session_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.wheel.cancel(session_id);
+    }
+    
+    void forget_all() {
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            shard->wheel.clear();
+        }
+    }
+    
+    bool is_tracked(const std::string& session_id) {
+        auto& shard = shard_for(session_id);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return shard.wheel.contains(session_id);
+    }
+    
+    IdleExpiryStats get_stats() {
+        IdleExpiryStats stats;
+        for (auto& shard : shards_) {
+            std::lock_guard<std::mutex> lock(shard->mutex);
+            stats.tracked_sessions += shard->wheel.size();
+        }
+        stats.expired_sessions = expired_.load(std::memory_order_relaxed);
+        stats.persist_failures = persist_failures_.load(std::memory_order_relaxed);
+        return stats;
+    }
 
-std::map<std::string, std::any> SQLiteSession::get_db_stats() const {
-    auto conn = get_connection();
-    std::map<std::string, std::any> stats;
+private:
+    TimerWheel::Tick now_tick() const {
+        return static_cast<TimerWheel::Tick>((Clock::now() - started_) / options_.resolution);
+    }
     
-    try {
-        auto results = conn->query("SELECT COUNT(*) FROM " + sessions_table_);
-        if (!results.empty() && !results[0].empty()) {
-            stats["total_sessions"] = std::stoi(results[0][0]);
+    Shard& shard_for(const std::string& session_id) {
+        return *shards_[std::hash<std::string>{}(session_id) % shards_.size()];
+    }
+    
+    void run() {
+        std::vector<std::string> expired;
+        std::unique_lock<std::mutex> lock(stop_mutex_);
+        while (!stopping_) {
+            stop_cv_.wait_for(lock, options_.resolution, [this]() { return stopping_; });
+            if (stopping_) break;
+            
+            lock.unlock();
+            expired.clear();
+            auto now = now_tick();
+            for (auto& shard : shards_) {
+                std::lock_guard<std::mutex> shard_lock(shard->mutex);
+                shard->wheel.advance(now, expired);
+            }
+            for (const auto& session_id : expired) {
+                expire(session_id);
+            }
+            lock.lock();
         }
-        
-        results = conn->query("SELECT COUNT(*) FROM " + messages_table_);
-        if (!results.empty() && !results[0].empty()) {
-            stats["total_messages"] = std::stoi(results[0][0]);
+    }
+    
+    void expire(const std::string& session_id) {
+        auto session = manager_.find_session(session_id);
+        // Gone already, or used again since its deadline passed
+        if (!session || is_tracked(session_id)) {
+            return;
         }
         
-        stats["db_path"] = db_path_;
-        stats["is_memory_db"] = is_memory_db_;
+        try {
+            if (auto write_behind = std::dynamic_pointer_cast<WriteBehindSession>(session)) {
+                write_behind->flush();
+            }
+            if (options_.persist) {
+                options_.persist(session);
+            }
+        } catch (const std::exception& e) {
+            persist_failures_.fetch_add(1, std::memory_order_relaxed);
+            auto logger = get_logger("SessionManager");
+            logger->warning("Keeping idle session " + session_id + ", persisting it failed: " + e.what());
+            touch(session_id);
+            return;
+        }
         
-    } catch (const std::exception& e) {
-        stats["error"] = std::string(e.what());
+        if (!manager_.remove_if_idle(session_id, session)) {
+            return;
+        }
+        // Subclass caches record access outside the manager's shard locks;
+        // if one handed the session out meanwhile, put it back
+        if (is_tracked(session_id)) {
+            manager_.restore_session(session_id, session);
+            return;
+        }
+        manager_.on_session_expired(session_id);
+        expired_.fetch_add(1, std::memory_order_relaxed);
     }
+};
+
+// SessionManager implementation
+SessionManager::SessionManager(
+    const std::string& default_db_path,
+    const std::string& default_sessions_table,
+    const std::string& default_messages_table,
+    size_t shard_count
+) : default_db_path_(default_db_path),
+    default_sessions_table_(default_sessions_table),
+    default_messages_table_(default_messages_table) {
     
-    return stats;
+    shards_.reserve(std::max<size_t>(shard_count, 1));
+    for (size_t i = 0; i < std::max<size_t>(shard_count, 1); i++) {
+        shards_.push_back(std::make_unique<SessionShard>());
+    }
 }
 
-// MemorySession implementation
-MemorySession::MemorySession(const std::string& session_id) : SessionBase(session_id) {
+SessionManager::~SessionManager() {
+    disable_idle_expiry();
+    wait_for_pending_operations();
 }
 
-std::future<std::vector<std::shared_ptr<Item>>> MemorySession::get_items(std::optional<size_t> limit) {
-    return std::async(std::launch::async, [this, limit]() {
-        return get_items_internal(limit);
-    });
+void SessionManager::wait_for_pending_operations() {
+    std::unique_lock<std::mutex> lock(pending_mutex_);
+    pending_cv_.wait(lock, [this]() { return pending_operations_ == 0; });
 }
 
-std::vector<std::shared_ptr<Item>> MemorySession::get_items_internal(std::optional<size_t> limit) {
-    std::shared_lock<std::shared_mutex> lock(items_mutex_);
+void SessionManager::enable_idle_expiry(const IdleExpiryOptions& options) {
+    disable_idle_expiry();
     
-    if (!limit.has_value()) {
-        return items_;
+    auto sweeper = std::make_shared<SessionSweeper>(*this, options, std::min<size_t>(shards_.size(), 16));
+    for (const auto& shard : shards_) {
+        auto lock = lock_shared(*shard);
+        for (const auto& [id, session] : shard->sessions) {
+            sweeper->touch(id);
+        }
     }
-    
-    size_t start_idx = items_.size() > limit.value() ? items_.size() - limit.value() : 0;
-    return std::vector<std::shared_ptr<Item>>(items_.begin() + start_idx, items_.end());
-}
-
-std::future<void> MemorySession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
-    return std::async(std::launch::async, [this, items]() {
-        add_items_internal(items);
-    });
+    sweeper_ = std::move(sweeper);
+    sweeper_->start();
 }
 
-void MemorySession::add_items_internal(const std::vector<std::shared_ptr<Item>>& items) {
-    std::unique_lock<std::shared_mutex> lock(items_mutex_);
-    items_.insert(items_.end(), items.begin(), items.end());
-    update_timestamp();
+void SessionManager::disable_idle_expiry() {
+    if (sweeper_) {
+        sweeper_->stop();
+        sweeper_.reset();
+    }
 }
 
-std::future<std::shared_ptr<Item>> MemorySession::pop_item() {
-    return std::async(std::launch::async, [this]() {
-        return pop_item_internal();
-    });
+IdleExpiryStats SessionManager::get_idle_expiry_stats() const {
+    return sweeper_ ? sweeper_->get_stats() : IdleExpiryStats{};
 }
 
-std::shared_ptr<Item> MemorySession::pop_item_internal() {
-    std::unique_lock<std::shared_mutex> lock(items_mutex_);
-    
-    if (items_.empty()) {
-        return nullptr;
+void SessionManager::record_access(const std::string& session_id) const {
+    if (sweeper_) {
+        sweeper_->touch(session_id);
     }
-    
-    auto item = items_.back();
-    items_.pop_back();
-    update_timestamp();
-    return item;
 }
 
-std::future<void> MemorySession::clear_session() {
-    return std::async(std::launch::async, [this]() {
-        clear_session_internal();
-    });
-}
-
-void MemorySession::clear_session_internal() {
-    std::unique_lock<std::shared_mutex> lock(items_mutex_);
-    items_.clear();
-    update_timestamp();
+SessionManager::SessionShard& SessionManager::shard_for(const std::string& session_id) const {
+    return *shards_[std::hash<std::string>{}(session_id) % shards_.size()];
 }
 
-size_t MemorySession::get_item_count() const {
-    std::shared_lock<std::shared_mutex> lock(items_mutex_);
-    return items_.size();
+std::shared_lock<std::shared_mutex> SessionManager::lock_shared(const SessionShard& shard) {
+    shard.lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        shard.contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
 }
 
-void MemorySession::reserve_capacity(size_t capacity) {
-    std::unique_lock<std::shared_mutex> lock(items_mutex_);
-    items_.reserve(capacity);
+std::unique_lock<std::shared_mutex> SessionManager::lock_unique(const SessionShard& shard) {
+    shard.lock_acquisitions.fetch_add(1, std::memory_order_relaxed);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        shard.contended_acquisitions.fetch_add(1, std::memory_order_relaxed);
+        lock.lock();
+    }
+    return lock;
 }
 
-size_t MemorySession::get_capacity() const {
-    std::shared_lock<std::shared_mutex> lock(items_mutex_);
-    return items_.capacity();
+std::shared_ptr<SQLiteSession> SessionManager::make_sqlite_session(
+    const std::string& session_id,
+    const std::string& db_path
+) const {
+    auto session = std::make_shared<SQLiteSession>(
+        session_id, db_path, default_sessions_table_, default_messages_table_,
+        default_group_commit_
+    );
+    if (default_search_index_) {
+        session->enable_search_index();
+    }
+    return session;
 }
 
-// SessionManager implementation
-SessionManager::SessionManager(
-    const std::string& default_db_path,
-    const std::string& default_sessions_table,
-    const std::string& default_messages_table
-) : default_db_path_(default_db_path),
-    default_sessions_table_(default_sessions_table),
-    default_messages_table_(default_messages_table) {
+std::shared_ptr<Session> SessionManager::find_session(const std::string& session_id) const {
+    auto& shard = shard_for(session_id);
+    auto lock = lock_shared(shard);
+    auto it = shard.sessions.find(session_id);
+    return it != shard.sessions.end() ? it->second : nullptr;
 }
 
 std::shared_ptr<Session> SessionManager::get_session(const std::string& session_id) {
-    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
-    auto it = sessions_.find(session_id);
-    return it != sessions_.end() ? it->second : nullptr;
+    // Access is recorded under the shard lock so the sweeper cannot drop
+    // the session between the lookup and the touch
+    auto& shard = shard_for(session_id);
+    auto lock = lock_shared(shard);
+    auto it = shard.sessions.find(session_id);
+    if (it == shard.sessions.end()) {
+        return nullptr;
+    }
+    record_access(session_id);
+    return it->second;
 }
 
 std::shared_ptr<Session> SessionManager::create_session(const std::string& session_id) {
-    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    auto session = make_sqlite_session(session_id, default_db_path_);
     
-    auto session = std::make_shared<SQLiteSession>(
-        session_id, default_db_path_, default_sessions_table_, default_messages_table_
-    );
-    sessions_[session_id] = session;
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    shard.sessions[session_id] = session;
+    record_access(session_id);
     return session;
 }
 
 std::shared_ptr<Session> SessionManager::get_or_create_session(const std::string& session_id) {
     auto session = get_session(session_id);
-    return session ? session : create_session(session_id);
+    if (session) {
+        return session;
+    }
+    
+    // Open the database outside the shard lock, so lookups of other ids in
+    // the shard do not wait on disk I/O. If a concurrent caller inserted
+    // first, adopt its session and drop ours.
+    auto created = make_sqlite_session(session_id, default_db_path_);
+    
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    auto it = shard.sessions.try_emplace(session_id, std::move(created)).first;
+    record_access(session_id);
+    return it->second;
 }
 
 std::shared_ptr<SQLiteSession> SessionManager::create_sqlite_session(
     const std::string& session_id,
     const std::string& db_path
 ) {
-    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
+    auto session = make_sqlite_session(session_id, db_path.empty() ? default_db_path_ : db_path);
     
-    std::string actual_db_path = db_path.empty() ? default_db_path_ : db_path;
-    auto session = std::make_shared<SQLiteSession>(
-        session_id, actual_db_path, default_sessions_table_, default_messages_table_
-    );
-    sessions_[session_id] = session;
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    shard.sessions[session_id] = session;
+    record_access(session_id);
     return session;
 }
 
 std::shared_ptr<MemorySession> SessionManager::create_memory_session(const std::string& session_id) {
-    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
-    
     auto session = std::make_shared<MemorySession>(session_id);
-    sessions_[session_id] = session;
+    
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    shard.sessions[session_id] = session;
+    record_access(session_id);
     return session;
 }
 
 bool SessionManager::has_session(const std::string& session_id) const {
-    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
-    return sessions_.find(session_id) != sessions_.end();
+    auto& shard = shard_for(session_id);
+    auto lock = lock_shared(shard);
+    return shard.sessions.find(session_id) != shard.sessions.end();
 }
 
 void SessionManager::remove_session(const std::string& session_id) {
-    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
-    sessions_.erase(session_id);
+    {
+        auto& shard = shard_for(session_id);
+        auto lock = lock_unique(shard);
+        shard.sessions.erase(session_id);
+    }
+    if (sweeper_) {
+        sweeper_->forget(session_id);
+    }
+}
+
+bool SessionManager::remove_if_idle(const std::string& session_id, const std::shared_ptr<Session>& session) {
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    auto it = shard.sessions.find(session_id);
+    if (it == shard.sessions.end() || it->second != session || sweeper_->is_tracked(session_id)) {
+        return false;
+    }
+    shard.sessions.erase(it);
+    return true;
+}
+
+void SessionManager::restore_session(const std::string& session_id, const std::shared_ptr<Session>& session) {
+    auto& shard = shard_for(session_id);
+    auto lock = lock_unique(shard);
+    shard.sessions.try_emplace(session_id, session);
+}
+
+void SessionManager::on_session_expired(const std::string& /*session_id*/) {
 }
 
 void SessionManager::clear_all_sessions() {
-    std::unique_lock<std::shared_mutex> lock(sessions_mutex_);
-    sessions_.clear();
+    for (auto& shard : shards_) {
+        auto lock = lock_unique(*shard);
+        shard->sessions.clear();
+    }
+    if (sweeper_) {
+        sweeper_->forget_all();
+    }
 }
 
 std::vector<std::string> SessionManager::list_session_ids() const {
-    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
     std::vector<std::string> ids;
-    ids.reserve(sessions_.size());
-    for (const auto& [id, session] : sessions_) {
-        ids.push_back(id);
+    for (const auto& shard : shards_) {
+        auto lock = lock_shared(*shard);
+        for (const auto& [id, session] : shard->sessions) {
+            ids.push_back(id);
+        }
     }
+    std::sort(ids.begin(), ids.end());
     return ids;
 }
 
 size_t SessionManager::get_session_count() const {
-    std::shared_lock<std::shared_mutex> lock(sessions_mutex_);
-    return sessions_.size();
+    size_t count = 0;
+    for (const auto& shard : shards_) {
+        auto lock = lock_shared(*shard);
+        count += shard->sessions.size();
+    }
+    return count;
+}
+
+std::vector<SessionManager::ShardStats> SessionManager::get_shard_stats() const {
+    std::vector<ShardStats> stats;
+    stats.reserve(shards_.size());
+    for (const auto& shard : shards_) {
+        size_t session_count;
+        {
+            std::shared_lock<std::shared_mutex> lock(shard->mutex);
+            session_count = shard->sessions.size();
+        }
+        stats.push_back({
+            session_count,
+            shard->lock_acquisitions.load(std::memory_order_relaxed),
+            shard->contended_acquisitions.load(std::memory_order_relaxed)
+        });
+    }
+    return stats;
+}
+
+std::future<void> SessionManager::clear_all_sessions_async() {
+    return submit_tracked([this]() {
+        clear_all_sessions();
+    });
+}
+
+std::future<std::map<std::string, size_t>> SessionManager::get_all_session_stats() {
+    return submit_tracked([this]() {
+        std::map<std::string, size_t> stats;
+        for_each_session_summary([&stats](const SessionSummary& summary) {
+            stats[summary.session_id] = summary.item_count;
+            return true;
+        });
+        return stats;
+    });
+}
+
+void SessionManager::for_each_session_summary(const SessionSummaryVisitor& visitor) const {
+    // File-backed SQLite sessions are grouped by database and tables;
+    // in-memory databases are private to their session
+    struct SQLiteGroup {
+        std::shared_ptr<SQLiteSession> representative;
+        std::unordered_set<std::string> session_ids;
+    };
+    std::map<std::tuple<std::string, std::string, std::string>, SQLiteGroup> groups;
+    
+    // Other sessions are visited shard by shard, outside the shard lock
+    std::vector<std::shared_ptr<Session>> others;
+    for (const auto& shard : shards_) {
+        others.clear();
+        {
+            auto lock = lock_shared(*shard);
+            for (const auto& [id, session] : shard->sessions) {
+                auto sqlite = std::dynamic_pointer_cast<SQLiteSession>(session);
+                if (sqlite && !sqlite->is_memory_db()) {
+                    auto& group = groups[{sqlite->get_db_path(), sqlite->get_sessions_table(), sqlite->get_messages_table()}];
+                    if (!group.representative) {
+                        group.representative = sqlite;
+                    }
+                    group.session_ids.insert(id);
+                } else {
+                    others.push_back(session);
+                }
+            }
+        }
+        for (const auto& session : others) {
+            if (!visitor(session->get_summary())) {
+                return;
+            }
+        }
+    }
+    
+    for (auto& [key, group] : groups) {
+        // The aggregate covers every session in the tables; report only ours
+        bool completed = group.representative->summarize_all([&group, &visitor](const SessionSummary& summary) {
+            if (group.session_ids.erase(summary.session_id) == 0) {
+                return true;
+            }
+            return visitor(summary);
+        });
+        if (!completed) {
+            return;
+        }
+        
+        // Sessions without items have no rows to aggregate
+        for (const auto& session_id : group.session_ids) {
+            SessionSummary summary;
+            summary.session_id = session_id;
+            if (!visitor(summary)) {
+                return;
+            }
+        }
+    }
+}
+
+std::vector<SearchResult> SessionManager::search(const std::string& query, size_t limit) const {
+    // A file and table pair is searched once, whichever sessions use it;
+    // in-memory databases are private to their session
+    std::set<std::tuple<std::string, std::string, std::string>> databases;
+    std::vector<std::shared_ptr<SQLiteSession>> private_sessions;
+    if (default_db_path_ != ":memory:") {
+        databases.emplace(default_db_path_, default_sessions_table_, default_messages_table_);
+    }
+    for (const auto& shard : shards_) {
+        auto lock = lock_shared(*shard);
+        for (const auto& [id, session] : shard->sessions) {
+            auto sqlite = std::dynamic_pointer_cast<SQLiteSession>(session);
+            if (!sqlite) continue;
+            if (sqlite->is_memory_db()) {
+                private_sessions.push_back(sqlite);
+            } else {
+                databases.emplace(sqlite->get_db_path(), sqlite->get_sessions_table(), sqlite->get_messages_table());
+            }
+        }
+    }
+    
+    std::vector<SearchResult> results;
+    auto merge = [&results](std::vector<SearchResult> found) {
+        results.insert(results.end(), std::make_move_iterator(found.begin()), std::make_move_iterator(found.end()));
+    };
+    for (const auto& [db_path, sessions_table, messages_table] : databases) {
+        merge(SQLiteSession::search_database(db_path, sessions_table, messages_table, query, limit));
+    }
+    for (const auto& session : private_sessions) {
+        merge(session->search(query, limit));
+    }
+    
+    // Each source returned its best `limit`; keep the best overall
+    if (results.size() > limit) {
+        std::partial_sort(results.begin(), results.begin() + limit, results.end(),
+                          [](const SearchResult& a, const SearchResult& b) { return a.score < b.score; });
+        results.resize(limit);
+    } else {
+        std::sort(results.begin(), results.end(),
+                  [](const SearchResult& a, const SearchResult& b) { return a.score < b.score; });
+    }
+    return results;
 }
 
 void SessionManager::set_default_tables(const std::string& sessions_table, const std::string& messages_table) {
@@ -630,15 +2955,35 @@ std::shared_ptr<Session> SessionFactory::create_sqlite_session(
     const std::string& session_id,
     const std::string& db_path,
     const std::string& sessions_table,
-    const std::string& messages_table
+    const std::string& messages_table,
+    const GroupCommitOptions& group_commit
 ) {
-    return std::make_shared<SQLiteSession>(session_id, db_path, sessions_table, messages_table);
+    return std::make_shared<SQLiteSession>(session_id, db_path, sessions_table, messages_table, group_commit);
 }
 
 std::shared_ptr<Session> SessionFactory::create_memory_session(const std::string& session_id) {
     return std::make_shared<MemorySession>(session_id);
 }
 
+std::shared_ptr<Session> SessionFactory::create_ring_memory_session(const std::string& session_id, size_t capacity) {
+    return std::make_shared<RingMemorySession>(session_id, capacity);
+}
+
+std::shared_ptr<Session> SessionFactory::create_log_session(
+    const std::string& session_id,
+    const std::string& log_dir,
+    bool sync_writes
+) {
+    return std::make_shared<LogSession>(session_id, log_dir, sync_writes);
+}
+
+std::shared_ptr<Session> SessionFactory::create_write_behind_session(
+    std::shared_ptr<Session> backing,
+    const WriteBehindOptions& options
+) {
+    return std::make_shared<WriteBehindSession>(std::move(backing), options);
+}
+
 std::shared_ptr<Session> SessionFactory::create_default_session(const std::string& session_id) {
     return create_sqlite_session(session_id);
 }
@@ -651,6 +2996,14 @@ std::shared_ptr<Session> SessionFactory::create_session(
     switch (type) {
     case SessionType::Memory:
         return create_memory_session(session_id);
+    case SessionType::RingMemory:
+        {
+            size_t capacity = 1024;
+            auto capacity_it = options.find("capacity");
+            if (capacity_it != options.end()) capacity = std::stoul(capacity_it->second);
+            
+            return create_ring_memory_session(session_id, capacity);
+        }
     case SessionType::SQLite:
         {
             std::string db_path = ":memory:";
@@ -666,7 +3019,36 @@ std::shared_ptr<Session> SessionFactory::create_session(
             auto messages_it = options.find("messages_table");
             if (messages_it != options.end()) messages_table = messages_it->second;
             
-            return create_sqlite_session(session_id, db_path, sessions_table, messages_table);
+            GroupCommitOptions group_commit;
+            auto group_it = options.find("group_commit");
+            if (group_it != options.end()) group_commit.enabled = group_it->second == "true";
+            
+            auto delay_it = options.find("group_commit_delay_ms");
+            if (delay_it != options.end()) group_commit.max_delay = std::chrono::milliseconds(std::stol(delay_it->second));
+            
+            auto rows_it = options.find("group_commit_max_rows");
+            if (rows_it != options.end()) group_commit.max_rows = std::stoul(rows_it->second);
+            
+            auto session = create_sqlite_session(session_id, db_path, sessions_table, messages_table, group_commit);
+            
+            auto search_it = options.find("search_index");
+            if (search_it != options.end() && search_it->second == "true") {
+                std::static_pointer_cast<SQLiteSession>(session)->enable_search_index();
+            }
+            return session;
+        }
+    case SessionType::Log:
+        {
+            std::string log_dir = ".";
+            bool sync_writes = false;
+            
+            auto dir_it = options.find("log_dir");
+            if (dir_it != options.end()) log_dir = dir_it->second;
+            
+            auto sync_it = options.find("sync_writes");
+            if (sync_it != options.end()) sync_writes = sync_it->second == "true";
+            
+            return create_log_session(session_id, log_dir, sync_writes);
         }
     case SessionType::Auto:
     default:
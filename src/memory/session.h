@@ -4,24 +4,74 @@
  * Memory and session management for conversation history
  */
 
+#include "executor.h"
 #include "../items.h"
 #include <string>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <optional>
 #include <future>
 #include <map>
+#include <unordered_map>
 #include <any>
 #include <mutex>
 #include <shared_mutex>
+#include <condition_variable>
+#include <thread>
 #include <chrono>
+#include <atomic>
+#include <algorithm>
+#include <cstdint>
 #include <fstream>
 
 namespace openai_agents {
 namespace memory {
 
-// Forward declarations
-class Item;
+// Token cost of an item. Sessions that support budgeted reads store the
+// count with each item when it is written.
+using TokenCounter = std::function<size_t(const Item&)>;
+
+// Default counter: roughly four bytes of text per token plus a fixed
+// per-item overhead
+size_t estimate_item_tokens(const Item& item);
+
+// Counter used for items written from now on
+void set_token_counter(TokenCounter counter);
+size_t count_item_tokens(const Item& item);
+
+// Searchable text of an item: message and tool response content, tool
+// name and arguments, or file name
+std::string item_text(const Item& item);
+
+// One page of a keyset scan over a session's items
+struct ItemPage {
+    std::vector<std::shared_ptr<Item>> items;
+    // Cursor for the next page; unset once the scan is exhausted
+    std::optional<int64_t> next_cursor;
+};
+
+// Aggregate statistics for one session, gathered without loading its items
+struct SessionSummary {
+    std::string session_id;
+    size_t item_count = 0;
+    uint64_t total_tokens = 0;
+    // Stored size of the items; zero for backends that hold item objects
+    uint64_t total_bytes = 0;
+    std::optional<std::chrono::system_clock::time_point> first_item_at;
+    std::optional<std::chrono::system_clock::time_point> last_item_at;
+};
+
+// Receives summaries one at a time; returning false stops the stream
+using SessionSummaryVisitor = std::function<bool(const SessionSummary&)>;
+
+// One full-text search hit. The snippet marks matched terms with [ ].
+struct SearchResult {
+    std::string session_id;
+    int64_t item_id = 0;  // message row id, usable as a scan cursor
+    std::string snippet;
+    double score = 0;     // bm25 rank; lower is a better match
+};
 
 // Session interface for conversation history management
 class Session {
@@ -44,6 +94,27 @@ public:
     
     virtual std::future<void> clear_session() = 0;
     
+    // Keyset pagination with opaque cursors. scan returns up to batch_size
+    // items after the cursor, oldest first; scan_reverse returns items before
+    // it, newest first. The default implementation pages over get_items().
+    virtual std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    );
+    
+    virtual std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    );
+    
+    // Newest items whose token counts sum to at most max_tokens, oldest
+    // first. The default implementation counts over get_items().
+    virtual std::future<std::vector<std::shared_ptr<Item>>> get_items_within_budget(size_t max_tokens);
+    
+    // Up to limit items most relevant to query, oldest first. Sessions
+    // without a relevance index return the newest items.
+    virtual std::future<std::vector<std::shared_ptr<Item>>> get_relevant_items(const std::string& query, size_t limit);
+    
     // Synchronous convenience methods
     std::vector<std::shared_ptr<Item>> get_items_sync(
         std::optional<size_t> limit = std::nullopt
@@ -52,6 +123,10 @@ public:
     void add_items_sync(const std::vector<std::shared_ptr<Item>>& items);
     std::shared_ptr<Item> pop_item_sync();
     void clear_session_sync();
+    ItemPage scan_sync(std::optional<int64_t> after_id = std::nullopt, size_t batch_size = 100);
+    ItemPage scan_reverse_sync(std::optional<int64_t> before_id = std::nullopt, size_t batch_size = 100);
+    std::vector<std::shared_ptr<Item>> get_items_within_budget_sync(size_t max_tokens);
+    std::vector<std::shared_ptr<Item>> get_relevant_items_sync(const std::string& query, size_t limit);
     
     // Session metadata
     virtual std::map<std::string, std::any> get_metadata() const = 0;
@@ -62,18 +137,67 @@ public:
     virtual size_t get_item_count() const = 0;
     virtual std::chrono::system_clock::time_point get_created_at() const = 0;
     virtual std::chrono::system_clock::time_point get_updated_at() const = 0;
+    
+    // Counters only; the default uses the session timestamps for the item range
+    virtual SessionSummary get_summary() const;
+
+protected:
+    // Page over count items whose cursors are first_cursor, first_cursor + 1, ...;
+    // item_at(i) returns the i-th of them
+    template<typename ItemAt>
+    static ItemPage page_by_position(
+        int64_t first_cursor,
+        size_t count,
+        std::optional<int64_t> cursor,
+        size_t batch_size,
+        bool reverse,
+        ItemAt&& item_at
+    ) {
+        ItemPage page;
+        if (!reverse) {
+            size_t start = 0;
+            if (cursor && *cursor >= first_cursor) {
+                start = static_cast<size_t>(std::min<int64_t>(*cursor - first_cursor + 1, count));
+            }
+            size_t end = start + std::min(batch_size, count - start);
+            page.items.reserve(end - start);
+            for (size_t i = start; i < end; i++) {
+                page.items.push_back(item_at(i));
+            }
+            if (end < count) {
+                page.next_cursor = first_cursor + static_cast<int64_t>(end) - 1;
+            }
+        } else {
+            size_t end = count;
+            if (cursor) {
+                end = static_cast<size_t>(std::clamp<int64_t>(*cursor - first_cursor, 0, count));
+            }
+            size_t start = end - std::min(batch_size, end);
+            page.items.reserve(end - start);
+            for (size_t i = end; i > start; i--) {
+                page.items.push_back(item_at(i - 1));
+            }
+            if (start > 0) {
+                page.next_cursor = first_cursor + static_cast<int64_t>(start);
+            }
+        }
+        return page;
+    }
 };
 
 // Abstract base class for session implementations
-class SessionBase : public Session {
+class SessionBase : public Session, public std::enable_shared_from_this<SessionBase> {
 protected:
     std::string session_id_;
     std::map<std::string, std::any> metadata_;
     std::chrono::system_clock::time_point created_at_;
     std::chrono::system_clock::time_point updated_at_;
+    
+    // Runs the async Session methods
+    std::shared_ptr<SessionExecutor> executor_;
 
 public:
-    SessionBase(const std::string& session_id);
+    SessionBase(const std::string& session_id, std::shared_ptr<SessionExecutor> executor = nullptr);
     
     // Session interface implementation
     const std::string& get_session_id() const override { return session_id_; }
@@ -84,9 +208,52 @@ public:
     
     std::chrono::system_clock::time_point get_created_at() const override { return created_at_; }
     std::chrono::system_clock::time_point get_updated_at() const override { return updated_at_; }
+    
+    // Executor for async operations; null restores the shared I/O pool
+    void set_executor(std::shared_ptr<SessionExecutor> executor);
+    const std::shared_ptr<SessionExecutor>& get_executor() const { return executor_; }
+    
+    // Points this object at another session id, keeping connections and
+    // buffers, so pools can reuse it. Metadata and timestamps start over.
+    // Returns false if the backend cannot switch ids in place. The session
+    // must have no operations in flight.
+    virtual bool rebind(const std::string& /*session_id*/) { return false; }
 
 protected:
     void update_timestamp();
+    void reset_identity(const std::string& session_id);
+    
+    // Runs func on the executor. When the session is owned by a shared_ptr
+    // the task holds a reference to it until func returns, so callers may
+    // drop both the future and the session while the task is queued.
+    template<typename F>
+    auto submit(F&& func) -> std::future<std::invoke_result_t<F>> {
+        return executor_->submit([self = weak_from_this().lock(), func = std::forward<F>(func)]() mutable {
+            auto keep_alive = std::move(self);
+            return func();
+        });
+    }
+};
+
+// Group commit configuration for file-backed SQLite sessions. When enabled,
+// add_items calls from all sessions sharing a database file and these
+// options are coalesced into one fsync'd transaction, flushed after
+// max_delay or max_rows. Each session's writes succeed or fail on their own.
+struct GroupCommitOptions {
+    bool enabled = false;
+    std::chrono::milliseconds max_delay{5};
+    size_t max_rows = 512;
+};
+
+// Connection pool metrics for one database file
+struct ConnectionPoolStats {
+    size_t reader_connections = 0;
+    size_t max_readers = 0;
+    uint64_t reader_checkouts = 0;
+    uint64_t writer_checkouts = 0;
+    std::chrono::nanoseconds reader_wait_time{0};
+    std::chrono::nanoseconds writer_wait_time{0};
+    std::chrono::nanoseconds max_wait_time{0};
 };
 
 // SQLite-based session implementation
@@ -96,20 +263,24 @@ private:
     std::string sessions_table_;
     std::string messages_table_;
     bool is_memory_db_;
+    GroupCommitOptions group_commit_options_;
+    
+    // SQL text prebuilt once per table pair
+    std::shared_ptr<const struct SQLiteStatements> statements_;
     
-    // Database connection management
-    mutable std::mutex connection_mutex_;
-    mutable std::shared_ptr<class SQLiteConnection> shared_connection_;
+    // Shared writer for group commit (null when disabled)
+    std::shared_ptr<class SQLiteGroupCommitter> group_committer_;
     
-    // Thread-local storage for file-based databases
-    thread_local static std::shared_ptr<class SQLiteConnection> thread_connection_;
+    // Writer and reader connections, shared by all sessions on the same file
+    std::shared_ptr<class SQLiteConnectionPool> pool_;
 
 public:
     SQLiteSession(
         const std::string& session_id,
         const std::string& db_path = ":memory:",
         const std::string& sessions_table = "agent_sessions",
-        const std::string& messages_table = "agent_messages"
+        const std::string& messages_table = "agent_messages",
+        const GroupCommitOptions& group_commit = {}
     );
     
     ~SQLiteSession();
@@ -127,35 +298,95 @@ public:
     std::future<void> clear_session() override;
     
     size_t get_item_count() const override;
+    SessionSummary get_summary() const override;
+    
+    // Keeps the connection pool and prepared statements; an in-memory
+    // database drops the previous session's rows, since nothing else can
+    // reach them
+    bool rebind(const std::string& session_id) override;
+    
+    // Cursors are message row ids
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    // One bounded query using the per-item running token totals
+    std::future<std::vector<std::shared_ptr<Item>>> get_items_within_budget(size_t max_tokens) override;
     
     // SQLite-specific methods
     void close();
     std::string get_db_path() const { return db_path_; }
     std::string get_sessions_table() const { return sessions_table_; }
     std::string get_messages_table() const { return messages_table_; }
+    bool is_memory_db() const { return is_memory_db_; }
+    
+    // Streams a summary of every session stored in this session's tables,
+    // from a grouped aggregate read a page at a time. Returns false if the
+    // visitor stopped early. The visitor runs with no connection checked
+    // out, so it may use sessions on the same database.
+    bool summarize_all(const SessionSummaryVisitor& visitor) const;
+    const GroupCommitOptions& get_group_commit_options() const { return group_commit_options_; }
+    
+    // Full-text search over item text, using an FTS5 index shared by every
+    // session on the same tables. enable_search_index() creates it and
+    // indexes stored rows; from then on inserts, pops and clears keep it
+    // current. Queries use FTS5 syntax, and searches return nothing until
+    // the index exists. Whether it exists is cached per database file and
+    // forgotten if SQLite later reports the table missing.
+    void enable_search_index();
+    bool has_search_index() const;
+    std::vector<SearchResult> search(const std::string& query, size_t limit = 20) const;
+    std::vector<SearchResult> search_all(const std::string& query, size_t limit = 20) const;
+    static std::vector<SearchResult> search_database(
+        const std::string& db_path,
+        const std::string& sessions_table,
+        const std::string& messages_table,
+        const std::string& query,
+        size_t limit = 20
+    );
     
     // Database maintenance
     void vacuum();
     void analyze();
     std::map<std::string, std::any> get_db_stats() const;
+    
+    // Connection pool; the reader limit applies to pools opened afterwards
+    ConnectionPoolStats get_pool_stats() const;
+    
+    // Opens up to reader_count reader connections and prepares the
+    // session statements on them and on the writer, so first requests
+    // skip that setup
+    void warm_up(size_t reader_count = 1);
+    static void set_default_max_readers(size_t max_readers);
 
 private:
-    std::shared_ptr<class SQLiteConnection> get_connection() const;
+    std::shared_ptr<class SQLiteConnection> get_reader() const;
+    std::shared_ptr<class SQLiteConnection> get_writer() const;
     void init_database();
     void init_db_for_connection(std::shared_ptr<class SQLiteConnection> conn);
     
     // Internal synchronous operations
     std::vector<std::shared_ptr<Item>> get_items_internal(std::optional<size_t> limit);
     void add_items_internal(const std::vector<std::shared_ptr<Item>>& items);
+    std::future<void> submit_group_commit(const std::vector<std::shared_ptr<Item>>& items);
     std::shared_ptr<Item> pop_item_internal();
     void clear_session_internal();
     size_t get_item_count_internal() const;
+    ItemPage scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse);
+    std::vector<std::shared_ptr<Item>> get_items_within_budget_internal(size_t max_tokens);
 };
 
 // In-memory session implementation
 class MemorySession : public SessionBase {
 private:
     std::vector<std::shared_ptr<Item>> items_;
+    std::vector<uint64_t> token_totals_{0};  // token_totals_[i] = tokens in the first i items
     mutable std::shared_mutex items_mutex_;
 
 public:
@@ -174,6 +405,22 @@ public:
     std::future<void> clear_session() override;
     
     size_t get_item_count() const override;
+    bool rebind(const std::string& session_id) override;
+    SessionSummary get_summary() const override;
+    
+    // Cursors are 1-based positions in the session
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    // Binary search over prefix sums of the item token counts
+    std::future<std::vector<std::shared_ptr<Item>>> get_items_within_budget(size_t max_tokens) override;
     
     // Memory-specific methods
     void reserve_capacity(size_t capacity);
@@ -185,28 +432,248 @@ private:
     void add_items_internal(const std::vector<std::shared_ptr<Item>>& items);
     std::shared_ptr<Item> pop_item_internal();
     void clear_session_internal();
+    ItemPage scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse);
+    std::vector<std::shared_ptr<Item>> get_items_within_budget_internal(size_t max_tokens);
+};
+
+// Fixed-capacity in-memory session backed by a circular buffer. Appends and
+// pops are O(1) and never reallocate; once full, each append evicts the
+// oldest item. Writers are serialized by a mutex. Readers never lock: they
+// copy the newest items out of immutable slot cells and validate the copy
+// against a sequence counter, retrying if a write overlapped. Cells a
+// writer replaces are recycled once no reader is active; if a capacity's
+// worth piles up under constant read traffic, the writer waits out the
+// active readers while new ones copy under the write lock instead.
+class RingMemorySession : public SessionBase {
+private:
+    struct Cell;
+    
+    std::unique_ptr<std::atomic<Cell*>[]> slots_;
+    size_t capacity_;
+    
+    // Items live at logical positions [begin_, end_); slot = position % capacity_
+    std::atomic<uint64_t> begin_{0};
+    std::atomic<uint64_t> end_{0};
+    std::atomic<uint64_t> sequence_{0};  // odd while a write is in progress
+    std::atomic<uint64_t> evicted_count_{0};
+    mutable std::atomic<uint32_t> active_readers_{0};
+    std::atomic<bool> reclaiming_{false};  // readers take the locked path while set
+    mutable std::mutex write_mutex_;
+    
+    // Owned by the writer: cells replaced while readers may hold them, and
+    // cells ready for reuse
+    std::vector<Cell*> retired_cells_;
+    std::vector<Cell*> free_cells_;
+
+public:
+    RingMemorySession(const std::string& session_id, size_t capacity);
+    ~RingMemorySession();
+    
+    // Session interface implementation
+    std::future<std::vector<std::shared_ptr<Item>>> get_items(
+        std::optional<size_t> limit = std::nullopt
+    ) override;
+    
+    std::future<void> add_items(
+        const std::vector<std::shared_ptr<Item>>& items
+    ) override;
+    
+    std::future<std::shared_ptr<Item>> pop_item() override;
+    std::future<void> clear_session() override;
+    
+    size_t get_item_count() const override;
+    bool rebind(const std::string& session_id) override;
+    
+    // Cursors are logical positions, which keep counting across evictions
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    // Ring-specific methods
+    size_t get_capacity() const { return capacity_; }
+    uint64_t get_evicted_count() const { return evicted_count_.load(std::memory_order_relaxed); }
+    std::vector<std::shared_ptr<Item>> snapshot(std::optional<size_t> limit = std::nullopt) const;
+    size_t get_retired_cell_count() const;
+
+private:
+    void add_items_internal(const std::vector<std::shared_ptr<Item>>& items);
+    std::shared_ptr<Item> pop_item_internal();
+    void clear_session_internal();
+    ItemPage scan_internal(std::optional<int64_t> cursor, size_t batch_size, bool reverse);
+    
+    void begin_write();
+    void end_write();
+    
+    // Writer-side cell management; callers hold write_mutex_
+    void store_slot(uint64_t position, std::shared_ptr<Item> item);
+    void reclaim_cells();
+};
+
+// Write-behind configuration
+struct WriteBehindOptions {
+    // Flush once this many items are buffered
+    size_t max_buffered_items = 256;
+    // Flush once the oldest buffered item has waited this long
+    std::chrono::milliseconds max_delay{100};
+    // Crash-safety bound: once this many items are unflushed, add_items
+    // flushes before completing. 0 leaves the buffer unbounded; 1 makes
+    // every write durable before add_items completes.
+    size_t max_unflushed_items = 0;
+};
+
+// Decorator that acknowledges add_items from an in-memory tail buffer and
+// flushes it to the backing session from a background thread. Reads merge
+// the durable items with the unflushed tail. Items still buffered when the
+// process dies are lost, up to the max_unflushed_items bound.
+class WriteBehindSession : public SessionBase {
+private:
+    std::shared_ptr<Session> backing_;
+    WriteBehindOptions options_;
+    
+    std::vector<std::shared_ptr<Item>> tail_;  // unflushed, oldest first
+    std::chrono::steady_clock::time_point oldest_buffered_at_;
+    bool last_flush_failed_ = false;
+    bool stopping_ = false;
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    
+    // Held exclusively while the backing store changes, so a flushing batch
+    // is never seen both in the store and in the tail
+    mutable std::shared_mutex store_mutex_;
+    
+    std::atomic<uint64_t> flushed_count_{0};
+    std::thread flusher_;
+
+public:
+    WriteBehindSession(std::shared_ptr<Session> backing, const WriteBehindOptions& options = {});
+    ~WriteBehindSession();
+    
+    // Session interface implementation
+    std::future<std::vector<std::shared_ptr<Item>>> get_items(
+        std::optional<size_t> limit = std::nullopt
+    ) override;
+    
+    std::future<void> add_items(
+        const std::vector<std::shared_ptr<Item>>& items
+    ) override;
+    
+    std::future<std::shared_ptr<Item>> pop_item() override;
+    std::future<void> clear_session() override;
+    
+    size_t get_item_count() const override;
+    SessionSummary get_summary() const override;
+    
+    // Metadata and timestamps live on the backing session
+    std::map<std::string, std::any> get_metadata() const override { return backing_->get_metadata(); }
+    void set_metadata(const std::string& key, const std::any& value) override;
+    bool has_metadata(const std::string& key) const override { return backing_->has_metadata(key); }
+    std::chrono::system_clock::time_point get_created_at() const override { return backing_->get_created_at(); }
+    std::chrono::system_clock::time_point get_updated_at() const override { return backing_->get_updated_at(); }
+    
+    // Scans flush first so cursors come from the backing session
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+    
+    // Counts the buffered tail, then asks the backing session for the rest
+    std::future<std::vector<std::shared_ptr<Item>>> get_items_within_budget(size_t max_tokens) override;
+    
+    // Write-behind specific methods
+    void flush();
+    size_t get_buffered_count() const;
+    uint64_t get_flushed_count() const { return flushed_count_.load(std::memory_order_relaxed); }
+    const std::shared_ptr<Session>& get_backing_session() const { return backing_; }
+
+private:
+    std::vector<std::shared_ptr<Item>> get_items_internal(std::optional<size_t> limit);
+    std::shared_ptr<Item> pop_item_internal();
+    void clear_session_internal();
+    
+    void run_flusher();
+};
+
+// Idle session expiry for SessionManager. A background sweeper drops
+// sessions that have not been looked up or created for idle_timeout,
+// checking once per resolution tick.
+struct IdleExpiryOptions {
+    std::chrono::milliseconds idle_timeout{std::chrono::minutes(30)};
+    std::chrono::milliseconds resolution{std::chrono::seconds(1)};
+    
+    // Runs on the sweeper thread before a session is dropped, after any
+    // write-behind buffer has been flushed. If it throws, the session is
+    // kept and retried after another idle_timeout.
+    std::function<void(const std::shared_ptr<Session>&)> persist;
+};
+
+struct IdleExpiryStats {
+    size_t tracked_sessions = 0;
+    uint64_t expired_sessions = 0;
+    uint64_t persist_failures = 0;
 };
 
 // Session manager for handling multiple sessions
 class SessionManager {
+public:
+    // Lock statistics for one shard
+    struct ShardStats {
+        size_t session_count;
+        uint64_t lock_acquisitions;
+        uint64_t contended_acquisitions;
+    };
+
 private:
-    std::map<std::string, std::shared_ptr<Session>> sessions_;
-    mutable std::shared_mutex sessions_mutex_;
+    // Sessions are striped across shards by hash of the session id, each
+    // with its own map and lock, so lookups for different ids rarely contend
+    struct alignas(64) SessionShard {
+        std::unordered_map<std::string, std::shared_ptr<Session>> sessions;
+        mutable std::shared_mutex mutex;
+        mutable std::atomic<uint64_t> lock_acquisitions{0};
+        mutable std::atomic<uint64_t> contended_acquisitions{0};
+    };
+    
+    std::vector<std::unique_ptr<SessionShard>> shards_;
     std::string default_db_path_;
     std::string default_sessions_table_;
     std::string default_messages_table_;
+    GroupCommitOptions default_group_commit_;
+    bool default_search_index_ = false;
+    
+    // Background idle expiry (null when disabled)
+    std::shared_ptr<class SessionSweeper> sweeper_;
+    
+    // Batch operations still running on the executor
+    std::mutex pending_mutex_;
+    std::condition_variable pending_cv_;
+    size_t pending_operations_ = 0;
+    
+    friend class SessionSweeper;
 
 public:
     SessionManager(
         const std::string& default_db_path = ":memory:",
         const std::string& default_sessions_table = "agent_sessions",
-        const std::string& default_messages_table = "agent_messages"
+        const std::string& default_messages_table = "agent_messages",
+        size_t shard_count = 64
     );
     
+    virtual ~SessionManager();
+    
     // Session creation and retrieval
-    std::shared_ptr<Session> get_session(const std::string& session_id);
-    std::shared_ptr<Session> create_session(const std::string& session_id);
-    std::shared_ptr<Session> get_or_create_session(const std::string& session_id);
+    virtual std::shared_ptr<Session> get_session(const std::string& session_id);
+    virtual std::shared_ptr<Session> create_session(const std::string& session_id);
+    virtual std::shared_ptr<Session> get_or_create_session(const std::string& session_id);
     
     // Session types
     std::shared_ptr<SQLiteSession> create_sqlite_session(
@@ -220,21 +687,101 @@ public:
     
     // Session management
     bool has_session(const std::string& session_id) const;
-    void remove_session(const std::string& session_id);
-    void clear_all_sessions();
+    virtual void remove_session(const std::string& session_id);
+    virtual void clear_all_sessions();
     
     std::vector<std::string> list_session_ids() const;
     size_t get_session_count() const;
     
-    // Batch operations
+    // Sharding
+    size_t get_shard_count() const { return shards_.size(); }
+    std::vector<ShardStats> get_shard_stats() const;
+    
+    // Batch operations; the manager waits for them before it is destroyed
     std::future<void> clear_all_sessions_async();
     std::future<std::map<std::string, size_t>> get_all_session_stats();
     
+    // Streams a summary of every managed session. File-backed SQLite
+    // sessions are summarized with one grouped query per database; other
+    // sessions report their own counters.
+    void for_each_session_summary(const SessionSummaryVisitor& visitor) const;
+    
+    // Best full-text matches across the default database and every
+    // database the managed SQLite sessions use, including sessions stored
+    // there that the manager does not hold. Other session types are not
+    // indexed.
+    std::vector<SearchResult> search(const std::string& query, size_t limit = 20) const;
+    
     // Configuration
     void set_default_db_path(const std::string& db_path) { default_db_path_ = db_path; }
     const std::string& get_default_db_path() const { return default_db_path_; }
     
     void set_default_tables(const std::string& sessions_table, const std::string& messages_table);
+    
+    void set_default_group_commit(const GroupCommitOptions& options) { default_group_commit_ = options; }
+    const GroupCommitOptions& get_default_group_commit() const { return default_group_commit_; }
+    
+    // SQLite sessions created from now on enable the search index
+    void set_default_search_index(bool enabled) { default_search_index_ = enabled; }
+    bool get_default_search_index() const { return default_search_index_; }
+    
+    // Idle expiry. Enable before sharing the manager between threads.
+    // Expired sessions are reported through on_session_expired() on the
+    // sweeper thread, so subclasses that override it must call
+    // disable_idle_expiry() in their destructor.
+    void enable_idle_expiry(const IdleExpiryOptions& options = {});
+    void disable_idle_expiry();
+    bool is_idle_expiry_enabled() const { return sweeper_ != nullptr; }
+    IdleExpiryStats get_idle_expiry_stats() const;
+
+protected:
+    // Pushes back a session's idle deadline; lookups call this on a hit
+    void record_access(const std::string& session_id) const;
+    
+    // Called after the sweeper has dropped an idle session, in place of
+    // remove_session(), so subclasses can drop their own references
+    virtual void on_session_expired(const std::string& session_id);
+    
+    // Blocks until batch operations started by this manager have finished.
+    // They call virtual methods, so subclasses that override those must
+    // call this in their destructor.
+    void wait_for_pending_operations();
+
+private:
+    SessionShard& shard_for(const std::string& session_id) const;
+    std::shared_ptr<Session> find_session(const std::string& session_id) const;
+    std::shared_ptr<SQLiteSession> make_sqlite_session(const std::string& session_id, const std::string& db_path) const;
+    
+    // Erases session_id only if it still maps to session and nothing has
+    // recorded access since its deadline; both are checked under the shard
+    // lock that lookups record access under
+    bool remove_if_idle(const std::string& session_id, const std::shared_ptr<Session>& session);
+    void restore_session(const std::string& session_id, const std::shared_ptr<Session>& session);
+    
+    static std::shared_lock<std::shared_mutex> lock_shared(const SessionShard& shard);
+    static std::unique_lock<std::shared_mutex> lock_unique(const SessionShard& shard);
+    
+    // Runs func on the shared executor, counted as a pending operation
+    template<typename F>
+    auto submit_tracked(F&& func) -> std::future<std::invoke_result_t<F>> {
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            pending_operations_++;
+        }
+        struct Done {
+            SessionManager* manager;
+            ~Done() {
+                std::lock_guard<std::mutex> lock(manager->pending_mutex_);
+                if (--manager->pending_operations_ == 0) {
+                    manager->pending_cv_.notify_all();
+                }
+            }
+        };
+        return get_default_session_executor()->submit([this, func = std::forward<F>(func)]() mutable {
+            Done done{this};
+            return func();
+        });
+    }
 };
 
 // Session factory
@@ -244,13 +791,30 @@ public:
         const std::string& session_id,
         const std::string& db_path = ":memory:",
         const std::string& sessions_table = "agent_sessions",
-        const std::string& messages_table = "agent_messages"
+        const std::string& messages_table = "agent_messages",
+        const GroupCommitOptions& group_commit = {}
     );
     
     static std::shared_ptr<Session> create_memory_session(
         const std::string& session_id
     );
     
+    static std::shared_ptr<Session> create_ring_memory_session(
+        const std::string& session_id,
+        size_t capacity
+    );
+    
+    static std::shared_ptr<Session> create_log_session(
+        const std::string& session_id,
+        const std::string& log_dir = ".",
+        bool sync_writes = false
+    );
+    
+    static std::shared_ptr<Session> create_write_behind_session(
+        std::shared_ptr<Session> backing,
+        const WriteBehindOptions& options = {}
+    );
+    
     static std::shared_ptr<Session> create_default_session(
         const std::string& session_id
     );
@@ -258,7 +822,9 @@ public:
     // Session type detection
     enum class SessionType {
         Memory,
+        RingMemory,
         SQLite,
+        Log,
         Auto
     };
     
@@ -0,0 +1,399 @@
+#include "session_archive.h"
+#include "item_codec.h"
+#include "../exceptions.h"
+#include <fstream>
+#include <cstring>
+#include <zlib.h>
+
+namespace openai_agents {
+namespace memory {
+
+namespace {
+
+constexpr char kArchiveMagic[6] = {'O', 'A', 'S', 'E', 'S', 'S'};
+constexpr uint8_t kArchiveVersion = 1;
+constexpr uint8_t kFlagCompressed = 0x01;
+
+// Frame types
+constexpr uint8_t kFrameEnd = 0;
+constexpr uint8_t kFrameSessionBegin = 1;
+constexpr uint8_t kFrameItem = 2;
+constexpr uint8_t kFrameSessionEnd = 3;
+
+// Largest frame payload. Frame lengths come from the file, so readers
+// check them before allocating; writers refuse anything bigger.
+constexpr uint64_t kMaxFramePayload = 256ull << 20;
+
+constexpr size_t kChunkSize = 64 * 1024;
+
+void put_varint(std::string& out, uint64_t value) {
+    while (value >= 0x80) {
+        out.push_back(static_cast<char>(value | 0x80));
+        value >>= 7;
+    }
+    out.push_back(static_cast<char>(value));
+}
+
+uint64_t get_varint(const std::string& data) {
+    uint64_t value = 0;
+    for (size_t i = 0; i < data.size() && i < 10; i++) {
+        uint8_t byte = static_cast<uint8_t>(data[i]);
+        value |= static_cast<uint64_t>(byte & 0x7f) << (7 * i);
+        if (!(byte & 0x80)) {
+            return value;
+        }
+    }
+    throw AgentsException("Corrupt session archive: bad varint");
+}
+
+} // namespace
+
+// Buffered file output, deflated when compression is on
+class ArchiveOutput {
+private:
+    std::ofstream file_;
+    std::string path_;
+    bool compress_;
+    z_stream zs_{};
+    std::string pending_;
+    std::vector<char> chunk_;
+
+public:
+    ArchiveOutput(const std::string& path, const ArchiveOptions& options)
+        : file_(path, std::ios::binary | std::ios::trunc), path_(path), compress_(options.compress) {
+        if (!file_) {
+            throw AgentsException("Failed to open archive for writing: " + path);
+        }
+
+        // The header is always stored uncompressed
+        char header[sizeof(kArchiveMagic) + 2];
+        std::memcpy(header, kArchiveMagic, sizeof(kArchiveMagic));
+        header[sizeof(kArchiveMagic)] = static_cast<char>(kArchiveVersion);
+        header[sizeof(kArchiveMagic) + 1] = static_cast<char>(compress_ ? kFlagCompressed : 0);
+        file_.write(header, sizeof(header));
+
+        if (compress_) {
+            if (deflateInit(&zs_, options.compression_level) != Z_OK) {
+                throw AgentsException("Failed to initialize archive compression");
+            }
+            chunk_.resize(kChunkSize);
+        }
+    }
+
+    ~ArchiveOutput() {
+        if (compress_) {
+            deflateEnd(&zs_);
+        }
+    }
+
+    void write(const std::string& data) {
+        pending_.append(data);
+        if (pending_.size() >= kChunkSize) {
+            drain(Z_NO_FLUSH);
+        }
+    }
+
+    void finish() {
+        drain(Z_FINISH);
+        file_.flush();
+        if (!file_) {
+            throw AgentsException("Failed to write archive: " + path_);
+        }
+    }
+
+private:
+    void drain(int flush) {
+        if (!compress_) {
+            file_.write(pending_.data(), static_cast<std::streamsize>(pending_.size()));
+            pending_.clear();
+            return;
+        }
+
+        zs_.next_in = reinterpret_cast<Bytef*>(pending_.data());
+        zs_.avail_in = static_cast<uInt>(pending_.size());
+        int rc;
+        do {
+            zs_.next_out = reinterpret_cast<Bytef*>(chunk_.data());
+            zs_.avail_out = static_cast<uInt>(chunk_.size());
+            rc = deflate(&zs_, flush);
+            if (rc == Z_STREAM_ERROR) {
+                throw AgentsException("Archive compression failed");
+            }
+            file_.write(chunk_.data(), static_cast<std::streamsize>(chunk_.size() - zs_.avail_out));
+        } while (zs_.avail_out == 0 || (flush == Z_FINISH && rc != Z_STREAM_END));
+        pending_.clear();
+    }
+};
+
+// Buffered file input, inflated when the archive is compressed
+class ArchiveInput {
+private:
+    std::ifstream file_;
+    bool compress_ = false;
+    z_stream zs_{};
+    std::vector<char> in_chunk_;
+    std::vector<char> out_chunk_;
+    size_t out_pos_ = 0;
+    size_t out_len_ = 0;
+    bool stream_end_ = false;
+
+public:
+    explicit ArchiveInput(const std::string& path)
+        : file_(path, std::ios::binary), out_chunk_(kChunkSize) {
+        if (!file_) {
+            throw AgentsException("Failed to open archive: " + path);
+        }
+
+        char header[sizeof(kArchiveMagic) + 2];
+        if (!file_.read(header, sizeof(header)) ||
+            std::memcmp(header, kArchiveMagic, sizeof(kArchiveMagic)) != 0) {
+            throw AgentsException("Not a session archive: " + path);
+        }
+        if (static_cast<uint8_t>(header[sizeof(kArchiveMagic)]) != kArchiveVersion) {
+            throw AgentsException("Unsupported session archive version: " + path);
+        }
+
+        compress_ = (header[sizeof(kArchiveMagic) + 1] & kFlagCompressed) != 0;
+        if (compress_) {
+            if (inflateInit(&zs_) != Z_OK) {
+                throw AgentsException("Failed to initialize archive decompression");
+            }
+            in_chunk_.resize(kChunkSize);
+        }
+    }
+
+    ~ArchiveInput() {
+        if (compress_) {
+            inflateEnd(&zs_);
+        }
+    }
+
+    // Reads exactly size bytes; false only if the input ended first
+    bool read(char* data, size_t size) {
+        while (size > 0) {
+            if (out_pos_ == out_len_ && !refill()) {
+                return false;
+            }
+            size_t count = std::min(size, out_len_ - out_pos_);
+            std::memcpy(data, out_chunk_.data() + out_pos_, count);
+            out_pos_ += count;
+            data += count;
+            size -= count;
+        }
+        return true;
+    }
+
+private:
+    bool refill() {
+        out_pos_ = 0;
+        out_len_ = 0;
+        if (!compress_) {
+            file_.read(out_chunk_.data(), static_cast<std::streamsize>(out_chunk_.size()));
+            out_len_ = static_cast<size_t>(file_.gcount());
+            return out_len_ > 0;
+        }
+
+        while (out_len_ == 0) {
+            if (stream_end_) {
+                return false;
+            }
+            if (zs_.avail_in == 0) {
+                file_.read(in_chunk_.data(), static_cast<std::streamsize>(in_chunk_.size()));
+                zs_.next_in = reinterpret_cast<Bytef*>(in_chunk_.data());
+                zs_.avail_in = static_cast<uInt>(file_.gcount());
+                if (zs_.avail_in == 0) {
+                    return false;
+                }
+            }
+            zs_.next_out = reinterpret_cast<Bytef*>(out_chunk_.data());
+            zs_.avail_out = static_cast<uInt>(out_chunk_.size());
+            int rc = inflate(&zs_, Z_NO_FLUSH);
+            if (rc == Z_STREAM_END) {
+                stream_end_ = true;
+            } else if (rc != Z_OK && rc != Z_BUF_ERROR) {
+                throw AgentsException("Corrupt session archive: decompression failed");
+            }
+            out_len_ = out_chunk_.size() - zs_.avail_out;
+        }
+        return true;
+    }
+};
+
+// SessionArchiveWriter implementation
+SessionArchiveWriter::SessionArchiveWriter(const std::string& path, const ArchiveOptions& options)
+    : out_(std::make_unique<ArchiveOutput>(path, options)) {
+}
+
+SessionArchiveWriter::~SessionArchiveWriter() {
+    if (out_) {
+        try {
+            close();
+        } catch (...) {
+            // Destructors must not throw; call close() to see write errors
+        }
+    }
+}
+
+void SessionArchiveWriter::write_frame(uint8_t type, const std::string& payload) {
+    if (payload.size() > kMaxFramePayload) {
+        throw AgentsException("Cannot archive session: frame too large");
+    }
+    buffer_.clear();
+    buffer_.push_back(static_cast<char>(type));
+    put_varint(buffer_, payload.size());
+    buffer_.append(payload);
+    out_->write(buffer_);
+}
+
+void SessionArchiveWriter::begin_session(const std::string& session_id) {
+    if (!out_) {
+        throw AgentsException("Session archive is closed");
+    }
+    if (in_session_) {
+        end_session();
+    }
+    write_frame(kFrameSessionBegin, session_id);
+    current_session_ = session_id;
+    current_items_ = 0;
+    in_session_ = true;
+}
+
+void SessionArchiveWriter::write_item(const Item& item) {
+    if (!in_session_) {
+        throw AgentsException("write_item called outside a session");
+    }
+    write_frame(kFrameItem, ItemCodec::encode(item));
+    current_items_++;
+}
+
+void SessionArchiveWriter::end_session() {
+    if (!in_session_) {
+        return;
+    }
+    std::string count;
+    put_varint(count, current_items_);
+    write_frame(kFrameSessionEnd, count);
+    in_session_ = false;
+}
+
+uint64_t SessionArchiveWriter::write_session(Session& session, size_t batch_size) {
+    begin_session(session.get_session_id());
+
+    std::optional<int64_t> cursor;
+    do {
+        auto page = session.scan_sync(cursor, batch_size);
+        for (const auto& item : page.items) {
+            write_item(*item);
+        }
+        cursor = page.next_cursor;
+    } while (cursor);
+
+    uint64_t count = current_items_;
+    end_session();
+    return count;
+}
+
+void SessionArchiveWriter::close() {
+    if (!out_) {
+        return;
+    }
+    end_session();
+    write_frame(kFrameEnd, "");
+
+    // Release the file even if the final flush fails
+    auto out = std::move(out_);
+    out->finish();
+}
+
+// SessionArchiveReader implementation
+SessionArchiveReader::SessionArchiveReader(const std::string& path)
+    : in_(std::make_unique<ArchiveInput>(path)) {
+}
+
+SessionArchiveReader::~SessionArchiveReader() = default;
+
+uint8_t SessionArchiveReader::read_frame() {
+    char type;
+    if (!in_->read(&type, 1)) {
+        throw AgentsException("Corrupt session archive: missing end marker");
+    }
+
+    // Varint length, one byte at a time
+    uint64_t length = 0;
+    for (int shift = 0;; shift += 7) {
+        char byte;
+        if (shift > 63 || !in_->read(&byte, 1)) {
+            throw AgentsException("Corrupt session archive: truncated frame");
+        }
+        length |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) break;
+    }
+
+    if (length > kMaxFramePayload) {
+        throw AgentsException("Corrupt session archive: frame too large");
+    }
+    payload_.resize(length);
+    if (length > 0 && !in_->read(&payload_[0], length)) {
+        throw AgentsException("Corrupt session archive: truncated frame");
+    }
+    return static_cast<uint8_t>(type);
+}
+
+bool SessionArchiveReader::next_session(std::string& session_id) {
+    while (!finished_) {
+        uint8_t type = read_frame();
+        switch (type) {
+        case kFrameSessionBegin:
+            current_session_ = payload_;
+            current_items_ = 0;
+            in_session_ = true;
+            session_id = current_session_;
+            return true;
+        case kFrameItem:
+        case kFrameSessionEnd:
+            // Skipping the rest of the previous session
+            in_session_ = false;
+            break;
+        case kFrameEnd:
+            finished_ = true;
+            break;
+        default:
+            throw AgentsException("Corrupt session archive: unknown frame type");
+        }
+    }
+    return false;
+}
+
+std::vector<std::shared_ptr<Item>> SessionArchiveReader::read_items(size_t max_items) {
+    std::vector<std::shared_ptr<Item>> items;
+    while (in_session_ && items.size() < max_items) {
+        uint8_t type = read_frame();
+        if (type == kFrameItem) {
+            items.push_back(ItemCodec::decode(payload_));
+            current_items_++;
+        } else if (type == kFrameSessionEnd) {
+            in_session_ = false;
+            if (get_varint(payload_) != current_items_) {
+                throw AgentsException("Corrupt session archive: item count mismatch in " + current_session_);
+            }
+        } else {
+            throw AgentsException("Corrupt session archive: unterminated session " + current_session_);
+        }
+    }
+    return items;
+}
+
+uint64_t SessionArchiveReader::read_session_into(Session& target, size_t batch_size) {
+    uint64_t count = 0;
+    while (true) {
+        auto items = read_items(batch_size);
+        if (items.empty()) break;
+        // get() rather than add_items_sync() so write errors reach the caller
+        target.add_items(items).get();
+        count += items.size();
+    }
+    return count;
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+/**
+ * Streaming archive format for exporting and importing sessions
+ *
+ * An archive starts with a 6-byte magic, a version byte and a flags byte.
+ * The rest is a sequence of frames, deflate-compressed as one stream when
+ * the compression flag is set. Each frame is a type byte and a varint
+ * length followed by the payload: a session id to start a session, an
+ * ItemCodec record per item, and an item count closing the session.
+ * Readers and writers hold one frame at a time, so archives of any size
+ * are processed in constant memory. Frame payloads are limited to 256 MiB.
+ */
+
+#include "session.h"
+#include <string>
+#include <memory>
+#include <vector>
+
+namespace openai_agents {
+namespace memory {
+
+// Archive settings
+struct ArchiveOptions {
+    bool compress = true;
+    int compression_level = 6;  // zlib level, 1 (fast) to 9 (small)
+    size_t batch_size = 500;    // items per page read or transaction written
+};
+
+class SessionArchiveWriter {
+private:
+    std::unique_ptr<class ArchiveOutput> out_;
+    std::string buffer_;
+    std::string current_session_;
+    uint64_t current_items_ = 0;
+    bool in_session_ = false;
+
+public:
+    SessionArchiveWriter(const std::string& path, const ArchiveOptions& options = {});
+    ~SessionArchiveWriter();
+    
+    // Frame-level writing
+    void begin_session(const std::string& session_id);
+    void write_item(const Item& item);
+    void end_session();
+    
+    // Streams a whole session, one scan page at a time; returns the item count
+    uint64_t write_session(Session& session, size_t batch_size = 500);
+    
+    // Writes the end marker and flushes; called by the destructor if needed
+    void close();
+
+private:
+    void write_frame(uint8_t type, const std::string& payload);
+};
+
+class SessionArchiveReader {
+private:
+    std::unique_ptr<class ArchiveInput> in_;
+    std::string payload_;
+    std::string current_session_;
+    uint64_t current_items_ = 0;
+    bool in_session_ = false;
+    bool finished_ = false;
+
+public:
+    explicit SessionArchiveReader(const std::string& path);
+    ~SessionArchiveReader();
+    
+    // Moves to the next session, skipping unread items of the current one;
+    // false once the archive is exhausted
+    bool next_session(std::string& session_id);
+    
+    // Up to max_items of the current session; empty once it is exhausted
+    std::vector<std::shared_ptr<Item>> read_items(size_t max_items);
+    
+    // Copies the rest of the current session into target, one add_items
+    // call (one transaction for SQLite) per batch; returns the item count
+    uint64_t read_session_into(Session& target, size_t batch_size = 500);
+
+private:
+    uint8_t read_frame();
+};
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
@@ -0,0 +1,122 @@
+#include "timer_wheel.h"
+#include <algorithm>
+
+namespace openai_agents {
+namespace memory {
+
+TimerWheel::TimerWheel(Tick start_tick) : current_(start_tick) {}
+
+void TimerWheel::link(Timer& head, Timer& timer) {
+    timer.prev = head.prev;
+    timer.next = &head;
+    head.prev->next = &timer;
+    head.prev = &timer;
+}
+
+void TimerWheel::unlink(Timer& timer) {
+    timer.prev->next = timer.next;
+    timer.next->prev = timer.prev;
+    timer.prev = timer.next = &timer;
+}
+
+void TimerWheel::insert(Timer& timer) {
+    if (timer.deadline <= current_) {
+        // Overdue timers go in the slot being processed
+        link(slots_[0][current_ & kSlotMask], timer);
+        return;
+    }
+
+    Tick delta = timer.deadline - current_;
+    for (int level = 0; level < kLevels; level++) {
+        if (delta < (Tick(1) << (kSlotBits * (level + 1)))) {
+            link(slots_[level][(timer.deadline >> (kSlotBits * level)) & kSlotMask], timer);
+            return;
+        }
+    }
+
+    // Beyond the wheel's range: park in the furthest top-level slot and
+    // re-slot when it is cascaded
+    constexpr int top = kLevels - 1;
+    Tick parked = current_ + (Tick(1) << (kSlotBits * kLevels)) - 1;
+    link(slots_[top][(parked >> (kSlotBits * top)) & kSlotMask], timer);
+}
+
+void TimerWheel::take_slot(Timer& head) {
+    due_.clear();
+    for (Timer* timer = head.next; timer != &head; timer = timer->next) {
+        due_.push_back(timer);
+    }
+    head.prev = head.next = &head;
+}
+
+void TimerWheel::schedule(const std::string& key, Tick deadline) {
+    deadline = std::max(deadline, current_ + 1);
+
+    auto [it, inserted] = timers_.try_emplace(key);
+    Timer& timer = it->second;
+    if (inserted) {
+        timer.key = &it->first;
+        timer.deadline = deadline;
+        insert(timer);
+    } else if (deadline < timer.deadline) {
+        // Earlier deadlines must move now; later ones wait for the old slot
+        timer.deadline = deadline;
+        unlink(timer);
+        insert(timer);
+    } else {
+        timer.deadline = deadline;
+    }
+}
+
+bool TimerWheel::cancel(const std::string& key) {
+    auto it = timers_.find(key);
+    if (it == timers_.end()) {
+        return false;
+    }
+    unlink(it->second);
+    timers_.erase(it);
+    return true;
+}
+
+void TimerWheel::clear() {
+    for (auto& [key, timer] : timers_) {
+        unlink(timer);
+    }
+    timers_.clear();
+}
+
+void TimerWheel::advance(Tick now, std::vector<std::string>& expired) {
+    while (current_ < now) {
+        if (timers_.empty()) {
+            current_ = now;
+            return;
+        }
+        current_++;
+
+        // Cascade higher levels whose slot boundary this tick crosses,
+        // top first so re-slotted timers can cascade again below
+        for (int level = kLevels - 1; level > 0; level--) {
+            Tick span_mask = (Tick(1) << (kSlotBits * level)) - 1;
+            if ((current_ & span_mask) != 0) continue;
+
+            take_slot(slots_[level][(current_ >> (kSlotBits * level)) & kSlotMask]);
+            for (Timer* timer : due_) {
+                insert(*timer);
+            }
+        }
+
+        take_slot(slots_[0][current_ & kSlotMask]);
+        for (Timer* timer : due_) {
+            if (timer->deadline > current_) {
+                // Touched since it was slotted
+                insert(*timer);
+                continue;
+            }
+            expired.push_back(*timer->key);
+            timers_.erase(expired.back());
+        }
+    }
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
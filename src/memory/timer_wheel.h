@@ -0,0 +1,71 @@
+#pragma once
+
+/**
+ * Hierarchical timer wheel keyed by string
+ *
+ * Four levels of 64 slots cover 2^24 ticks; deadlines further out are
+ * parked in the top level and re-slotted as they come closer. Scheduling,
+ * cancelling and advancing cost O(1) amortized per timer. Pushing a
+ * deadline later only updates the timer; it is moved when its old slot
+ * comes due, so frequent touches stay cheap. Not thread-safe.
+ */
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace openai_agents {
+namespace memory {
+
+class TimerWheel {
+public:
+    using Tick = uint64_t;
+
+    explicit TimerWheel(Tick start_tick = 0);
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator=(const TimerWheel&) = delete;
+
+    // Sets the key's deadline, adding it if needed; deadlines not after
+    // the current tick fire on the next one
+    void schedule(const std::string& key, Tick deadline);
+    bool cancel(const std::string& key);
+    void clear();
+    bool contains(const std::string& key) const { return timers_.count(key) > 0; }
+
+    // Moves to now and removes every key whose deadline has passed,
+    // appending it to expired
+    void advance(Tick now, std::vector<std::string>& expired);
+
+    size_t size() const { return timers_.size(); }
+    Tick current_tick() const { return current_; }
+
+private:
+    static constexpr int kLevels = 4;
+    static constexpr int kSlotBits = 6;
+    static constexpr Tick kSlots = Tick(1) << kSlotBits;
+    static constexpr Tick kSlotMask = kSlots - 1;
+
+    // Intrusive list node; each slot holds a circular list with a sentinel
+    struct Timer {
+        const std::string* key = nullptr;
+        Tick deadline = 0;
+        Timer* prev = this;
+        Timer* next = this;
+    };
+
+    std::array<std::array<Timer, kSlots>, kLevels> slots_;
+    std::unordered_map<std::string, Timer> timers_;
+    Tick current_;
+    std::vector<Timer*> due_;  // reused while a slot is processed
+
+    void insert(Timer& timer);
+    static void link(Timer& head, Timer& timer);
+    static void unlink(Timer& timer);
+    void take_slot(Timer& head);
+};
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
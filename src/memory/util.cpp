@@ -1,10 +1,8 @@
 #include "util.h"
 #include "../exceptions.h"
 #include "../logger.h"
-#include <random>
+#include "../tracing/ids.h"
 #include <algorithm>
-#include <sstream>
-#include <iomanip>
 #include <regex>
 
 namespace openai_agents {
@@ -40,23 +38,23 @@ std::string SessionUtils::normalize_session_id(const std::string& session_id) {
 }
 
 std::string SessionUtils::generate_session_id() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    
     auto now = std::chrono::system_clock::now();
     auto timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
         now.time_since_epoch()).count();
     
-    std::ostringstream oss;
-    oss << "session_" << timestamp << "_";
-    
-    // Add random hex suffix
-    for (int i = 0; i < 8; i++) {
-        oss << std::hex << dis(gen);
+    // Random hex suffix from the thread's generator; the shared mt19937
+    // used before was neither fast nor safe to call from several threads
+    static constexpr char digits[] = "0123456789abcdef";
+    char suffix[8];
+    uint64_t random = tracing::random_u64();
+    for (char& c : suffix) {
+        c = digits[random & 0x0f];
+        random >>= 4;
     }
     
-    return oss.str();
+    std::string id = "session_" + std::to_string(timestamp) + "_";
+    id.append(suffix, sizeof(suffix));
+    return id;
 }
 
 void SessionUtils::migrate_session(
@@ -72,13 +70,20 @@ void SessionUtils::migrate_session(
         throw AgentsException("Cannot migrate session to itself");
     }
     
-    // Get all items from source
-    auto items = source->get_items_sync();
+    // Copy page by page so large sessions are never held in memory at once
+    size_t copied = 0;
+    std::optional<int64_t> cursor;
+    do {
+        auto page = source->scan_sync(cursor);
+        if (!page.items.empty()) {
+            // get() rather than add_items_sync() so a failed write aborts the copy
+            target->add_items(page.items).get();
+            copied += page.items.size();
+        }
+        cursor = page.next_cursor;
+    } while (cursor);
     
-    if (!items.empty()) {
-        // Add items to target
-        target->add_items_sync(items);
-        
+    if (copied > 0) {
         // Copy metadata
         auto source_metadata = source->get_metadata();
         for (const auto& [key, value] : source_metadata) {
@@ -87,11 +92,67 @@ void SessionUtils::migrate_session(
         
         // Clear source if requested
         if (clear_source) {
-            source->clear_session_sync();
+            source->clear_session().get();
         }
     }
 }
 
+size_t SessionUtils::export_sessions(
+    const std::vector<std::shared_ptr<Session>>& sessions,
+    const std::string& archive_path,
+    const ArchiveOptions& options
+) {
+    SessionArchiveWriter writer(archive_path, options);
+    size_t total = 0;
+    for (const auto& session : sessions) {
+        if (session) {
+            total += writer.write_session(*session, options.batch_size);
+        }
+    }
+    writer.close();
+    return total;
+}
+
+std::vector<std::shared_ptr<Session>> SessionUtils::import_sessions(
+    const std::string& archive_path,
+    const std::function<std::shared_ptr<Session>(const std::string&)>& make_target,
+    size_t batch_size
+) {
+    SessionArchiveReader reader(archive_path);
+    std::vector<std::shared_ptr<Session>> sessions;
+    std::string session_id;
+    while (reader.next_session(session_id)) {
+        auto target = make_target(session_id);
+        if (!target) {
+            // Skipped; next_session() discards the unread items
+            continue;
+        }
+        reader.read_session_into(*target, batch_size);
+        sessions.push_back(std::move(target));
+    }
+    return sessions;
+}
+
+std::future<void> SessionUtils::backup_sessions(
+    const std::vector<std::shared_ptr<Session>>& sessions,
+    const std::string& backup_path
+) {
+    return get_default_session_executor()->submit([sessions, backup_path]() {
+        export_sessions(sessions, backup_path);
+    });
+}
+
+std::future<std::vector<std::shared_ptr<Session>>> SessionUtils::restore_sessions(
+    const std::string& backup_path,
+    SessionFactory::SessionType target_type
+) {
+    return get_default_session_executor()->submit([backup_path, target_type]() {
+        return import_sessions(backup_path, [target_type](const std::string& session_id) {
+            return SessionFactory::create_session(session_id, target_type);
+        });
+    });
+}
+
 SessionUtils::SessionStats SessionUtils::analyze_session(std::shared_ptr<Session> session) {
     if (!session) {
         throw AgentsException("Session cannot be null");
@@ -137,30 +198,34 @@ SessionUtils::SessionStats SessionUtils::analyze_session(std::shared_ptr<Session
 std::map<std::string, SessionUtils::SessionStats> SessionUtils::analyze_all_sessions(SessionManager& manager) {
     std::map<std::string, SessionStats> all_stats;
     
-    auto session_ids = manager.list_session_ids();
-    for (const auto& session_id : session_ids) {
-        auto session = manager.get_session(session_id);
-        if (session) {
-            all_stats[session_id] = analyze_session(session);
-        }
-    }
+    // Bulk summaries never load items, so per-type counts are left empty;
+    // use analyze_session for those
+    manager.for_each_session_summary([&all_stats](const SessionSummary& summary) {
+        auto& stats = all_stats[summary.session_id];
+        stats.total_items = summary.item_count;
+        stats.total_size_bytes = summary.total_bytes;
+        stats.oldest_item = summary.first_item_at.value_or(std::chrono::system_clock::now());
+        stats.newest_item = summary.last_item_at.value_or(std::chrono::system_clock::time_point::min());
+        return true;
+    });
     
     return all_stats;
 }
 
 size_t SessionUtils::cleanup_empty_sessions(SessionManager& manager) {
-    auto session_ids = manager.list_session_ids();
-    size_t removed_count = 0;
-    
-    for (const auto& session_id : session_ids) {
-        auto session = manager.get_session(session_id);
-        if (session && session->get_item_count() == 0) {
-            manager.remove_session(session_id);
-            removed_count++;
+    std::vector<std::string> empty_ids;
+    manager.for_each_session_summary([&empty_ids](const SessionSummary& summary) {
+        if (summary.item_count == 0) {
+            empty_ids.push_back(summary.session_id);
         }
+        return true;
+    });
+    
+    for (const auto& session_id : empty_ids) {
+        manager.remove_session(session_id);
     }
     
-    return removed_count;
+    return empty_ids.size();
 }
 
 size_t SessionUtils::cleanup_old_sessions(
@@ -190,6 +255,12 @@ ObservableSessionManager::ObservableSessionManager(
 ) : SessionManager(default_db_path, default_sessions_table, default_messages_table) {
 }
 
+ObservableSessionManager::~ObservableSessionManager() {
+    // Stop expiring and finish batch operations before the listeners go away
+    disable_idle_expiry();
+    wait_for_pending_operations();
+}
+
 void ObservableSessionManager::add_listener(std::shared_ptr<SessionEventListener> listener) {
     std::unique_lock<std::shared_mutex> lock(listeners_mutex_);
     listeners_.push_back(listener);
@@ -219,6 +290,10 @@ void ObservableSessionManager::remove_session(const std::string& session_id) {
     emit_session_destroyed(session_id);
 }
 
+void ObservableSessionManager::on_session_expired(const std::string& session_id) {
+    emit_session_destroyed(session_id);
+}
+
 void ObservableSessionManager::clear_all_sessions() {
     auto session_ids = list_session_ids();
     SessionManager::clear_all_sessions();
@@ -247,103 +322,121 @@ void ObservableSessionManager::emit_session_destroyed(const std::string& session
 }
 
 // SessionCache implementation
-SessionCache::SessionCache(size_t max_size, std::chrono::minutes ttl)
+SessionCache::SessionCache(size_t max_size, std::chrono::minutes ttl, size_t segment_count)
     : max_size_(max_size), ttl_(ttl) {
+    segment_count = std::max<size_t>(segment_count, 1);
+    segments_.reserve(segment_count);
+    for (size_t i = 0; i < segment_count; i++) {
+        segments_.push_back(std::make_unique<Segment>());
+    }
+}
+
+SessionCache::Segment& SessionCache::segment_for(const std::string& session_id) {
+    return *segments_[std::hash<std::string>{}(session_id) % segments_.size()];
+}
+
+size_t SessionCache::segment_capacity() const {
+    // Capacity is split evenly; rounding up keeps tiny caches usable
+    size_t max_size = max_size_.load(std::memory_order_relaxed);
+    return std::max<size_t>((max_size + segments_.size() - 1) / segments_.size(), 1);
 }
 
 std::shared_ptr<Session> SessionCache::get(const std::string& session_id) {
-    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+    auto& segment = segment_for(session_id);
+    std::lock_guard<std::mutex> lock(segment.mutex);
+    
+    auto now = Clock::now();
+    evict_expired(segment, now);
     
-    auto it = cache_.find(session_id);
-    if (it != cache_.end() && !is_expired(session_id)) {
-        access_times_[session_id] = std::chrono::system_clock::now();
-        hits_++;
-        return it->second;
+    auto it = segment.index.find(session_id);
+    if (it == segment.index.end()) {
+        misses_.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
     }
     
-    misses_++;
-    return nullptr;
+    // Move to the front, which keeps the list in expiry order too
+    it->second->last_access = now;
+    segment.lru.splice(segment.lru.begin(), segment.lru, it->second);
+    hits_.fetch_add(1, std::memory_order_relaxed);
+    return it->second->session;
 }
 
 void SessionCache::put(const std::string& session_id, std::shared_ptr<Session> session) {
-    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
+    auto& segment = segment_for(session_id);
+    std::lock_guard<std::mutex> lock(segment.mutex);
+    
+    auto now = Clock::now();
+    auto it = segment.index.find(session_id);
+    if (it != segment.index.end()) {
+        it->second->session = std::move(session);
+        it->second->last_access = now;
+        segment.lru.splice(segment.lru.begin(), segment.lru, it->second);
+        return;
+    }
     
-    if (cache_.size() >= max_size_) {
-        evict_oldest();
+    evict_expired(segment, now);
+    size_t capacity = segment_capacity();
+    while (segment.lru.size() >= capacity) {
+        segment.index.erase(segment.lru.back().session_id);
+        segment.lru.pop_back();
     }
     
-    cache_[session_id] = session;
-    access_times_[session_id] = std::chrono::system_clock::now();
+    segment.lru.push_front({session_id, std::move(session), now});
+    segment.index[session_id] = segment.lru.begin();
 }
 
 void SessionCache::remove(const std::string& session_id) {
-    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-    cache_.erase(session_id);
-    access_times_.erase(session_id);
+    auto& segment = segment_for(session_id);
+    std::lock_guard<std::mutex> lock(segment.mutex);
+    
+    auto it = segment.index.find(session_id);
+    if (it != segment.index.end()) {
+        segment.lru.erase(it->second);
+        segment.index.erase(it);
+    }
 }
 
 void SessionCache::clear() {
-    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-    cache_.clear();
-    access_times_.clear();
+    for (auto& segment : segments_) {
+        std::lock_guard<std::mutex> lock(segment->mutex);
+        segment->lru.clear();
+        segment->index.clear();
+    }
     hits_ = 0;
     misses_ = 0;
 }
 
 void SessionCache::cleanup_expired() {
-    std::unique_lock<std::shared_mutex> lock(cache_mutex_);
-    
-    auto now = std::chrono::system_clock::now();
-    auto it = cache_.begin();
-    
-    while (it != cache_.end()) {
-        auto access_it = access_times_.find(it->first);
-        if (access_it != access_times_.end() && 
-            (now - access_it->second) > ttl_) {
-            access_times_.erase(access_it);
-            it = cache_.erase(it);
-        } else {
-            ++it;
-        }
+    auto now = Clock::now();
+    for (auto& segment : segments_) {
+        std::lock_guard<std::mutex> lock(segment->mutex);
+        evict_expired(*segment, now);
     }
 }
 
 size_t SessionCache::size() const {
-    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
-    return cache_.size();
+    size_t total = 0;
+    for (const auto& segment : segments_) {
+        std::lock_guard<std::mutex> lock(segment->mutex);
+        total += segment->lru.size();
+    }
+    return total;
 }
 
 double SessionCache::hit_rate() const {
-    std::shared_lock<std::shared_mutex> lock(cache_mutex_);
-    size_t total = hits_ + misses_;
-    return total > 0 ? static_cast<double>(hits_) / total : 0.0;
+    uint64_t hits = hits_.load(std::memory_order_relaxed);
+    uint64_t total = hits + misses_.load(std::memory_order_relaxed);
+    return total > 0 ? static_cast<double>(hits) / total : 0.0;
 }
 
-void SessionCache::evict_oldest() {
-    if (access_times_.empty()) return;
-    
-    auto oldest = std::min_element(
-        access_times_.begin(), 
-        access_times_.end(),
-        [](const auto& a, const auto& b) {
-            return a.second < b.second;
-        }
-    );
-    
-    if (oldest != access_times_.end()) {
-        cache_.erase(oldest->first);
-        access_times_.erase(oldest);
+void SessionCache::evict_expired(Segment& segment, Clock::time_point now) {
+    auto ttl = ttl_.load(std::memory_order_relaxed);
+    while (!segment.lru.empty() && (now - segment.lru.back().last_access) > ttl) {
+        segment.index.erase(segment.lru.back().session_id);
+        segment.lru.pop_back();
     }
 }
 
-bool SessionCache::is_expired(const std::string& session_id) const {
-    auto access_it = access_times_.find(session_id);
-    if (access_it == access_times_.end()) return true;
-    
-    auto now = std::chrono::system_clock::now();
-    return (now - access_it->second) > ttl_;
-}
-
 // CachedSessionManager implementation
 CachedSessionManager::CachedSessionManager(
     size_t cache_size,
@@ -352,13 +445,24 @@ CachedSessionManager::CachedSessionManager(
     const std::string& default_sessions_table,
     const std::string& default_messages_table
 ) : SessionManager(default_db_path, default_sessions_table, default_messages_table),
-    cache_(std::make_unique<SessionCache>(cache_size, cache_ttl)) {
+    // Segment the cache so lookups from different threads rarely share a
+    // lock, but keep at least 64 entries per segment so eviction stays close
+    // to a global LRU
+    cache_(std::make_unique<SessionCache>(
+        cache_size, cache_ttl, std::min<size_t>(16, std::max<size_t>(cache_size / 64, 1)))) {
+}
+
+CachedSessionManager::~CachedSessionManager() {
+    // Stop expiring and finish batch operations before the cache goes away
+    disable_idle_expiry();
+    wait_for_pending_operations();
 }
 
 std::shared_ptr<Session> CachedSessionManager::get_session(const std::string& session_id) {
     // Try cache first
     auto session = cache_->get(session_id);
     if (session) {
+        record_access(session_id);
         return session;
     }
     
@@ -372,11 +476,16 @@ std::shared_ptr<Session> CachedSessionManager::get_session(const std::string& se
 }
 
 std::shared_ptr<Session> CachedSessionManager::get_or_create_session(const std::string& session_id) {
-    auto session = get_session(session_id);
-    if (!session) {
-        session = SessionManager::create_session(session_id);
-        cache_->put(session_id, session);
+    auto session = cache_->get(session_id);
+    if (session) {
+        record_access(session_id);
+        return session;
     }
+    
+    // The base class creates under its shard lock, so concurrent misses
+    // still resolve to a single session
+    session = SessionManager::get_or_create_session(session_id);
+    cache_->put(session_id, session);
     return session;
 }
 
@@ -385,6 +494,10 @@ void CachedSessionManager::remove_session(const std::string& session_id) {
     SessionManager::remove_session(session_id);
 }
 
+void CachedSessionManager::on_session_expired(const std::string& session_id) {
+    cache_->remove(session_id);
+}
+
 void CachedSessionManager::clear_all_sessions() {
     cache_->clear();
     SessionManager::clear_all_sessions();
@@ -403,29 +516,36 @@ SessionPool::~SessionPool() {
 }
 
 std::shared_ptr<Session> SessionPool::acquire_session(const std::string& session_id) {
-    std::lock_guard<std::mutex> lock(pool_mutex_);
-    
-    // Check if session is already active
-    auto active_it = active_sessions_.find(session_id);
-    if (active_it != active_sessions_.end()) {
-        return active_it->second;
-    }
-    
-    // Try to reuse from available sessions
     std::shared_ptr<Session> session;
-    if (!available_sessions_.empty()) {
-        session = available_sessions_.back();
-        available_sessions_.pop_back();
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        
+        // Check if session is already active
+        auto active_it = active_sessions_.find(session_id);
+        if (active_it != active_sessions_.end()) {
+            return active_it->second;
+        }
         
-        // Reset session for new use
-        session->clear_session_sync();
-    } else {
-        // Create new session
+        if (!available_sessions_.empty()) {
+            session = available_sessions_.back();
+            available_sessions_.pop_back();
+        }
+    }
+    
+    // Rebinding keeps the pooled object's connections and prepared
+    // statements; only backends that cannot switch ids build a new session
+    auto pooled = std::dynamic_pointer_cast<SessionBase>(session);
+    if (!pooled || !pooled->rebind(session_id)) {
         session = create_pooled_session(session_id);
     }
     
-    active_sessions_[session_id] = session;
-    return session;
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    auto [it, inserted] = active_sessions_.emplace(session_id, session);
+    if (!inserted && available_sessions_.size() < max_pool_size_) {
+        // Another caller activated this id meanwhile; keep ours for later
+        available_sessions_.push_back(session);
+    }
+    return it->second;
 }
 
 void SessionPool::release_session(const std::string& session_id) {
@@ -445,11 +565,32 @@ void SessionPool::release_session(const std::string& session_id) {
 }
 
 void SessionPool::warm_up(size_t count) {
-    std::lock_guard<std::mutex> lock(pool_mutex_);
+    size_t needed;
+    {
+        std::lock_guard<std::mutex> lock(pool_mutex_);
+        size_t room = max_pool_size_ - std::min(max_pool_size_, available_sessions_.size());
+        needed = std::min(count, room);
+    }
     
-    for (size_t i = 0; i < count && available_sessions_.size() < max_pool_size_; i++) {
+    // Opening connections and preparing statements happens outside the
+    // lock so acquires are not held up
+    std::vector<std::shared_ptr<Session>> sessions;
+    sessions.reserve(needed);
+    for (size_t i = 0; i < needed; i++) {
         auto session = create_pooled_session("pool_session_" + std::to_string(i));
-        available_sessions_.push_back(session);
+        auto sqlite = std::dynamic_pointer_cast<SQLiteSession>(session);
+        if (sqlite && (i == 0 || sqlite->is_memory_db())) {
+            // File databases share one connection pool, so warming it once
+            // covers every pooled session; in-memory ones each have their own
+            sqlite->warm_up(needed);
+        }
+        sessions.push_back(std::move(session));
+    }
+    
+    std::lock_guard<std::mutex> lock(pool_mutex_);
+    for (auto& session : sessions) {
+        if (available_sessions_.size() >= max_pool_size_) break;
+        available_sessions_.push_back(std::move(session));
     }
 }
 
@@ -5,11 +5,15 @@
  */
 
 #include "session.h"
+#include "session_archive.h"
 #include <string>
 #include <vector>
 #include <memory>
 #include <functional>
 #include <map>
+#include <unordered_map>
+#include <list>
+#include <atomic>
 #include <any>
 
 namespace openai_agents {
@@ -41,6 +45,20 @@ public:
         SessionFactory::SessionType target_type = SessionFactory::SessionType::Auto
     );
     
+    // Streaming export/import; items are paged through, never held in full.
+    // import_sessions asks make_target for the session to fill for each id.
+    static size_t export_sessions(
+        const std::vector<std::shared_ptr<Session>>& sessions,
+        const std::string& archive_path,
+        const ArchiveOptions& options = ArchiveOptions()
+    );
+    
+    static std::vector<std::shared_ptr<Session>> import_sessions(
+        const std::string& archive_path,
+        const std::function<std::shared_ptr<Session>(const std::string&)>& make_target,
+        size_t batch_size = 500
+    );
+    
     // Session statistics
     struct SessionStats {
         size_t total_items;
@@ -92,6 +110,7 @@ public:
         const std::string& default_sessions_table = "agent_sessions",
         const std::string& default_messages_table = "agent_messages"
     );
+    ~ObservableSessionManager() override;
     
     // Listener management
     void add_listener(std::shared_ptr<SessionEventListener> listener);
@@ -103,22 +122,47 @@ public:
     void remove_session(const std::string& session_id) override;
     void clear_all_sessions() override;
 
+protected:
+    void on_session_expired(const std::string& session_id) override;
+
 private:
     void emit_session_created(const std::string& session_id);
     void emit_session_destroyed(const std::string& session_id);
 };
 
-// Session cache for improved performance
+// Session cache for improved performance. Each segment is an LRU list plus
+// a hash index, so lookups, inserts and evictions are O(1). The list is kept
+// in access order, which also makes it expiry order: expired entries always
+// sit at the tail.
 class SessionCache {
 private:
-    std::map<std::string, std::shared_ptr<Session>> cache_;
-    mutable std::shared_mutex cache_mutex_;
-    size_t max_size_;
-    std::chrono::minutes ttl_;
-    std::map<std::string, std::chrono::system_clock::time_point> access_times_;
+    using Clock = std::chrono::steady_clock;
+    
+    struct Entry {
+        std::string session_id;
+        std::shared_ptr<Session> session;
+        Clock::time_point last_access;
+    };
+    
+    struct alignas(64) Segment {
+        std::list<Entry> lru;  // most recently used first
+        std::unordered_map<std::string, std::list<Entry>::iterator> index;
+        std::mutex mutex;
+    };
+    
+    std::vector<std::unique_ptr<Segment>> segments_;
+    std::atomic<size_t> max_size_;
+    std::atomic<std::chrono::minutes> ttl_;
+    
+    std::atomic<uint64_t> hits_{0};
+    std::atomic<uint64_t> misses_{0};
 
 public:
-    SessionCache(size_t max_size = 100, std::chrono::minutes ttl = std::chrono::minutes(30));
+    SessionCache(
+        size_t max_size = 100,
+        std::chrono::minutes ttl = std::chrono::minutes(30),
+        size_t segment_count = 1
+    );
     
     // Cache operations
     std::shared_ptr<Session> get(const std::string& session_id);
@@ -130,17 +174,17 @@ public:
     void cleanup_expired();
     size_t size() const;
     double hit_rate() const;
+    uint64_t hit_count() const { return hits_.load(std::memory_order_relaxed); }
+    uint64_t miss_count() const { return misses_.load(std::memory_order_relaxed); }
     
     // Configuration
     void set_max_size(size_t max_size) { max_size_ = max_size; }
     void set_ttl(std::chrono::minutes ttl) { ttl_ = ttl; }
 
 private:
-    void evict_oldest();
-    bool is_expired(const std::string& session_id) const;
-    
-    mutable size_t hits_ = 0;
-    mutable size_t misses_ = 0;
+    Segment& segment_for(const std::string& session_id);
+    size_t segment_capacity() const;
+    void evict_expired(Segment& segment, Clock::time_point now);
 };
 
 // Cached session manager
@@ -156,6 +200,7 @@ public:
         const std::string& default_sessions_table = "agent_sessions",
         const std::string& default_messages_table = "agent_messages"
     );
+    ~CachedSessionManager() override;
     
     // Override parent methods to use cache
     std::shared_ptr<Session> get_session(const std::string& session_id) override;
@@ -167,9 +212,14 @@ public:
     SessionCache& get_cache() { return *cache_; }
     void clear_cache() { cache_->clear(); }
     double get_cache_hit_rate() const { return cache_->hit_rate(); }
+
+protected:
+    void on_session_expired(const std::string& session_id) override;
 };
 
-// Session pool for connection reuse
+// Session pool for connection reuse. Released sessions are rebound to the
+// next acquired id instead of being rebuilt, so they keep their open
+// connections and prepared statements; stored history is not touched.
 class SessionPool {
 private:
     std::vector<std::shared_ptr<Session>> available_sessions_;
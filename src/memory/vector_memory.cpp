@@ -0,0 +1,699 @@
+#include "vector_memory.h"
+#include "executor.h"
+#include "../exceptions.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <limits>
+#include <queue>
+
+#if defined(__AVX2__) && defined(__FMA__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace openai_agents {
+namespace memory {
+
+float dot_product(const float* a, const float* b, size_t size) {
+    size_t i = 0;
+    float sum = 0.0f;
+
+#if defined(__AVX2__) && defined(__FMA__)
+    // Four accumulators hide the FMA latency
+    __m256 acc0 = _mm256_setzero_ps();
+    __m256 acc1 = _mm256_setzero_ps();
+    __m256 acc2 = _mm256_setzero_ps();
+    __m256 acc3 = _mm256_setzero_ps();
+    for (; i + 32 <= size; i += 32) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+        acc2 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 16), _mm256_loadu_ps(b + i + 16), acc2);
+        acc3 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i + 24), _mm256_loadu_ps(b + i + 24), acc3);
+    }
+    for (; i + 8 <= size; i += 8) {
+        acc0 = _mm256_fmadd_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+    }
+    __m256 acc = _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3));
+    __m128 half = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+    half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+    sum = _mm_cvtss_f32(half);
+#elif defined(__SSE2__) || defined(_M_X64)
+    __m128 acc0 = _mm_setzero_ps();
+    __m128 acc1 = _mm_setzero_ps();
+    for (; i + 8 <= size; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    __m128 acc = _mm_add_ps(acc0, acc1);
+    acc = _mm_add_ps(acc, _mm_movehl_ps(acc, acc));
+    acc = _mm_add_ss(acc, _mm_shuffle_ps(acc, acc, 1));
+    sum = _mm_cvtss_f32(acc);
+#elif defined(__ARM_NEON)
+    float32x4_t acc0 = vdupq_n_f32(0.0f);
+    float32x4_t acc1 = vdupq_n_f32(0.0f);
+    for (; i + 8 <= size; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    float32x4_t acc = vaddq_f32(acc0, acc1);
+    float32x2_t pair = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    sum = vget_lane_f32(vpadd_f32(pair, pair), 0);
+#endif
+
+    for (; i < size; i++) {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+void normalize_vector(std::vector<float>& vector) {
+    float norm = std::sqrt(dot_product(vector.data(), vector.data(), vector.size()));
+    if (norm > 0.0f) {
+        for (auto& value : vector) {
+            value /= norm;
+        }
+    }
+}
+
+// HashingEmbedder implementation
+HashingEmbedder::HashingEmbedder(size_t dimension) : dimension_(dimension) {
+    if (dimension_ == 0) {
+        throw AgentsException("Embedding dimension must be positive");
+    }
+}
+
+static uint64_t fnv1a(const std::string& text, uint64_t hash = 14695981039346656037ull) {
+    for (unsigned char c : text) {
+        hash ^= c;
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+std::vector<float> HashingEmbedder::embed(const std::string& text) const {
+    std::vector<float> vector(dimension_, 0.0f);
+    auto add = [this, &vector](uint64_t hash, float weight) {
+        // The top bit picks the sign so unrelated words tend to cancel
+        vector[hash % dimension_] += (hash >> 63) ? -weight : weight;
+    };
+
+    std::string word;
+    uint64_t previous = 0;
+    auto flush_word = [&]() {
+        if (word.empty()) return;
+        uint64_t hash = fnv1a(word);
+        add(hash, 1.0f);
+        if (previous != 0) {
+            add(fnv1a(word, previous), 0.5f);
+        }
+        previous = hash;
+        word.clear();
+    };
+    for (unsigned char c : text) {
+        if (std::isalnum(c) || c >= 0x80) {
+            word += static_cast<char>(std::tolower(c));
+        } else {
+            flush_word();
+        }
+    }
+    flush_word();
+
+    normalize_vector(vector);
+    return vector;
+}
+
+// HnswIndex implementation
+HnswIndex::HnswIndex(size_t dimension, const HnswOptions& options)
+    : dimension_(dimension),
+      options_(options),
+      max_links_(std::max<size_t>(options.max_neighbors, 2)),
+      max_base_links_(max_links_ * 2),
+      level_scale_(1.0 / std::log(static_cast<double>(max_links_))),
+      rng_(options.seed) {
+    if (dimension_ == 0) {
+        throw AgentsException("Vector dimension must be positive");
+    }
+}
+
+void HnswIndex::reserve(size_t count) {
+    vectors_.reserve(count * dimension_);
+    labels_.reserve(count);
+    levels_.reserve(count);
+    removed_.reserve(count);
+    base_links_.reserve(count * (max_base_links_ + 1));
+    upper_links_.reserve(count);
+    nodes_by_label_.reserve(count);
+}
+
+uint32_t* HnswIndex::links_of(uint32_t node, int level) {
+    if (level == 0) {
+        return &base_links_[static_cast<size_t>(node) * (max_base_links_ + 1)];
+    }
+    return &upper_links_[node][static_cast<size_t>(level - 1) * (max_links_ + 1)];
+}
+
+const uint32_t* HnswIndex::links_of(uint32_t node, int level) const {
+    return const_cast<HnswIndex*>(this)->links_of(node, level);
+}
+
+int HnswIndex::random_level() {
+    std::uniform_real_distribution<double> uniform(std::numeric_limits<double>::min(), 1.0);
+    double level = -std::log(uniform(rng_)) * level_scale_;
+    return static_cast<int>(std::min(level, 32.0));
+}
+
+// Scratch marks for graph walks, one set per thread. A mark is current
+// only if it equals the walk's epoch, so nothing is cleared between walks.
+namespace {
+struct VisitedMarks {
+    std::vector<uint32_t> marks;
+    uint32_t epoch = 0;
+
+    void start(size_t node_count) {
+        if (marks.size() < node_count) {
+            marks.resize(node_count, 0);
+        }
+        if (++epoch == 0) {
+            std::fill(marks.begin(), marks.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    // True the first time a node is seen in this walk
+    bool visit(uint32_t node) {
+        if (marks[node] == epoch) return false;
+        marks[node] = epoch;
+        return true;
+    }
+};
+
+thread_local VisitedMarks visited_marks;
+} // namespace
+
+uint32_t HnswIndex::greedy_descend(const float* query, uint32_t entry, int from_level, int to_level) const {
+    uint32_t current = entry;
+    float current_distance = distance(query, vector_of(current));
+    for (int level = from_level; level > to_level; level--) {
+        bool moved = true;
+        while (moved) {
+            moved = false;
+            const uint32_t* links = links_of(current, level);
+            for (uint32_t i = 1; i <= links[0]; i++) {
+                float d = distance(query, vector_of(links[i]));
+                if (d < current_distance) {
+                    current_distance = d;
+                    current = links[i];
+                    moved = true;
+                }
+            }
+        }
+    }
+    return current;
+}
+
+std::vector<HnswIndex::Candidate> HnswIndex::search_layer(
+    const float* query,
+    uint32_t entry,
+    size_t ef,
+    int level,
+    const std::function<bool(uint32_t)>& accept
+) const {
+    auto& visited = visited_marks;
+    visited.start(labels_.size());
+
+    // Results are a max-heap so the worst is evicted first; candidates a
+    // min-heap, stored negated, so the closest is expanded first
+    std::priority_queue<Candidate> results;
+    std::priority_queue<Candidate> candidates;
+    float bound = std::numeric_limits<float>::max();
+
+    float entry_distance = distance(query, vector_of(entry));
+    visited.visit(entry);
+    candidates.emplace(-entry_distance, entry);
+    if (!accept || accept(entry)) {
+        results.emplace(entry_distance, entry);
+        bound = entry_distance;
+    }
+
+    while (!candidates.empty()) {
+        auto [negated, node] = candidates.top();
+        if (-negated > bound && results.size() >= ef) {
+            break;
+        }
+        candidates.pop();
+
+        const uint32_t* links = links_of(node, level);
+        for (uint32_t i = 1; i <= links[0]; i++) {
+            uint32_t neighbor = links[i];
+            if (!visited.visit(neighbor)) continue;
+
+            float d = distance(query, vector_of(neighbor));
+            if (results.size() < ef || d < bound) {
+                // Rejected nodes are still walked through, just not returned
+                candidates.emplace(-d, neighbor);
+                if (!accept || accept(neighbor)) {
+                    results.emplace(d, neighbor);
+                    if (results.size() > ef) {
+                        results.pop();
+                    }
+                }
+                if (!results.empty()) {
+                    bound = results.top().first;
+                }
+            }
+        }
+    }
+
+    std::vector<Candidate> found;
+    found.reserve(results.size());
+    while (!results.empty()) {
+        found.push_back(results.top());
+        results.pop();
+    }
+    std::reverse(found.begin(), found.end());
+    return found;
+}
+
+std::vector<HnswIndex::Candidate> HnswIndex::select_neighbors(std::vector<Candidate> candidates, size_t count) const {
+    std::sort(candidates.begin(), candidates.end());
+    if (candidates.size() <= count) {
+        return candidates;
+    }
+
+    // Keep a candidate only if it is closer to the base than to every
+    // neighbor already kept, so links spread out in different directions
+    std::vector<Candidate> selected;
+    selected.reserve(count);
+    for (const auto& candidate : candidates) {
+        bool diverse = true;
+        for (const auto& kept : selected) {
+            if (distance(vector_of(candidate.second), vector_of(kept.second)) < candidate.first) {
+                diverse = false;
+                break;
+            }
+        }
+        if (diverse) {
+            selected.push_back(candidate);
+            if (selected.size() >= count) break;
+        }
+    }
+    return selected;
+}
+
+void HnswIndex::connect(uint32_t node, uint32_t neighbor, int level) {
+    uint32_t* links = links_of(neighbor, level);
+    size_t capacity = link_capacity(level);
+    if (links[0] < capacity) {
+        links[++links[0]] = node;
+        return;
+    }
+
+    // Full: re-pick the neighbor's links from its current ones plus the new node
+    std::vector<Candidate> candidates;
+    candidates.reserve(capacity + 1);
+    const float* base = vector_of(neighbor);
+    for (uint32_t i = 1; i <= links[0]; i++) {
+        candidates.emplace_back(distance(base, vector_of(links[i])), links[i]);
+    }
+    candidates.emplace_back(distance(base, vector_of(node)), node);
+
+    auto selected = select_neighbors(std::move(candidates), capacity);
+    links[0] = static_cast<uint32_t>(selected.size());
+    for (size_t i = 0; i < selected.size(); i++) {
+        links[i + 1] = selected[i].second;
+    }
+}
+
+void HnswIndex::add(uint64_t label, const float* vector) {
+    remove(label);
+
+    if (labels_.size() >= std::numeric_limits<uint32_t>::max()) {
+        throw AgentsException("Vector index is full");
+    }
+    uint32_t node = static_cast<uint32_t>(labels_.size());
+    int level = random_level();
+
+    size_t offset = vectors_.size();
+    vectors_.insert(vectors_.end(), vector, vector + dimension_);
+    float norm = std::sqrt(dot_product(&vectors_[offset], &vectors_[offset], dimension_));
+    if (norm > 0.0f) {
+        for (size_t i = 0; i < dimension_; i++) {
+            vectors_[offset + i] /= norm;
+        }
+    }
+    labels_.push_back(label);
+    levels_.push_back(static_cast<uint8_t>(level));
+    removed_.push_back(0);
+    base_links_.resize(base_links_.size() + max_base_links_ + 1, 0);
+    upper_links_.emplace_back();
+    if (level > 0) {
+        upper_links_.back().assign(static_cast<size_t>(level) * (max_links_ + 1), 0);
+    }
+    nodes_by_label_[label] = node;
+
+    if (entry_point_ < 0) {
+        entry_point_ = node;
+        max_level_ = level;
+        return;
+    }
+
+    const float* point = vector_of(node);
+    uint32_t entry = greedy_descend(point, static_cast<uint32_t>(entry_point_), max_level_, level);
+    for (int layer = std::min(level, max_level_); layer >= 0; layer--) {
+        auto candidates = search_layer(point, entry, options_.ef_construction, layer, nullptr);
+        auto neighbors = select_neighbors(candidates, max_links_);
+
+        uint32_t* links = links_of(node, layer);
+        links[0] = static_cast<uint32_t>(neighbors.size());
+        for (size_t i = 0; i < neighbors.size(); i++) {
+            links[i + 1] = neighbors[i].second;
+            connect(node, neighbors[i].second, layer);
+        }
+        entry = candidates.front().second;
+    }
+
+    if (level > max_level_) {
+        entry_point_ = node;
+        max_level_ = level;
+    }
+}
+
+bool HnswIndex::remove(uint64_t label) {
+    auto it = nodes_by_label_.find(label);
+    if (it == nodes_by_label_.end()) {
+        return false;
+    }
+    removed_[it->second] = 1;
+    nodes_by_label_.erase(it);
+
+    // Tombstones still cost a visit on every walk that reaches them, so
+    // rebuild once they outnumber the allowed share; each rebuild follows
+    // at least that many removals, which keeps its cost amortized
+    if (nodes_by_label_.empty() ||
+        static_cast<double>(removed_count()) > options_.max_removed_fraction * static_cast<double>(labels_.size())) {
+        compact();
+    }
+    return true;
+}
+
+void HnswIndex::compact() {
+    size_t live = size();
+    std::vector<uint64_t> labels;
+    std::vector<float> vectors;
+    labels.reserve(live);
+    vectors.reserve(live * dimension_);
+    for (uint32_t node = 0; node < labels_.size(); node++) {
+        if (!removed_[node]) {
+            labels.push_back(labels_[node]);
+            vectors.insert(vectors.end(), vector_of(node), vector_of(node) + dimension_);
+        }
+    }
+
+    // Fresh buffers so the memory held by tombstones is released
+    vectors_ = {};
+    labels_ = {};
+    levels_ = {};
+    removed_ = {};
+    base_links_ = {};
+    upper_links_ = {};
+    nodes_by_label_ = {};
+    entry_point_ = -1;
+    max_level_ = -1;
+    rebuilds_++;
+
+    reserve(live);
+    for (size_t i = 0; i < live; i++) {
+        add(labels[i], &vectors[i * dimension_]);
+    }
+}
+
+std::vector<VectorMatch> HnswIndex::search(
+    const float* query,
+    size_t k,
+    const std::function<bool(uint64_t)>& accept,
+    size_t ef
+) const {
+    std::vector<VectorMatch> matches;
+    if (k == 0 || nodes_by_label_.empty()) {
+        return matches;
+    }
+
+    std::vector<float> normalized(query, query + dimension_);
+    normalize_vector(normalized);
+    const float* point = normalized.data();
+
+    auto live = [this, &accept](uint32_t node) {
+        return !removed_[node] && (!accept || accept(labels_[node]));
+    };
+    uint32_t entry = greedy_descend(point, static_cast<uint32_t>(entry_point_), max_level_, 0);
+    auto found = search_layer(point, entry, std::max({ef, options_.ef_search, k}), 0, live);
+
+    matches.reserve(std::min(k, found.size()));
+    for (size_t i = 0; i < found.size() && matches.size() < k; i++) {
+        matches.push_back({labels_[found[i].second], found[i].first});
+    }
+    return matches;
+}
+
+std::vector<VectorMatch> HnswIndex::search_exact(const float* query, size_t k, const std::vector<uint64_t>& labels) const {
+    std::vector<float> normalized(query, query + dimension_);
+    normalize_vector(normalized);
+
+    std::vector<VectorMatch> matches;
+    matches.reserve(labels.size());
+    for (uint64_t label : labels) {
+        auto it = nodes_by_label_.find(label);
+        if (it != nodes_by_label_.end()) {
+            matches.push_back({label, distance(normalized.data(), vector_of(it->second))});
+        }
+    }
+
+    auto closer = [](const VectorMatch& a, const VectorMatch& b) { return a.distance < b.distance; };
+    if (matches.size() > k) {
+        std::partial_sort(matches.begin(), matches.begin() + k, matches.end(), closer);
+        matches.resize(k);
+    } else {
+        std::sort(matches.begin(), matches.end(), closer);
+    }
+    return matches;
+}
+
+// VectorMemory implementation
+VectorMemory::VectorMemory(
+    std::shared_ptr<Embedder> embedder,
+    const HnswOptions& options,
+    size_t exact_search_limit
+) : embedder_(std::move(embedder)),
+    index_(embedder_ ? embedder_->dimension() : 0, options),
+    exact_search_limit_(exact_search_limit) {
+}
+
+void VectorMemory::add_items(const std::string& session_id, const std::vector<std::shared_ptr<Item>>& items) {
+    if (items.empty()) return;
+
+    std::vector<std::vector<float>> vectors;
+    vectors.reserve(items.size());
+    for (const auto& item : items) {
+        vectors.push_back(embedder_->embed(item_text(*item)));
+        if (vectors.back().size() != index_.dimension()) {
+            throw AgentsException("Embedder returned a vector of the wrong dimension");
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto& labels = session_labels_[session_id];
+    for (size_t i = 0; i < items.size(); i++) {
+        uint64_t label = next_label_++;
+        index_.add(label, vectors[i].data());
+        entries_[label] = Entry{session_id, items[i]};
+        labels.push_back(label);
+    }
+}
+
+void VectorMemory::pop_item(const std::string& session_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = session_labels_.find(session_id);
+    if (it == session_labels_.end()) return;
+
+    uint64_t label = it->second.back();
+    index_.remove(label);
+    entries_.erase(label);
+    it->second.pop_back();
+    if (it->second.empty()) {
+        session_labels_.erase(it);
+    }
+}
+
+void VectorMemory::remove_session(const std::string& session_id) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    auto it = session_labels_.find(session_id);
+    if (it == session_labels_.end()) return;
+
+    for (uint64_t label : it->second) {
+        index_.remove(label);
+        entries_.erase(label);
+    }
+    session_labels_.erase(it);
+}
+
+std::vector<float> VectorMemory::embed_query(const std::string& query) const {
+    auto vector = embedder_->embed(query);
+    if (vector.size() != index_.dimension()) {
+        throw AgentsException("Embedder returned a vector of the wrong dimension");
+    }
+    return vector;
+}
+
+std::vector<RelevantItem> VectorMemory::to_results(const std::vector<VectorMatch>& matches) const {
+    std::vector<RelevantItem> results;
+    results.reserve(matches.size());
+    for (const auto& match : matches) {
+        const auto& entry = entries_.at(match.label);
+        results.push_back({entry.session_id, entry.item, 1.0f - match.distance, match.label});
+    }
+    return results;
+}
+
+std::vector<RelevantItem> VectorMemory::search(const std::string& query, size_t k) const {
+    auto vector = embed_query(query);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return to_results(index_.search(vector.data(), k));
+}
+
+std::vector<RelevantItem> VectorMemory::search_session(
+    const std::string& session_id,
+    const std::string& query,
+    size_t k
+) const {
+    auto vector = embed_query(query);
+
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = session_labels_.find(session_id);
+    if (it == session_labels_.end() || k == 0) {
+        return {};
+    }
+    const auto& labels = it->second;
+
+    // A small session is cheaper to scan than to filter a graph walk for
+    if (labels.size() <= exact_search_limit_) {
+        return to_results(index_.search_exact(vector.data(), k, labels));
+    }
+
+    auto matches = index_.search(vector.data(), k, [this, &session_id](uint64_t label) {
+        return entries_.at(label).session_id == session_id;
+    });
+    if (matches.size() < k) {
+        // The walk found too few of this session's items; fall back to exact
+        matches = index_.search_exact(vector.data(), k, labels);
+    }
+    return to_results(matches);
+}
+
+size_t VectorMemory::size() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    return index_.size();
+}
+
+size_t VectorMemory::get_session_item_count(const std::string& session_id) const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    auto it = session_labels_.find(session_id);
+    return it != session_labels_.end() ? it->second.size() : 0;
+}
+
+VectorIndexStats VectorMemory::get_index_stats() const {
+    std::shared_lock<std::shared_mutex> lock(mutex_);
+    VectorIndexStats stats;
+    stats.live_vectors = index_.size();
+    stats.removed_vectors = index_.removed_count();
+    stats.rebuilds = index_.rebuild_count();
+    return stats;
+}
+
+void VectorMemory::set_ef_search(size_t ef) {
+    std::unique_lock<std::shared_mutex> lock(mutex_);
+    index_.set_ef_search(ef);
+}
+
+// VectorMemorySession implementation
+VectorMemorySession::VectorMemorySession(std::shared_ptr<Session> backing, std::shared_ptr<VectorMemory> memory)
+    : SessionBase(backing->get_session_id(), get_inline_session_executor()),
+      backing_(std::move(backing)), memory_(std::move(memory)) {
+    // Index history written before this decorator existed
+    if (memory_->get_session_item_count(session_id_) == 0) {
+        std::optional<int64_t> cursor;
+        do {
+            auto page = backing_->scan_sync(cursor);
+            memory_->add_items(session_id_, page.items);
+            cursor = page.next_cursor;
+        } while (cursor);
+    }
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> VectorMemorySession::get_items(std::optional<size_t> limit) {
+    return backing_->get_items(limit);
+}
+
+std::future<void> VectorMemorySession::add_items(const std::vector<std::shared_ptr<Item>>& items) {
+    return submit([this, items]() {
+        backing_->add_items(items).get();
+        memory_->add_items(session_id_, items);
+    });
+}
+
+std::future<std::shared_ptr<Item>> VectorMemorySession::pop_item() {
+    return submit([this]() {
+        auto item = backing_->pop_item().get();
+        if (item) {
+            memory_->pop_item(session_id_);
+        }
+        return item;
+    });
+}
+
+std::future<void> VectorMemorySession::clear_session() {
+    return submit([this]() {
+        backing_->clear_session().get();
+        memory_->remove_session(session_id_);
+    });
+}
+
+std::future<ItemPage> VectorMemorySession::scan(std::optional<int64_t> after_id, size_t batch_size) {
+    return backing_->scan(after_id, batch_size);
+}
+
+std::future<ItemPage> VectorMemorySession::scan_reverse(std::optional<int64_t> before_id, size_t batch_size) {
+    return backing_->scan_reverse(before_id, batch_size);
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> VectorMemorySession::get_items_within_budget(size_t max_tokens) {
+    return backing_->get_items_within_budget(max_tokens);
+}
+
+std::future<std::vector<std::shared_ptr<Item>>> VectorMemorySession::get_relevant_items(
+    const std::string& query,
+    size_t limit
+) {
+    return submit([this, query, limit]() {
+        auto matches = memory_->search_session(session_id_, query, limit);
+
+        // Back into conversation order
+        std::sort(matches.begin(), matches.end(), [](const RelevantItem& a, const RelevantItem& b) {
+            return a.id < b.id;
+        });
+        std::vector<std::shared_ptr<Item>> items;
+        items.reserve(matches.size());
+        for (auto& match : matches) {
+            items.push_back(std::move(match.item));
+        }
+        return items;
+    });
+}
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
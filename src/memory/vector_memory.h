@@ -0,0 +1,273 @@
+#pragma once
+
+/**
+ * Vector-similarity memory for sessions
+ *
+ * An Embedder turns item text into a fixed-dimension vector. HnswIndex
+ * keeps those vectors in a hierarchical navigable small world graph and
+ * answers approximate nearest-neighbour queries by cosine similarity,
+ * visiting a few hundred vectors rather than all of them. VectorMemory
+ * pairs the two with the indexed items, and VectorMemorySession puts it
+ * in front of any session so get_relevant_items() returns the history
+ * most similar to a query instead of the most recent.
+ *
+ * Distances use a dot product kernel built for the target instruction
+ * set (AVX2 with FMA, SSE2 or NEON, with a scalar fallback).
+ */
+
+#include "session.h"
+#include <cstdint>
+#include <random>
+#include <unordered_map>
+
+namespace openai_agents {
+namespace memory {
+
+// Dot product of two float vectors of length size
+float dot_product(const float* a, const float* b, size_t size);
+
+// Scales a vector to unit length; zero vectors are left as they are
+void normalize_vector(std::vector<float>& vector);
+
+// Maps text to a fixed-dimension vector
+class Embedder {
+public:
+    virtual ~Embedder() = default;
+
+    virtual size_t dimension() const = 0;
+    virtual std::vector<float> embed(const std::string& text) const = 0;
+};
+
+// Deterministic local embedder: hashes lowercase words and word pairs into
+// signed buckets. Captures shared vocabulary, not meaning, which is enough
+// for tests and for setups without an embedding model.
+class HashingEmbedder : public Embedder {
+private:
+    size_t dimension_;
+
+public:
+    explicit HashingEmbedder(size_t dimension = 256);
+
+    size_t dimension() const override { return dimension_; }
+    std::vector<float> embed(const std::string& text) const override;
+};
+
+struct HnswOptions {
+    // Links per node on the upper layers; the base layer keeps twice as many
+    size_t max_neighbors = 16;
+    // Candidate list size while inserting and while searching
+    size_t ef_construction = 200;
+    size_t ef_search = 64;
+    uint64_t seed = 42;
+    // The graph is rebuilt from its live vectors once removed ones make up
+    // more than this fraction of its nodes; 1 or more never rebuilds
+    double max_removed_fraction = 0.5;
+};
+
+struct VectorMatch {
+    uint64_t label;
+    float distance;  // cosine distance, 1 - similarity
+};
+
+// Approximate nearest-neighbour index over unit vectors. Removed labels
+// stay in the graph as tombstones so it stays connected; they are skipped
+// in results, and the graph is rebuilt without them once they pass
+// max_removed_fraction. Not thread-safe: concurrent searches are fine, but
+// adds and removes need exclusive access.
+class HnswIndex {
+private:
+    size_t dimension_;
+    HnswOptions options_;
+    size_t max_links_;       // upper layers
+    size_t max_base_links_;  // layer 0
+    double level_scale_;
+    std::mt19937_64 rng_;
+
+    // Node data by node id; vectors are normalized copies
+    std::vector<float> vectors_;
+    std::vector<uint64_t> labels_;
+    std::vector<uint8_t> levels_;
+    std::vector<uint8_t> removed_;
+    // Layer 0 links: per node, a count followed by max_base_links_ slots
+    std::vector<uint32_t> base_links_;
+    // Upper layer links, same layout per layer, only for nodes above layer 0
+    std::vector<std::vector<uint32_t>> upper_links_;
+
+    std::unordered_map<uint64_t, uint32_t> nodes_by_label_;
+    int64_t entry_point_ = -1;
+    int max_level_ = -1;
+    uint64_t rebuilds_ = 0;
+
+public:
+    explicit HnswIndex(size_t dimension, const HnswOptions& options = HnswOptions());
+
+    // Adds a vector of dimension() floats; an existing label is replaced
+    void add(uint64_t label, const float* vector);
+    bool remove(uint64_t label);
+    bool contains(uint64_t label) const { return nodes_by_label_.count(label) > 0; }
+
+    // Up to k nearest live labels, closest first. accept, if given, limits
+    // results to the labels it returns true for.
+    std::vector<VectorMatch> search(
+        const float* query,
+        size_t k,
+        const std::function<bool(uint64_t)>& accept = nullptr,
+        size_t ef = 0
+    ) const;
+
+    // Exact k nearest among the given labels, for small candidate sets
+    std::vector<VectorMatch> search_exact(const float* query, size_t k, const std::vector<uint64_t>& labels) const;
+
+    // Rebuilds the graph from the live vectors, dropping every tombstone
+    void compact();
+
+    size_t size() const { return nodes_by_label_.size(); }
+    size_t node_count() const { return labels_.size(); }
+    size_t removed_count() const { return labels_.size() - nodes_by_label_.size(); }
+    uint64_t rebuild_count() const { return rebuilds_; }
+    size_t dimension() const { return dimension_; }
+    void reserve(size_t count);
+
+    const HnswOptions& get_options() const { return options_; }
+    void set_ef_search(size_t ef) { options_.ef_search = ef; }
+
+private:
+    using Candidate = std::pair<float, uint32_t>;
+
+    const float* vector_of(uint32_t node) const { return &vectors_[static_cast<size_t>(node) * dimension_]; }
+    float distance(const float* a, const float* b) const { return 1.0f - dot_product(a, b, dimension_); }
+
+    uint32_t* links_of(uint32_t node, int level);
+    const uint32_t* links_of(uint32_t node, int level) const;
+    size_t link_capacity(int level) const { return level == 0 ? max_base_links_ : max_links_; }
+
+    int random_level();
+    uint32_t greedy_descend(const float* query, uint32_t entry, int from_level, int to_level) const;
+    std::vector<Candidate> search_layer(
+        const float* query,
+        uint32_t entry,
+        size_t ef,
+        int level,
+        const std::function<bool(uint32_t)>& accept
+    ) const;
+    std::vector<Candidate> select_neighbors(std::vector<Candidate> candidates, size_t count) const;
+    void connect(uint32_t node, uint32_t neighbor, int level);
+};
+
+struct VectorIndexStats {
+    size_t live_vectors = 0;
+    size_t removed_vectors = 0;  // tombstones still in the graph
+    uint64_t rebuilds = 0;
+};
+
+// One retrieved item; score is the cosine similarity to the query
+struct RelevantItem {
+    std::string session_id;
+    std::shared_ptr<Item> item;
+    float score;
+    uint64_t id;  // grows with insertion, so it orders a session's items
+};
+
+// Embedded items from any number of sessions in one index. Thread-safe;
+// embedding runs outside the lock.
+class VectorMemory {
+private:
+    struct Entry {
+        std::string session_id;
+        std::shared_ptr<Item> item;
+    };
+
+    std::shared_ptr<Embedder> embedder_;
+    HnswIndex index_;
+    size_t exact_search_limit_;
+
+    std::unordered_map<uint64_t, Entry> entries_;
+    // Labels grow with insertion, so each list is in conversation order
+    std::unordered_map<std::string, std::vector<uint64_t>> session_labels_;
+    uint64_t next_label_ = 0;
+    mutable std::shared_mutex mutex_;
+
+public:
+    // Sessions with at most exact_search_limit items are searched exactly
+    // rather than through the graph
+    explicit VectorMemory(
+        std::shared_ptr<Embedder> embedder,
+        const HnswOptions& options = HnswOptions(),
+        size_t exact_search_limit = 4096
+    );
+
+    void add_items(const std::string& session_id, const std::vector<std::shared_ptr<Item>>& items);
+    // Drops the session's newest item, mirroring Session::pop_item
+    void pop_item(const std::string& session_id);
+    void remove_session(const std::string& session_id);
+
+    // Most similar items across all sessions, or within one, best first
+    std::vector<RelevantItem> search(const std::string& query, size_t k) const;
+    std::vector<RelevantItem> search_session(const std::string& session_id, const std::string& query, size_t k) const;
+
+    size_t size() const;
+    size_t get_session_item_count(const std::string& session_id) const;
+    VectorIndexStats get_index_stats() const;
+    const std::shared_ptr<Embedder>& get_embedder() const { return embedder_; }
+
+    // Search breadth; larger values trade speed for recall
+    void set_ef_search(size_t ef);
+
+private:
+    std::vector<float> embed_query(const std::string& query) const;
+    std::vector<RelevantItem> to_results(const std::vector<VectorMatch>& matches) const;
+};
+
+// Decorator that indexes every item written through it into a shared
+// VectorMemory and answers get_relevant_items() from it. Everything else
+// goes to the backing session. Items already stored in the backing
+// session are indexed when the decorator is created.
+class VectorMemorySession : public SessionBase {
+private:
+    std::shared_ptr<Session> backing_;
+    std::shared_ptr<VectorMemory> memory_;
+
+public:
+    VectorMemorySession(std::shared_ptr<Session> backing, std::shared_ptr<VectorMemory> memory);
+
+    // Session interface implementation
+    std::future<std::vector<std::shared_ptr<Item>>> get_items(
+        std::optional<size_t> limit = std::nullopt
+    ) override;
+
+    std::future<void> add_items(
+        const std::vector<std::shared_ptr<Item>>& items
+    ) override;
+
+    std::future<std::shared_ptr<Item>> pop_item() override;
+    std::future<void> clear_session() override;
+
+    std::future<ItemPage> scan(
+        std::optional<int64_t> after_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+
+    std::future<ItemPage> scan_reverse(
+        std::optional<int64_t> before_id = std::nullopt,
+        size_t batch_size = 100
+    ) override;
+
+    std::future<std::vector<std::shared_ptr<Item>>> get_items_within_budget(size_t max_tokens) override;
+    std::future<std::vector<std::shared_ptr<Item>>> get_relevant_items(const std::string& query, size_t limit) override;
+
+    size_t get_item_count() const override { return backing_->get_item_count(); }
+    SessionSummary get_summary() const override { return backing_->get_summary(); }
+
+    // Metadata and timestamps live on the backing session
+    std::map<std::string, std::any> get_metadata() const override { return backing_->get_metadata(); }
+    void set_metadata(const std::string& key, const std::any& value) override { backing_->set_metadata(key, value); }
+    bool has_metadata(const std::string& key) const override { return backing_->has_metadata(key); }
+    std::chrono::system_clock::time_point get_created_at() const override { return backing_->get_created_at(); }
+    std::chrono::system_clock::time_point get_updated_at() const override { return backing_->get_updated_at(); }
+
+    const std::shared_ptr<Session>& get_backing_session() const { return backing_; }
+    const std::shared_ptr<VectorMemory>& get_memory() const { return memory_; }
+};
+
+} // namespace memory
+} // namespace openai_agents
\ No newline at end of file
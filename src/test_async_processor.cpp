@@ -0,0 +1,160 @@
+#include "tracing/processor_interface.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents::tracing;
+
+// Records what reaches it; optionally slow, optionally failing on traces
+class RecordingProcessor : public TracingProcessor {
+public:
+    struct Seen {
+        std::mutex mutex;
+        std::vector<int> order;
+        size_t spans = 0;
+        size_t traces = 0;
+    };
+
+    std::shared_ptr<Seen> seen = std::make_shared<Seen>();
+    std::chrono::microseconds delay{0};
+    bool fail_traces = false;
+
+    void process_span(const nlohmann::json& span_data) override {
+        process_spans_batch({span_data});
+    }
+
+    void process_spans_batch(const std::vector<nlohmann::json>& spans_data) override {
+        if (delay.count() > 0) std::this_thread::sleep_for(delay);
+        std::lock_guard<std::mutex> lock(seen->mutex);
+        for (const auto& span : spans_data) seen->order.push_back(span["n"].get<int>());
+        seen->spans += spans_data.size();
+    }
+
+    void process_trace(const nlohmann::json& trace_data) override {
+        if (fail_traces) throw std::runtime_error("export failed");
+        std::lock_guard<std::mutex> lock(seen->mutex);
+        seen->order.push_back(trace_data["n"].get<int>());
+        seen->traces++;
+    }
+};
+
+static nlohmann::json record(int n) {
+    return nlohmann::json{{"n", n}};
+}
+
+int main() {
+    std::cout << "Testing async tracing processor" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing flush delivers everything in order..." << std::endl;
+        {
+            auto inner = std::make_unique<RecordingProcessor>();
+            auto seen = inner->seen;
+            AsyncProcessorOptions options;
+            options.max_delay = std::chrono::seconds(10);
+            AsyncProcessor processor(std::move(inner), options);
+            for (int i = 0; i < 1000; i++) {
+                if (i % 100 == 0) {
+                    processor.process_trace(record(i));
+                } else {
+                    processor.process_span(record(i));
+                }
+            }
+            processor.flush();
+            assert(processor.get_enqueued_count() == 1000);
+            assert(processor.get_exported_count() == 1000);
+            assert(seen->spans == 990 && seen->traces == 10);
+            for (int i = 0; i < 1000; i++) assert(seen->order[i] == i);
+        }
+        std::cout << "   ✓ Flush waits for every queued record" << std::endl;
+
+        std::cout << "\n2. Testing the drop policy counts what it sheds..." << std::endl;
+        {
+            auto inner = std::make_unique<RecordingProcessor>();
+            inner->delay = std::chrono::microseconds(500);
+            auto seen = inner->seen;
+            AsyncProcessorOptions options;
+            options.queue_capacity = 8;
+            options.max_batch_size = 2;
+            AsyncProcessor processor(std::move(inner), options);
+            for (int i = 0; i < 500; i++) processor.process_span(record(i));
+            processor.flush();
+            assert(processor.get_dropped_count() > 0);
+            assert(processor.get_enqueued_count() + processor.get_dropped_count() == 500);
+            assert(processor.get_exported_count() == processor.get_enqueued_count());
+            assert(seen->spans == processor.get_exported_count());
+        }
+        std::cout << "   ✓ Enqueued plus dropped covers every record" << std::endl;
+
+        std::cout << "\n3. Testing the block policy waits for room..." << std::endl;
+        {
+            auto inner = std::make_unique<RecordingProcessor>();
+            inner->delay = std::chrono::microseconds(200);
+            auto seen = inner->seen;
+            AsyncProcessorOptions options;
+            options.queue_capacity = 4;
+            options.max_batch_size = 2;
+            options.max_delay = std::chrono::seconds(10);
+            options.overflow_policy = OverflowPolicy::Block;
+            AsyncProcessor processor(std::move(inner), options);
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 4; t++) {
+                producers.emplace_back([&processor, t]() {
+                    for (int i = 0; i < 200; i++) processor.process_span(record(t * 1000 + i));
+                });
+            }
+            for (auto& producer : producers) producer.join();
+            processor.flush();
+            assert(processor.get_dropped_count() == 0);
+            assert(processor.get_exported_count() == 800 && seen->spans == 800);
+        }
+        std::cout << "   ✓ Blocked producers lose nothing, even with a long max_delay" << std::endl;
+
+        std::cout << "\n4. Testing shutdown exports every accepted record..." << std::endl;
+        for (int round = 0; round < 20; round++) {
+            auto inner = std::make_unique<RecordingProcessor>();
+            auto seen = inner->seen;
+            AsyncProcessorOptions options;
+            options.queue_capacity = 64;
+            options.overflow_policy = round % 2 ? OverflowPolicy::Block : OverflowPolicy::Drop;
+            AsyncProcessor processor(std::move(inner), options);
+            std::atomic<int> sent{0};
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 3; t++) {
+                producers.emplace_back([&processor, &sent]() {
+                    for (int i = 0; i < 2000; i++) {
+                        processor.process_span(record(i));
+                        sent++;
+                    }
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::microseconds(200));
+            processor.shutdown();
+            for (auto& producer : producers) producer.join();
+            assert(processor.get_status()["status"] == "stopped");
+            assert(processor.get_enqueued_count() + processor.get_dropped_count() == 6000);
+            assert(processor.get_exported_count() == processor.get_enqueued_count());
+            assert(seen->spans == processor.get_enqueued_count());
+        }
+        std::cout << "   ✓ Records pushed while stopping are not stranded" << std::endl;
+
+        std::cout << "\n5. Testing export failures are counted..." << std::endl;
+        {
+            auto inner = std::make_unique<RecordingProcessor>();
+            inner->fail_traces = true;
+            AsyncProcessor processor(std::move(inner));
+            processor.process_trace(record(1));
+            processor.process_span(record(2));
+            processor.flush();
+            assert(processor.get_failed_count() == 1 && processor.get_exported_count() == 1);
+        }
+        std::cout << "   ✓ Failed records still count as handled" << std::endl;
+
+        std::cout << "\n✅ All async processor tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
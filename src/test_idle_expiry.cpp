@@ -0,0 +1,150 @@
+#include "memory/util.h"
+#include "memory/timer_wheel.h"
+#include <iostream>
+#include <cassert>
+#include <atomic>
+#include <thread>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+template<typename Predicate>
+static bool eventually(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+class CountingListener : public SessionEventListener {
+public:
+    std::atomic<int> destroyed{0};
+    void on_session_destroyed(const std::string&) override { destroyed++; }
+};
+
+int main() {
+    std::cout << "Testing idle session expiry" << std::endl;
+    std::cout << "===========================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing the timer wheel..." << std::endl;
+        TimerWheel wheel;
+        wheel.schedule("soon", 3);
+        wheel.schedule("later", 100000);
+        wheel.schedule("pushed", 2);
+        wheel.schedule("pushed", 70);
+        wheel.schedule("cancelled", 1);
+        assert(wheel.cancel("cancelled") && !wheel.cancel("cancelled"));
+        std::vector<std::string> expired;
+        wheel.advance(2, expired);
+        assert(expired.empty());
+        wheel.advance(3, expired);
+        assert(expired == std::vector<std::string>{"soon"});
+        expired.clear();
+        wheel.advance(69, expired);
+        assert(expired.empty() && wheel.contains("pushed"));
+        wheel.advance(70, expired);
+        assert(expired == std::vector<std::string>{"pushed"});
+        expired.clear();
+        wheel.advance(100000, expired);
+        assert(expired == std::vector<std::string>{"later"} && wheel.size() == 0);
+        std::cout << "   ✓ Timers fire once, at their latest deadline" << std::endl;
+
+        IdleExpiryOptions options;
+        options.idle_timeout = std::chrono::milliseconds(40);
+        options.resolution = std::chrono::milliseconds(2);
+
+        std::cout << "\n2. Testing idle sessions are dropped and used ones kept..." << std::endl;
+        {
+            SessionManager manager;
+            manager.enable_idle_expiry(options);
+            manager.create_memory_session("idle");
+            manager.create_memory_session("busy");
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(200);
+            while (std::chrono::steady_clock::now() < until) {
+                assert(manager.get_session("busy"));
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            }
+            assert(!manager.has_session("idle"));
+            assert(manager.has_session("busy"));
+            assert(manager.get_idle_expiry_stats().expired_sessions == 1);
+            assert(eventually([&]() { return !manager.has_session("busy"); }));
+            assert(manager.get_idle_expiry_stats().tracked_sessions == 0);
+        }
+        std::cout << "   ✓ Only sessions left alone for the timeout expire" << std::endl;
+
+        std::cout << "\n3. Testing a failed persist keeps the session..." << std::endl;
+        {
+            std::atomic<int> attempts{0};
+            IdleExpiryOptions failing = options;
+            failing.persist = [&attempts](const std::shared_ptr<Session>&) {
+                if (attempts++ == 0) throw std::runtime_error("disk full");
+            };
+            SessionManager manager;
+            manager.enable_idle_expiry(failing);
+            manager.create_memory_session("retry");
+            assert(eventually([&]() { return !manager.has_session("retry"); }));
+            assert(attempts == 2);
+            auto stats = manager.get_idle_expiry_stats();
+            assert(stats.persist_failures == 1 && stats.expired_sessions == 1);
+        }
+        std::cout << "   ✓ The session is retried after another timeout" << std::endl;
+
+        std::cout << "\n4. Testing subclasses see expired sessions..." << std::endl;
+        {
+            auto listener = std::make_shared<CountingListener>();
+            ObservableSessionManager observable;
+            observable.add_listener(listener);
+            observable.enable_idle_expiry(options);
+            observable.create_session("observed");
+            assert(eventually([&]() { return listener->destroyed == 1; }));
+            assert(!observable.has_session("observed"));
+
+            CachedSessionManager cached;
+            cached.enable_idle_expiry(options);
+            auto session = cached.get_or_create_session("cached");
+            assert(cached.get_cache().get("cached") == session);
+            assert(eventually([&]() { return !cached.has_session("cached"); }));
+            assert(cached.get_cache().get("cached") == nullptr);
+            assert(cached.get_session("cached") == nullptr);
+        }
+        std::cout << "   ✓ Listeners are told and caches are emptied" << std::endl;
+
+        std::cout << "\n5. Testing lookups racing the sweeper..." << std::endl;
+        {
+            IdleExpiryOptions tight;
+            tight.idle_timeout = std::chrono::milliseconds(2);
+            tight.resolution = std::chrono::milliseconds(1);
+            SessionManager manager;
+            manager.enable_idle_expiry(tight);
+            std::atomic<bool> done{false};
+            std::vector<std::thread> threads;
+            for (int t = 0; t < 4; t++) {
+                threads.emplace_back([&manager, &done, t]() {
+                    for (int i = 0; !done; i++) {
+                        std::string id = "race_" + std::to_string(t) + "_" + std::to_string(i % 64);
+                        auto session = manager.get_or_create_session(id);
+                        assert(session && session->get_session_id() == id);
+                        auto again = manager.get_session(id);
+                        assert(!again || again == session);
+                    }
+                });
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            done = true;
+            for (auto& thread : threads) thread.join();
+            assert(eventually([&]() { return manager.get_session_count() == 0; }));
+            assert(manager.get_idle_expiry_stats().expired_sessions > 0);
+        }
+        std::cout << "   ✓ Every session handed out stays consistent" << std::endl;
+
+        std::cout << "\n✅ All idle expiry tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,89 @@
+#include "memory/item_codec.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+template<typename F>
+static bool throws(F&& func) {
+    try {
+        func();
+    } catch (const std::exception&) {
+        return true;
+    }
+    return false;
+}
+
+int main() {
+    std::cout << "Testing item codec" << std::endl;
+    std::cout << "==================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing round trip of every item type..." << std::endl;
+        std::map<std::string, std::any> nested{{"depth", 2}, {"tags", std::vector<std::any>{std::string("a"), true}}};
+        std::map<std::string, std::any> metadata{
+            {"count", 42}, {"big", int64_t(1) << 40}, {"ratio", 0.5}, {"flag", false},
+            {"label", std::string("x")}, {"nested", nested}, {"missing", std::any()}
+        };
+        auto message = ItemCodec::decode(ItemCodec::encode(MessageItem("assistant", "hello", std::string("bot"), metadata)));
+        auto& decoded = static_cast<MessageItem&>(*message);
+        assert(decoded.get_role() == "assistant");
+        assert(decoded.get_content() == "hello");
+        assert(decoded.get_name() == std::optional<std::string>("bot"));
+        const auto& meta = decoded.get_metadata();
+        assert(std::any_cast<int>(meta.at("count")) == 42);
+        assert(std::any_cast<int64_t>(meta.at("big")) == (int64_t(1) << 40));
+        assert(std::any_cast<double>(meta.at("ratio")) == 0.5);
+        assert(std::any_cast<bool>(meta.at("flag")) == false);
+        assert(std::any_cast<std::string>(meta.at("label")) == "x");
+        assert(!meta.at("missing").has_value());
+        auto inner = std::any_cast<std::map<std::string, std::any>>(meta.at("nested"));
+        assert(std::any_cast<int>(inner.at("depth")) == 2);
+        auto tags = std::any_cast<std::vector<std::any>>(inner.at("tags"));
+        assert(tags.size() == 2 && std::any_cast<bool>(tags[1]));
+
+        auto call = ItemCodec::decode(ItemCodec::encode(ToolCallItem("call_1", "lookup", "{\"q\":1}")));
+        assert(static_cast<ToolCallItem&>(*call).get_arguments() == "{\"q\":1}");
+        auto response = ItemCodec::decode(ItemCodec::encode(ToolResponseItem("call_1", "failed", true)));
+        assert(static_cast<ToolResponseItem&>(*response).is_error());
+        auto file = ItemCodec::decode(ItemCodec::encode(FileItem("/tmp/a.txt", "a.txt", std::nullopt, size_t(7))));
+        assert(static_cast<FileItem&>(*file).get_size() == std::optional<size_t>(7));
+        auto custom = ItemCodec::decode(ItemCodec::encode(CustomItem("note", {{"k", std::string("v")}})));
+        assert(static_cast<CustomItem&>(*custom).get_type_name() == "note");
+        std::cout << "   ✓ Items and metadata survive a round trip" << std::endl;
+
+        std::cout << "\n2. Testing unsupported value types..." << std::endl;
+        struct Opaque {};
+        assert(throws([] { ItemCodec::encode(MessageItem("user", "x", std::nullopt, {{"opaque", Opaque{}}})); }));
+        std::cout << "   ✓ Unsupported values are rejected, not dropped" << std::endl;
+
+        std::cout << "\n3. Testing nesting limits..." << std::endl;
+        std::map<std::string, std::any> deep;
+        for (int i = 0; i < 100; i++) {
+            deep = {{"child", deep}};
+        }
+        assert(throws([&deep] { ItemCodec::encode(MessageItem("user", "x", std::nullopt, deep)); }));
+
+        // version, Message tag, empty role and content, no name, then maps
+        // nested far past the limit
+        std::string crafted("\x01\x00\x00\x00\x00", 5);
+        for (int i = 0; i < 100000; i++) {
+            crafted += std::string("\x01\x00\x06", 3);
+        }
+        assert(throws([&crafted] { ItemCodec::decode(crafted); }));
+        std::cout << "   ✓ Deeply nested values are rejected" << std::endl;
+
+        std::cout << "\n4. Testing truncated records..." << std::endl;
+        auto record = ItemCodec::encode(MessageItem("user", "truncate me"));
+        assert(throws([&record] { ItemCodec::decode(record.data(), record.size() - 3); }));
+        std::cout << "   ✓ Truncated records are rejected" << std::endl;
+
+        std::cout << "\n✅ All item codec tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,73 @@
+#include "item_serializer.h"
+#include "item_store.h"
+#include <nlohmann/json.hpp>
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+
+int main() {
+    std::cout << "Testing item serializer" << std::endl;
+    std::cout << "=======================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing JSON output..." << std::endl;
+        ItemSerializer serializer;
+        MessageItem message("user", "say \"hi\"\n\ttab \x01", std::string("bob"),
+                            {{"n", 3}, {"ok", true}, {"s", std::string("v")}});
+        auto json = nlohmann::json::parse(serializer.serialize(message));
+        assert(json["type"] == "message");
+        assert(json["role"] == "user");
+        assert(json["content"] == "say \"hi\"\n\ttab \x01");
+        assert(json["name"] == "bob");
+        assert(json["metadata"]["n"] == 3 && json["metadata"]["ok"] == true);
+
+        auto call = nlohmann::json::parse(serializer.serialize(ToolCallItem("call_1", "lookup", "{\"q\":1}")));
+        assert(call["type"] == "tool_call" && call["function_name"] == "lookup");
+        std::cout << "   ✓ Items serialize to valid, escaped JSON" << std::endl;
+
+        std::cout << "\n2. Testing chat message output..." << std::endl;
+        std::vector<std::shared_ptr<Item>> history{
+            std::make_shared<MessageItem>("user", "weather?"),
+            std::make_shared<ToolCallItem>("call_1", "get_weather", "{\"city\":\"Oslo\"}"),
+            std::make_shared<ToolResponseItem>("call_1", "rain"),
+        };
+        ItemSerializer chat(ItemFormat::ChatMessage);
+        auto messages = nlohmann::json::parse(chat.serialize_list(history));
+        assert(messages.is_array());
+        bool saw_call = false;
+        bool saw_tool = false;
+        for (const auto& entry : messages) {
+            if (entry.contains("tool_calls")) {
+                saw_call = true;
+                assert(entry["role"] == "assistant");
+                assert(entry["tool_calls"][0]["id"] == "call_1");
+                assert(entry["tool_calls"][0]["function"]["name"] == "get_weather");
+            }
+            if (entry["role"] == "tool") {
+                saw_tool = true;
+                assert(entry["tool_call_id"] == "call_1" && entry["content"] == "rain");
+            }
+        }
+        assert(saw_call && saw_tool);
+        assert(messages[0]["role"] == "user" && messages[0]["content"] == "weather?");
+        std::cout << "   ✓ Tool calls and responses map to chat messages" << std::endl;
+
+        std::cout << "\n3. Testing stored views serialize the same way..." << std::endl;
+        ItemStore store;
+        store.add_items(history);
+        ItemSerializer from_store(ItemFormat::ChatMessage);
+        assert(from_store.serialize_list(store) == chat.serialize_list(history));
+        ItemSerializer one;
+        std::string direct = one.serialize(*history[1]);
+        assert(one.serialize(store[1]) == direct);
+        std::cout << "   ✓ Items and item views produce identical output" << std::endl;
+
+        std::cout << "\n✅ All item serializer tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,73 @@
+#include "item_store.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+
+int main() {
+    std::cout << "Testing arena-backed item store" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing records and views..." << std::endl;
+        ItemStore store(256);
+        store.add_message("user", "hello", std::string_view("alice"));
+        store.add_tool_call("call_1", "lookup", "{\"q\":\"x\"}");
+        store.add_tool_response("call_1", "found", false);
+        store.add_item(FileItem("/tmp/report.pdf", "report.pdf", std::string("application/pdf"), size_t(12)));
+        assert(store.size() == 4);
+        assert(store[0].get_type() == ItemType::Message);
+        assert(store[0].get_role() == "user" && store[0].get_content() == "hello");
+        assert(store[1].get_if<ToolCallRecord>()->function_name == "lookup");
+        assert(store[2].get_content() == "found");
+        assert(store.back().get_if<FileRecord>()->size == std::optional<size_t>(12));
+        assert(store.count(ItemType::Message) == 1);
+
+        size_t visited = 0;
+        for (auto view : store) {
+            visited++;
+            assert(!view.to_string().empty());
+        }
+        assert(visited == 4);
+        std::cout << "   ✓ Views read the flattened fields" << std::endl;
+
+        std::cout << "\n2. Testing conversion back to items..." << std::endl;
+        auto original = std::make_shared<MessageItem>("assistant", "with metadata", std::nullopt,
+                                                      std::map<std::string, std::any>{{"k", 1}});
+        store.add_item(original);
+        assert(store.back().get_source() == original.get());
+        auto items = store.to_items();
+        assert(items.size() == 5);
+        auto message = std::static_pointer_cast<MessageItem>(items[0]);
+        assert(message->get_content() == "hello" && message->get_name() == std::optional<std::string>("alice"));
+        assert(std::static_pointer_cast<MessageItem>(items[4])->get_metadata().count("k") == 1);
+        for (size_t i = 0; i < items.size(); i++) {
+            assert(items[i]->to_string() == store[i].to_string());
+        }
+        std::cout << "   ✓ Items round-trip with text and unflattened fields" << std::endl;
+
+        std::cout << "\n3. Testing arena growth, pop and clear..." << std::endl;
+        std::string big(1000, 'z');
+        for (int i = 0; i < 50; i++) {
+            store.add_message("user", big);
+        }
+        assert(store.arena_bytes_used() >= 50 * big.size());
+        assert(store.arena_bytes_reserved() >= store.arena_bytes_used());
+        // Earlier views stay valid as the arena grows
+        assert(store[0].get_content() == "hello");
+        store.pop_back();
+        assert(store.size() == 54);
+        store.clear();
+        assert(store.empty() && store.arena_bytes_used() == 0);
+        store.add_message("user", "again");
+        assert(store[0].get_content() == "again");
+        std::cout << "   ✓ Stored strings stay put until the store is cleared" << std::endl;
+
+        std::cout << "\n✅ All item store tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,94 @@
+#include "memory/log_session.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kLogDir = "test_log_sessions";
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+int main() {
+    std::cout << "Testing append-only log session" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    std::string path = LogSession::path_for(kLogDir, "log/test");
+    std::remove(path.c_str());
+    try {
+        std::cout << "\n1. Testing items persist across reopen..." << std::endl;
+        {
+            auto session = std::make_shared<LogSession>("log/test", kLogDir);
+            session->add_items_sync({message("one"), message("two")});
+            session->add_items_sync({message("three")});
+            assert(session->get_item_count() == 3);
+        }
+        auto session = std::make_shared<LogSession>("log/test", kLogDir);
+        assert(session->get_path() == path);
+        auto items = session->get_items_sync();
+        assert(items.size() == 3 && content_of(items[0]) == "one" && content_of(items[2]) == "three");
+        auto last = session->get_items_sync(1);
+        assert(last.size() == 1 && content_of(last[0]) == "three");
+        std::cout << "   ✓ Records are read back after reopening" << std::endl;
+
+        std::cout << "\n2. Testing a second writer is rejected..." << std::endl;
+        bool rejected = false;
+        try {
+            LogSession duplicate("log/test", kLogDir);
+        } catch (const std::exception&) {
+            rejected = true;
+        }
+        assert(rejected);
+        std::cout << "   ✓ The log has a single writer" << std::endl;
+
+        std::cout << "\n3. Testing pop truncates and scans page by position..." << std::endl;
+        auto size_before = session->get_file_size();
+        assert(content_of(session->pop_item_sync()) == "three");
+        assert(session->get_file_size() < size_before);
+        auto page = session->scan_sync(std::nullopt, 1);
+        assert(page.items.size() == 1 && content_of(page.items[0]) == "one");
+        auto next = session->scan_sync(page.next_cursor, 1);
+        assert(next.items.size() == 1 && content_of(next.items[0]) == "two");
+        std::cout << "   ✓ Popped records leave the file" << std::endl;
+
+        std::cout << "\n4. Testing a torn tail is dropped on reopen..." << std::endl;
+        auto intact_size = session->get_file_size();
+        session.reset();
+        FILE* file = std::fopen(path.c_str(), "ab");
+        std::fwrite("\x40\x00\x00\x00garbage", 1, 11, file);
+        std::fclose(file);
+        session = std::make_shared<LogSession>("log/test", kLogDir);
+        assert(session->get_item_count() == 2);
+        assert(session->get_file_size() == intact_size);
+        session->add_items_sync({message("after")});
+        assert(content_of(session->get_items_sync(1)[0]) == "after");
+        std::cout << "   ✓ Recovery keeps every complete record" << std::endl;
+
+        std::cout << "\n5. Testing clear..." << std::endl;
+        session->clear_session_sync();
+        assert(session->get_item_count() == 0);
+        assert(session->get_items_sync().empty());
+        std::cout << "   ✓ Clearing empties the log" << std::endl;
+
+        session.reset();
+        std::remove(path.c_str());
+        rmdir(kLogDir);
+        std::cout << "\n✅ All log session tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::remove(path.c_str());
+        rmdir(kLogDir);
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,117 @@
+#include "memory/util.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kArchivePath = "test_session_archive.bin";
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+// Accepts nothing, so copies into it must fail loudly
+class RejectingSession : public MemorySession {
+public:
+    using MemorySession::MemorySession;
+
+    std::future<void> add_items(const std::vector<std::shared_ptr<Item>>&) override {
+        std::promise<void> failed;
+        failed.set_exception(std::make_exception_ptr(std::runtime_error("disk full")));
+        return failed.get_future();
+    }
+};
+
+template<typename F>
+static bool throws(F&& func, const std::string& expected = "") {
+    try {
+        func();
+    } catch (const std::exception& e) {
+        return std::string(e.what()).find(expected) != std::string::npos;
+    }
+    return false;
+}
+
+int main() {
+    std::cout << "Testing session archives" << std::endl;
+    std::cout << "========================" << std::endl;
+
+    try {
+        auto first = std::make_shared<MemorySession>("archive_a");
+        auto second = std::make_shared<SQLiteSession>("archive_b", ":memory:");
+        for (int i = 0; i < 7; i++) {
+            first->add_items_sync({message("a" + std::to_string(i))});
+        }
+        second->add_items_sync({message("b0"), message("b1")});
+
+        for (bool compress : {true, false}) {
+            std::cout << "\n1. Testing round trip (" << (compress ? "compressed" : "plain") << ")..." << std::endl;
+            ArchiveOptions options;
+            options.compress = compress;
+            options.batch_size = 3;
+            assert(SessionUtils::export_sessions({first, second}, kArchivePath, options) == 9);
+
+            std::map<std::string, std::shared_ptr<Session>> targets;
+            auto imported = SessionUtils::import_sessions(kArchivePath, [&targets](const std::string& id) {
+                auto target = std::make_shared<MemorySession>(id);
+                targets[id] = target;
+                return target;
+            }, 2);
+            assert(imported.size() == 2);
+            auto items = targets.at("archive_a")->get_items_sync();
+            assert(items.size() == 7 && content_of(items[0]) == "a0" && content_of(items[6]) == "a6");
+            assert(content_of(targets.at("archive_b")->get_items_sync()[1]) == "b1");
+
+            SessionArchiveReader reader(kArchivePath);
+            std::string id;
+            assert(reader.next_session(id) && id == "archive_a");
+            assert(reader.read_items(4).size() == 4);
+            assert(reader.next_session(id) && id == "archive_b");
+            assert(reader.read_items(10).size() == 2);
+            assert(!reader.next_session(id));
+            std::cout << "   ✓ Sessions and items come back in order" << std::endl;
+        }
+
+        std::cout << "\n2. Testing write errors reach the caller..." << std::endl;
+        assert(throws([]() {
+            SessionUtils::import_sessions(kArchivePath, [](const std::string& id) {
+                return std::make_shared<RejectingSession>(id);
+            });
+        }, "disk full"));
+        assert(throws([&first]() {
+            SessionUtils::migrate_session(first, std::make_shared<RejectingSession>("archive_target"));
+        }, "disk full"));
+        assert(first->get_item_count() == 7);
+        std::cout << "   ✓ Import and migrate fail instead of reporting a copy" << std::endl;
+
+        std::cout << "\n3. Testing oversized frames are rejected before allocation..." << std::endl;
+        {
+            std::ofstream hostile(kArchivePath, std::ios::binary | std::ios::trunc);
+            hostile.write("OASESS\x01\x00", 8);
+            // Session frame claiming 2^62 bytes
+            hostile.write("\x01\x80\x80\x80\x80\x80\x80\x80\x80\x40", 10);
+        }
+        assert(throws([]() {
+            SessionArchiveReader reader(kArchivePath);
+            std::string id;
+            reader.next_session(id);
+        }, "frame too large"));
+        std::cout << "   ✓ Corrupt lengths fail with a clear error" << std::endl;
+
+        std::remove(kArchivePath);
+        std::cout << "\n✅ All session archive tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::remove(kArchivePath);
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
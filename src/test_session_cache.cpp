@@ -0,0 +1,72 @@
+#include "memory/util.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+int main() {
+    std::cout << "Testing segmented LRU session cache" << std::endl;
+    std::cout << "===================================" << std::endl;
+
+    try {
+        auto make = [](const std::string& id) { return std::make_shared<MemorySession>(id); };
+
+        std::cout << "\n1. Testing least recently used eviction..." << std::endl;
+        SessionCache cache(3, std::chrono::minutes(30), 1);
+        cache.put("a", make("a"));
+        cache.put("b", make("b"));
+        cache.put("c", make("c"));
+        assert(cache.get("a") != nullptr);
+        cache.put("d", make("d"));
+        assert(cache.size() == 3);
+        assert(cache.get("b") == nullptr);
+        assert(cache.get("a") && cache.get("c") && cache.get("d"));
+        std::cout << "   ✓ The least recently used entry is evicted" << std::endl;
+
+        std::cout << "\n2. Testing hit and miss counters..." << std::endl;
+        assert(cache.hit_count() == 4);
+        assert(cache.miss_count() == 1);
+        assert(cache.hit_rate() == 0.8);
+        cache.remove("a");
+        assert(cache.get("a") == nullptr);
+        cache.clear();
+        assert(cache.size() == 0);
+        std::cout << "   ✓ Counters track lookups" << std::endl;
+
+        std::cout << "\n3. Testing expiry..." << std::endl;
+        SessionCache expiring(10, std::chrono::minutes(0), 4);
+        expiring.put("old", make("old"));
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        expiring.cleanup_expired();
+        assert(expiring.size() == 0);
+        std::cout << "   ✓ Entries past their TTL are dropped" << std::endl;
+
+        std::cout << "\n4. Testing concurrent access across segments..." << std::endl;
+        SessionCache shared(64, std::chrono::minutes(30), 8);
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 4; t++) {
+            threads.emplace_back([&shared, &make, t]() {
+                for (int i = 0; i < 500; i++) {
+                    auto id = "s" + std::to_string((i + t) % 100);
+                    if (!shared.get(id)) {
+                        shared.put(id, make(id));
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(shared.size() <= 64);
+        assert(shared.hit_count() + shared.miss_count() == 2000);
+        std::cout << "   ✓ Size stays bounded under concurrent use" << std::endl;
+
+        std::cout << "\n✅ All session cache tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
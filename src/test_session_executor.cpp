@@ -0,0 +1,90 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+int main() {
+    std::cout << "Testing session executors" << std::endl;
+    std::cout << "=========================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing inline and pooled execution..." << std::endl;
+        auto caller = std::this_thread::get_id();
+        auto inline_future = get_inline_session_executor()->submit([]() { return std::this_thread::get_id(); });
+        assert(inline_future.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        assert(inline_future.get() == caller);
+
+        auto pool = std::make_shared<ThreadPoolExecutor>(1, 1);
+        assert(pool->submit([]() { return std::this_thread::get_id(); }).get() != caller);
+        std::cout << "   ✓ Tasks run inline or on pool threads" << std::endl;
+
+        std::cout << "\n2. Testing a full queue runs tasks on the caller..." << std::endl;
+        // Wait until the worker holds the blocker, so the queue slot is free
+        std::promise<void> release;
+        std::promise<void> blocking;
+        auto gate = release.get_future().share();
+        auto blocker = pool->submit([gate, &blocking]() {
+            blocking.set_value();
+            gate.wait();
+        });
+        blocking.get_future().wait();
+        auto queued = pool->submit([]() { return 1; });
+        auto overflow = pool->submit([]() { return std::this_thread::get_id(); });
+        assert(overflow.wait_for(std::chrono::seconds(0)) == std::future_status::ready);
+        assert(overflow.get() == caller);
+        release.set_value();
+        blocker.get();
+        assert(queued.get() == 1);
+        std::cout << "   ✓ Overflowing tasks throttle the producer" << std::endl;
+
+        std::cout << "\n3. Testing queued tasks keep their session alive..." << std::endl;
+        std::promise<void> hold;
+        std::promise<void> holding;
+        auto held = hold.get_future().share();
+        auto busy = pool->submit([held, &holding]() {
+            holding.set_value();
+            held.wait();
+        });
+        holding.get_future().wait();
+
+        auto session = std::make_shared<MemorySession>("executor_test");
+        session->set_executor(pool);
+        std::weak_ptr<MemorySession> watcher = session;
+        auto added = session->add_items({std::make_shared<MessageItem>("user", "late")});
+        assert(added.wait_for(std::chrono::seconds(0)) == std::future_status::timeout);
+        session.reset();
+        assert(!watcher.expired());
+
+        hold.set_value();
+        busy.get();
+        added.get();
+        // The task's captures are released just after its result is set
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+        while (!watcher.expired() && std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        assert(watcher.expired());
+        std::cout << "   ✓ Dropped sessions outlive their queued tasks" << std::endl;
+
+        std::cout << "\n4. Testing managers wait for batch operations..." << std::endl;
+        {
+            auto manager = std::make_unique<SessionManager>();
+            manager->create_memory_session("batch_a");
+            manager->create_memory_session("batch_b");
+            auto stats = manager->get_all_session_stats();
+            manager->clear_all_sessions_async();
+            manager.reset();
+            assert(stats.get().size() <= 2);
+        }
+        std::cout << "   ✓ Destroying a manager drains its batch operations" << std::endl;
+
+        std::cout << "\n✅ All session executor tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,63 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+#include <set>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+int main() {
+    std::cout << "Testing sharded session manager" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing sessions are striped across shards..." << std::endl;
+        SessionManager manager(":memory:", "agent_sessions", "agent_messages", 8);
+        assert(manager.get_shard_count() == 8);
+        for (int i = 0; i < 64; i++) {
+            manager.create_memory_session("striped_" + std::to_string(i));
+        }
+        size_t total = 0;
+        size_t used_shards = 0;
+        for (const auto& shard : manager.get_shard_stats()) {
+            total += shard.session_count;
+            used_shards += shard.session_count > 0 ? 1 : 0;
+        }
+        assert(total == 64 && manager.get_session_count() == 64);
+        assert(used_shards > 1);
+        assert(manager.list_session_ids().size() == 64);
+        std::cout << "   ✓ Sessions spread over several shards" << std::endl;
+
+        std::cout << "\n2. Testing concurrent get_or_create shares one session..." << std::endl;
+        std::vector<std::thread> threads;
+        std::vector<std::shared_ptr<Session>> results(16);
+        for (size_t t = 0; t < results.size(); t++) {
+            threads.emplace_back([&manager, &results, t]() {
+                results[t] = manager.get_or_create_session("contended");
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        for (const auto& result : results) {
+            assert(result && result == results[0]);
+        }
+        assert(manager.get_session("contended") == results[0]);
+        std::cout << "   ✓ Racing creators adopt the same session" << std::endl;
+
+        std::cout << "\n3. Testing removal and clearing..." << std::endl;
+        manager.remove_session("contended");
+        assert(!manager.has_session("contended"));
+        assert(manager.get_or_create_session("contended") != results[0]);
+        manager.clear_all_sessions();
+        assert(manager.get_session_count() == 0);
+        std::cout << "   ✓ Removed sessions are recreated fresh" << std::endl;
+
+        std::cout << "\n✅ All sharded session manager tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,86 @@
+#include "memory/util.h"
+#include "memory/log_session.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <unistd.h>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kLogDir = "test_pool_logs";
+
+static void remove_logs() {
+    std::remove(LogSession::path_for(kLogDir, "pool_log_a").c_str());
+    std::remove(LogSession::path_for(kLogDir, "pool_log_b").c_str());
+    rmdir(kLogDir);
+}
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+int main() {
+    std::cout << "Testing session pool reuse" << std::endl;
+    std::cout << "==========================" << std::endl;
+
+    remove_logs();
+    try {
+        std::vector<SessionFactory::SessionType> types{
+            SessionFactory::SessionType::Memory,
+            SessionFactory::SessionType::RingMemory,
+            SessionFactory::SessionType::SQLite,
+        };
+        for (auto type : types) {
+            std::cout << "\n1. Testing released sessions are rebound..." << std::endl;
+            SessionPool pool(type, {{"capacity", "8"}}, 2);
+            auto first = pool.acquire_session("pool_a");
+            assert(first->get_session_id() == "pool_a");
+            assert(pool.acquire_session("pool_a") == first);
+            first->add_items_sync({message("one"), message("two")});
+            first->set_metadata("owner", std::string("a"));
+            pool.release_session("pool_a");
+            assert(pool.active_count() == 0 && pool.available_count() == 1);
+
+            auto second = pool.acquire_session("pool_b");
+            assert(second == first);
+            assert(second->get_session_id() == "pool_b");
+            assert(second->get_item_count() == 0 && second->get_items_sync().empty());
+            assert(!second->has_metadata("owner"));
+            assert(pool.active_count() == 1 && pool.available_count() == 0);
+            std::cout << "   ✓ The pooled object starts over under the new id" << std::endl;
+
+            std::cout << "\n2. Testing the pool size limit..." << std::endl;
+            auto third = pool.acquire_session("pool_c");
+            auto fourth = pool.acquire_session("pool_d");
+            assert(third != fourth);
+            pool.release_session("pool_b");
+            pool.release_session("pool_c");
+            pool.release_session("pool_d");
+            assert(pool.available_count() == 2);
+            std::cout << "   ✓ Releases beyond the limit are dropped" << std::endl;
+        }
+
+        std::cout << "\n3. Testing backends that cannot rebind get a new session..." << std::endl;
+        {
+            SessionPool pool(SessionFactory::SessionType::Log, {{"log_dir", kLogDir}}, 2);
+            auto first = pool.acquire_session("pool_log_a");
+            first->add_items_sync({message("kept")});
+            pool.release_session("pool_log_a");
+            auto second = pool.acquire_session("pool_log_b");
+            assert(second != first);
+            assert(second->get_session_id() == "pool_log_b" && second->get_item_count() == 0);
+            pool.release_session("pool_log_b");
+        }
+        remove_logs();
+        std::cout << "   ✓ A fresh session is created instead" << std::endl;
+
+        std::cout << "\n✅ All session pool tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        remove_logs();
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
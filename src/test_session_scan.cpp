@@ -0,0 +1,84 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static std::shared_ptr<Item> message(int n) {
+    return std::make_shared<MessageItem>("user", std::to_string(n));
+}
+
+static int number_of(const std::shared_ptr<Item>& item) {
+    return std::stoi(std::static_pointer_cast<MessageItem>(item)->get_content());
+}
+
+// Walks every page and checks the items come back in order
+static void check_scan(Session& session, int first, int last) {
+    std::vector<int> forward;
+    std::optional<int64_t> cursor;
+    do {
+        auto page = session.scan_sync(cursor, 3);
+        assert(page.items.size() <= 3);
+        for (const auto& item : page.items) forward.push_back(number_of(item));
+        cursor = page.next_cursor;
+    } while (cursor);
+    assert(static_cast<int>(forward.size()) == last - first + 1);
+    for (size_t i = 0; i < forward.size(); i++) assert(forward[i] == first + static_cast<int>(i));
+
+    std::vector<int> backward;
+    cursor.reset();
+    do {
+        auto page = session.scan_reverse_sync(cursor, 4);
+        for (const auto& item : page.items) backward.push_back(number_of(item));
+        cursor = page.next_cursor;
+    } while (cursor);
+    assert(backward.size() == forward.size());
+    for (size_t i = 0; i < backward.size(); i++) assert(backward[i] == last - static_cast<int>(i));
+}
+
+int main() {
+    std::cout << "Testing keyset scans and item counts" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    try {
+        std::vector<std::shared_ptr<Session>> sessions{
+            std::make_shared<SQLiteSession>("scan_sqlite", ":memory:"),
+            std::make_shared<MemorySession>("scan_memory"),
+        };
+        for (auto& session : sessions) {
+            std::cout << "\nSession " << session->get_session_id() << std::endl;
+
+            std::cout << "1. Testing forward and reverse pages..." << std::endl;
+            std::vector<std::shared_ptr<Item>> items;
+            for (int i = 1; i <= 10; i++) items.push_back(message(i));
+            session->add_items_sync(items);
+            check_scan(*session, 1, 10);
+            std::cout << "   ✓ Pages cover every item exactly once" << std::endl;
+
+            std::cout << "2. Testing cursors survive later writes..." << std::endl;
+            auto page = session->scan_sync(std::nullopt, 5);
+            session->add_items_sync({message(11)});
+            auto next = session->scan_sync(page.next_cursor, 10);
+            assert(next.items.size() == 6 && number_of(next.items[0]) == 6);
+            std::cout << "   ✓ A cursor resumes after its last item" << std::endl;
+
+            std::cout << "3. Testing the maintained item count..." << std::endl;
+            assert(session->get_item_count() == 11);
+            session->pop_item_sync();
+            assert(session->get_item_count() == 10);
+            assert(session->get_summary().item_count == 10);
+            session->clear_session_sync();
+            assert(session->get_item_count() == 0);
+            assert(session->scan_sync().items.empty());
+            std::cout << "   ✓ Counts follow adds, pops and clears" << std::endl;
+        }
+
+        std::cout << "\n✅ All scan tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
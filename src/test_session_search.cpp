@@ -0,0 +1,95 @@
+#include "memory/session.h"
+#include <sqlite3.h>
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kDbPath = "test_session_search.db";
+
+static void remove_db() {
+    std::remove(kDbPath);
+    std::remove((std::string(kDbPath) + "-wal").c_str());
+    std::remove((std::string(kDbPath) + "-shm").c_str());
+}
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+// Changes the schema behind the sessions' backs, as another process would
+static void execute_elsewhere(const std::string& sql) {
+    sqlite3* db = nullptr;
+    assert(sqlite3_open(kDbPath, &db) == SQLITE_OK);
+    sqlite3_busy_timeout(db, 5000);
+    assert(sqlite3_exec(db, sql.c_str(), nullptr, nullptr, nullptr) == SQLITE_OK);
+    sqlite3_close(db);
+}
+
+int main() {
+    std::cout << "Testing full-text session search" << std::endl;
+    std::cout << "================================" << std::endl;
+
+    remove_db();
+    try {
+        std::cout << "\n1. Testing stored and new items are indexed..." << std::endl;
+        auto alpha = std::make_shared<SQLiteSession>("search_alpha", kDbPath);
+        auto beta = std::make_shared<SQLiteSession>("search_beta", kDbPath);
+        alpha->add_items_sync({message("the quick brown fox"), message("lazy afternoon")});
+        assert(!alpha->has_search_index());
+        assert(alpha->search("fox").empty());
+
+        alpha->enable_search_index();
+        assert(alpha->has_search_index() && beta->has_search_index());
+        beta->add_items_sync({message("a fox in the henhouse")});
+
+        auto own = alpha->search("fox");
+        assert(own.size() == 1 && own[0].session_id == "search_alpha");
+        assert(alpha->search_all("fox").size() == 2);
+        auto direct = SQLiteSession::search_database(kDbPath, "agent_sessions", "agent_messages", "fox");
+        assert(direct.size() == 2);
+        std::cout << "   ✓ Searches see rows written before and after indexing" << std::endl;
+
+        std::cout << "\n2. Testing pops and clears keep the index current..." << std::endl;
+        beta->pop_item_sync();
+        assert(alpha->search_all("fox").size() == 1);
+        alpha->clear_session_sync();
+        assert(alpha->search_all("fox").empty());
+        std::cout << "   ✓ Removed items leave the index" << std::endl;
+
+        std::cout << "\n3. Testing a dropped index is noticed..." << std::endl;
+        alpha->add_items_sync({message("fox again")});
+        execute_elsewhere("DROP TABLE agent_messages_search");
+        assert(alpha->search("fox").empty());
+        assert(!alpha->has_search_index());
+        beta->add_items_sync({message("fox after drop")});
+        assert(beta->pop_item_sync() != nullptr);
+        assert(beta->get_item_count() == 0);
+
+        execute_elsewhere("CREATE VIRTUAL TABLE agent_messages_search USING fts5(content, session_id UNINDEXED)");
+        alpha->enable_search_index();
+        assert(beta->has_search_index());
+        alpha->add_items_sync({message("fox restored")});
+        execute_elsewhere("DROP TABLE agent_messages_search");
+        alpha->add_items_sync({message("written while the index is gone")});
+        assert(alpha->get_item_count() == 3);
+        assert(!alpha->has_search_index());
+
+        alpha->enable_search_index();
+        assert(alpha->search("fox").size() == 2);
+        std::cout << "   ✓ Writes and searches recover when the index disappears" << std::endl;
+
+        alpha.reset();
+        beta.reset();
+        remove_db();
+        std::cout << "\n✅ All session search tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        remove_db();
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
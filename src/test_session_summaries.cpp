@@ -0,0 +1,90 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kDbPath = "test_session_summaries.db";
+
+static void remove_db() {
+    std::remove(kDbPath);
+    std::remove((std::string(kDbPath) + "-wal").c_str());
+    std::remove((std::string(kDbPath) + "-shm").c_str());
+}
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+int main() {
+    std::cout << "Testing streamed session summaries" << std::endl;
+    std::cout << "==================================" << std::endl;
+
+    remove_db();
+    try {
+        std::cout << "\n1. Testing every stored session is summarized..." << std::endl;
+        {
+            SessionManager manager(kDbPath);
+            for (int i = 0; i < 300; i++) {
+                auto session = manager.create_session("summary_" + std::to_string(1000 + i));
+                std::vector<std::shared_ptr<Item>> items(i % 3 + 1, message("item"));
+                session->add_items_sync(items);
+            }
+            manager.create_session("summary_empty");
+
+            auto any = std::static_pointer_cast<SQLiteSession>(manager.get_session("summary_1000"));
+            std::vector<SessionSummary> seen;
+            assert(any->summarize_all([&seen](const SessionSummary& summary) {
+                seen.push_back(summary);
+                return true;
+            }));
+            assert(seen.size() == 300);
+            for (size_t i = 0; i < seen.size(); i++) {
+                assert(seen[i].session_id == "summary_" + std::to_string(1000 + i));
+                assert(seen[i].item_count == i % 3 + 1);
+                assert(seen[i].total_tokens > 0 && seen[i].last_item_at.has_value());
+            }
+
+            size_t visited = 0;
+            assert(!any->summarize_all([&visited](const SessionSummary&) { return ++visited < 10; }));
+            assert(visited == 10);
+
+            size_t managed = 0;
+            bool saw_empty = false;
+            manager.for_each_session_summary([&](const SessionSummary& summary) {
+                managed++;
+                saw_empty = saw_empty || (summary.session_id == "summary_empty" && summary.item_count == 0);
+                return true;
+            });
+            assert(managed == 301 && saw_empty);
+        }
+        std::cout << "   ✓ Summaries are streamed across pages, in id order" << std::endl;
+
+        std::cout << "\n2. Testing visitors may use the same in-memory database..." << std::endl;
+        auto memory = std::make_shared<SQLiteSession>("summary_memory", ":memory:");
+        memory->add_items_sync({message("a"), message("b")});
+        auto visit = std::async(std::launch::async, [&memory]() {
+            return memory->summarize_all([&memory](const SessionSummary& summary) {
+                if (summary.item_count > 0) {
+                    memory->clear_session_sync();
+                }
+                return true;
+            });
+        });
+        assert(visit.wait_for(std::chrono::seconds(10)) == std::future_status::ready);
+        assert(visit.get());
+        assert(memory->get_item_count() == 0);
+        std::cout << "   ✓ The visitor runs with no connection checked out" << std::endl;
+
+        remove_db();
+        std::cout << "\n✅ All session summary tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        remove_db();
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
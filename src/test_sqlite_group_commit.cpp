@@ -0,0 +1,113 @@
+#include "memory/session.h"
+#include <sqlite3.h>
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kDbPath = "test_group_commit.db";
+
+static void remove_db() {
+    std::remove(kDbPath);
+    std::remove((std::string(kDbPath) + "-wal").c_str());
+    std::remove((std::string(kDbPath) + "-shm").c_str());
+}
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+int main() {
+    std::cout << "Testing SQLite group commit" << std::endl;
+    std::cout << "===========================" << std::endl;
+
+    remove_db();
+    try {
+        std::cout << "\n1. Testing coalesced writes from several sessions..." << std::endl;
+        {
+            GroupCommitOptions options;
+            options.enabled = true;
+            options.max_delay = std::chrono::milliseconds(20);
+            std::vector<std::shared_ptr<SQLiteSession>> sessions;
+            std::vector<std::future<void>> writes;
+            for (int i = 0; i < 4; i++) {
+                sessions.push_back(std::make_shared<SQLiteSession>(
+                    "group_" + std::to_string(i), kDbPath, "agent_sessions", "agent_messages", options));
+            }
+            for (int round = 0; round < 5; round++) {
+                for (auto& session : sessions) {
+                    writes.push_back(session->add_items({message("round " + std::to_string(round))}));
+                }
+            }
+            for (auto& write : writes) {
+                write.get();
+            }
+            for (auto& session : sessions) {
+                assert(session->get_item_count() == 5);
+                assert(session->get_items_sync().size() == 5);
+            }
+        }
+        std::cout << "   ✓ Every coalesced write is committed" << std::endl;
+
+        std::cout << "\n2. Testing per-session options on a shared file..." << std::endl;
+        {
+            GroupCommitOptions slow;
+            slow.enabled = true;
+            slow.max_delay = std::chrono::milliseconds(5000);
+            GroupCommitOptions fast;
+            fast.enabled = true;
+            fast.max_delay = std::chrono::milliseconds(1);
+            SQLiteSession slow_session("slow", kDbPath, "agent_sessions", "agent_messages", slow);
+            SQLiteSession fast_session("fast", kDbPath, "agent_sessions", "agent_messages", fast);
+
+            auto start = std::chrono::steady_clock::now();
+            fast_session.add_items(std::vector<std::shared_ptr<Item>>{message("quick")}).get();
+            assert(std::chrono::steady_clock::now() - start < std::chrono::milliseconds(2000));
+            assert(fast_session.get_item_count() == 1);
+        }
+        std::cout << "   ✓ Later sessions keep their own flush delay" << std::endl;
+
+        std::cout << "\n3. Testing one failing session does not fail the batch..." << std::endl;
+        {
+            GroupCommitOptions options;
+            options.enabled = true;
+            options.max_delay = std::chrono::milliseconds(200);
+            SQLiteSession healthy("healthy", kDbPath, "agent_sessions", "agent_messages", options);
+            SQLiteSession broken("broken", kDbPath, "broken_sessions", "broken_messages", options);
+
+            sqlite3* db = nullptr;
+            assert(sqlite3_open(kDbPath, &db) == SQLITE_OK);
+            sqlite3_busy_timeout(db, 5000);
+            assert(sqlite3_exec(db, "DROP TABLE broken_messages", nullptr, nullptr, nullptr) == SQLITE_OK);
+            sqlite3_close(db);
+
+            auto broken_write = broken.add_items({message("lost")});
+            auto healthy_write = healthy.add_items({message("kept")});
+            healthy_write.get();
+
+            bool threw = false;
+            try {
+                broken_write.get();
+            } catch (const std::exception&) {
+                threw = true;
+            }
+            assert(threw);
+
+            auto items = healthy.get_items_sync();
+            assert(items.size() == 1);
+            assert(std::static_pointer_cast<MessageItem>(items[0])->get_content() == "kept");
+        }
+        std::cout << "   ✓ Healthy sessions commit alongside a failed write" << std::endl;
+
+        remove_db();
+        std::cout << "\n✅ All group commit tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        remove_db();
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
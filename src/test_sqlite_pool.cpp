@@ -0,0 +1,71 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static const char* kDbPath = "test_sqlite_pool.db";
+
+static void remove_db() {
+    std::remove(kDbPath);
+    std::remove((std::string(kDbPath) + "-wal").c_str());
+    std::remove((std::string(kDbPath) + "-shm").c_str());
+}
+
+int main() {
+    std::cout << "Testing SQLite connection pool" << std::endl;
+    std::cout << "==============================" << std::endl;
+
+    remove_db();
+    try {
+        SQLiteSession::set_default_max_readers(2);
+        auto first = std::make_shared<SQLiteSession>("pool_a", kDbPath);
+        auto second = std::make_shared<SQLiteSession>("pool_b", kDbPath);
+
+        std::cout << "\n1. Testing sessions on one file share a pool..." << std::endl;
+        auto before = second->get_pool_stats().writer_checkouts;
+        first->add_items_sync({std::make_shared<MessageItem>("user", "hi")});
+        assert(second->get_pool_stats().writer_checkouts > before);
+        assert(second->get_pool_stats().max_readers == 2);
+        std::cout << "   ✓ Checkouts from one session show in the other's pool" << std::endl;
+
+        std::cout << "\n2. Testing concurrent writers and bounded readers..." << std::endl;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < 8; t++) {
+            threads.emplace_back([&, t]() {
+                auto& session = t % 2 ? first : second;
+                for (int i = 0; i < 10; i++) {
+                    session->add_items_sync({std::make_shared<MessageItem>("user", std::to_string(i))});
+                    session->get_items_sync(5);
+                }
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
+        }
+        assert(first->get_item_count() == 41);
+        assert(second->get_item_count() == 40);
+        auto stats = first->get_pool_stats();
+        assert(stats.reader_connections <= 2);
+        assert(stats.reader_checkouts >= 80);
+        std::cout << "   ✓ Writes are serialized and readers stay within the limit" << std::endl;
+
+        std::cout << "\n3. Testing warm-up..." << std::endl;
+        first->warm_up(2);
+        assert(first->get_pool_stats().reader_connections == 2);
+        std::cout << "   ✓ Warm-up opens reader connections up front" << std::endl;
+
+        first.reset();
+        second.reset();
+        remove_db();
+        std::cout << "\n✅ All connection pool tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        remove_db();
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,61 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+int main() {
+    std::cout << "Testing SQLite prepared statement cache" << std::endl;
+    std::cout << "=======================================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing statement reuse across calls..." << std::endl;
+        SQLiteSession session("stmt_test", ":memory:");
+        session.add_items_sync({message("first"), message("second")});
+        session.get_items_sync();
+        auto cached = std::any_cast<size_t>(session.get_db_stats()["cached_statements"]);
+        for (int i = 0; i < 20; i++) {
+            session.add_items_sync({message("more " + std::to_string(i))});
+            session.get_items_sync(static_cast<size_t>(i % 3 + 1));
+        }
+        auto cached_after = std::any_cast<size_t>(session.get_db_stats()["cached_statements"]);
+        assert(cached > 0);
+        assert(cached_after <= cached + 2);
+        std::cout << "   ✓ Repeated operations reuse cached statements" << std::endl;
+
+        std::cout << "\n2. Testing rebinding of parameters..." << std::endl;
+        auto newest = session.get_items_sync(2);
+        assert(newest.size() == 2);
+        assert(content_of(newest[0]) == "more 18");
+        assert(content_of(newest[1]) == "more 19");
+        auto oldest = session.get_items_sync();
+        assert(oldest.size() == 22);
+        assert(content_of(oldest[0]) == "first");
+        std::cout << "   ✓ Limits rebind on the reused statement" << std::endl;
+
+        std::cout << "\n3. Testing session ids are bound, not spliced..." << std::endl;
+        SQLiteSession quoted("it's \"quoted\"; DROP TABLE agent_messages; --", ":memory:");
+        quoted.add_items_sync({message("safe")});
+        auto items = quoted.get_items_sync();
+        assert(items.size() == 1);
+        assert(content_of(items[0]) == "safe");
+        assert(quoted.get_item_count() == 1);
+        std::cout << "   ✓ Quoted session ids round-trip" << std::endl;
+
+        std::cout << "\n✅ All statement cache tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,64 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+int main() {
+    std::cout << "Testing token-budgeted history reads" << std::endl;
+    std::cout << "====================================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing the default estimate..." << std::endl;
+        MessageItem short_item("user", "hi");
+        MessageItem long_item("user", std::string(400, 'x'));
+        assert(estimate_item_tokens(long_item) > estimate_item_tokens(short_item));
+        assert(estimate_item_tokens(long_item) >= 100);
+        std::cout << "   ✓ Longer items cost more tokens" << std::endl;
+
+        // One token per character, so budgets are easy to reason about
+        set_token_counter([](const Item& item) { return item_text(item).size(); });
+        assert(count_item_tokens(short_item) == 2);
+
+        std::vector<std::shared_ptr<Session>> sessions{
+            std::make_shared<SQLiteSession>("budget_sqlite", ":memory:"),
+            std::make_shared<MemorySession>("budget_memory"),
+            std::make_shared<RingMemorySession>("budget_ring", 16),
+        };
+        for (auto& session : sessions) {
+            std::cout << "\n2. Testing budgets on " << session->get_session_id() << "..." << std::endl;
+            session->add_items_sync({message("aaaa"), message("bbb"), message("cc"), message("d")});
+
+            auto fits = session->get_items_within_budget_sync(6);
+            assert(fits.size() == 3);
+            assert(content_of(fits[0]) == "bbb" && content_of(fits[2]) == "d");
+
+            assert(session->get_items_within_budget_sync(10).size() == 4);
+            assert(session->get_items_within_budget_sync(100).size() == 4);
+            assert(session->get_items_within_budget_sync(0).empty());
+
+            // The newest item alone is over budget, so nothing older is returned
+            session->add_items_sync({message("eeeeeeee")});
+            assert(session->get_items_within_budget_sync(5).empty());
+            std::cout << "   ✓ The newest items that fit are returned, oldest first" << std::endl;
+        }
+
+        set_token_counter(nullptr);
+        std::cout << "\n✅ All token budget tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        set_token_counter(nullptr);
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
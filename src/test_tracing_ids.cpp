@@ -0,0 +1,69 @@
+#include "tracing/ids.h"
+#include <iostream>
+#include <cassert>
+#include <set>
+#include <thread>
+#include <unordered_set>
+
+using namespace openai_agents::tracing;
+
+int main() {
+    std::cout << "Testing trace and span IDs" << std::endl;
+    std::cout << "==========================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing the string form round-trips..." << std::endl;
+        auto trace = TraceId::generate();
+        auto span = SpanId::generate();
+        assert(trace.is_valid() && span.is_valid() && !TraceId().is_valid());
+        std::string text = trace.to_string();
+        assert(text.size() == 6 + 32 && text.rfind("trace_", 0) == 0);
+        assert(span.to_string().size() == 5 + 16 && span.to_string().rfind("span_", 0) == 0);
+        assert(TraceId::parse(text) == trace);
+        assert(TraceId::parse(trace.to_hex()) == trace);
+        assert(SpanId::parse(span.to_string()) == span);
+
+        auto parsed = SpanId::parse("span_0123456789ABCDEF");
+        assert(parsed && parsed->to_string() == "span_0123456789abcdef");
+        assert(parsed->bytes()[0] == 0x01 && parsed->bytes()[7] == 0xef);
+        std::cout << "   ✓ IDs format as prefix plus lowercase hex and parse back" << std::endl;
+
+        std::cout << "\n2. Testing malformed strings are rejected..." << std::endl;
+        assert(!SpanId::parse("span_0123"));
+        assert(!SpanId::parse("span_0123456789abcdeg"));
+        assert(!SpanId::parse(text));
+        assert(!TraceId::parse(""));
+        auto custom = TraceId::from_string("my-trace");
+        assert(custom.is_valid() && custom == TraceId::from_string("my-trace"));
+        assert(custom != TraceId::from_string("my-trace-2"));
+        assert(TraceId::from_string(text) == trace);
+        std::cout << "   ✓ Other strings map to a stable derived ID" << std::endl;
+
+        std::cout << "\n3. Testing generated IDs are distinct across threads..." << std::endl;
+        std::vector<std::vector<SpanId>> generated(4);
+        std::vector<std::thread> threads;
+        for (size_t t = 0; t < generated.size(); t++) {
+            threads.emplace_back([&generated, t]() {
+                for (int i = 0; i < 20000; i++) generated[t].push_back(SpanId::generate());
+            });
+        }
+        for (auto& thread : threads) thread.join();
+        std::unordered_set<SpanId> unique;
+        std::set<SpanId> ordered;
+        for (const auto& ids : generated) {
+            for (const auto& id : ids) {
+                unique.insert(id);
+                ordered.insert(id);
+            }
+        }
+        assert(unique.size() == 80000 && ordered.size() == 80000);
+        std::cout << "   ✓ No collisions among 80000 span IDs" << std::endl;
+
+        std::cout << "\n✅ All trace ID tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
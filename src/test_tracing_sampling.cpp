@@ -0,0 +1,62 @@
+#include "tracing/sampling.h"
+#include <iostream>
+#include <cassert>
+#include <cmath>
+
+using namespace openai_agents::tracing;
+
+int main() {
+    std::cout << "Testing trace sampling" << std::endl;
+    std::cout << "======================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing trace ID thresholds..." << std::endl;
+        const int traces = 20000;
+        std::vector<TraceId> ids;
+        for (int i = 0; i < traces; i++) ids.push_back(TraceId::generate());
+        int kept_low = 0;
+        int kept_high = 0;
+        for (const auto& id : ids) {
+            bool low = sample_trace_id(id, 0.1);
+            bool high = sample_trace_id(id, 0.5);
+            // A trace kept at some rate is kept at every higher rate
+            assert(!low || high);
+            assert(sample_trace_id(id, 1.0) && !sample_trace_id(id, 0.0));
+            assert(sample_trace_id(id, 0.5) == high);
+            kept_low += low;
+            kept_high += high;
+        }
+        assert(std::abs(kept_low - traces / 10) < traces / 50);
+        assert(std::abs(kept_high - traces / 2) < traces / 50);
+        std::cout << "   ✓ Decisions are stable, nested and close to the rate" << std::endl;
+
+        std::cout << "\n2. Testing rates by span type and agent..." << std::endl;
+        HeadSamplingOptions options;
+        options.default_rate = 0.0;
+        options.span_type_rates["function"] = 1.0;
+        options.span_type_rates["agent"] = 0.0;
+        options.agent_rates["Planner"] = 1.0;
+        HeadSampler sampler(options);
+        AgentSpanData planner("Planner");
+        AgentSpanData writer("Writer");
+        FunctionSpanData lookup("lookup");
+        GenerationSpanData generation;
+        assert(sampler.get_rate(planner) == 1.0);
+        assert(sampler.get_rate(writer) == 0.0);
+        assert(sampler.get_rate(lookup) == 1.0);
+        assert(sampler.get_rate(generation) == 0.0);
+        for (const auto& id : ids) {
+            assert(sampler.should_sample(id, planner) && sampler.should_sample(id, lookup));
+            assert(!sampler.should_sample(id, writer) && !sampler.should_sample(id, generation));
+        }
+        assert(HeadSampler().should_sample(ids[0], writer));
+        std::cout << "   ✓ Agent rates override type rates, which override the default" << std::endl;
+
+        std::cout << "\n✅ All sampling tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,95 @@
+#include "tracing/scope.h"
+#include <iostream>
+#include <cassert>
+#include <thread>
+
+using namespace openai_agents::tracing;
+
+int main() {
+    std::cout << "Testing tracing context slots" << std::endl;
+    std::cout << "=============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing scopes save and restore the slots..." << std::endl;
+        auto outer_trace = TraceId::generate();
+        auto outer_span = SpanId::generate();
+        auto inner_span = SpanId::generate();
+        ScopedTracingContext::clear_all();
+        {
+            auto trace_scope = ScopedTracingContext::create_trace_span_scope(outer_trace, outer_span);
+            assert(ScopedTracingContext::get_current_trace_id() == outer_trace);
+            {
+                auto span_scope = ScopedTracingContext::create_span_scope(inner_span);
+                assert(ScopedTracingContext::get_current_span_id() == inner_span);
+                assert(ScopedTracingContext::get_current_trace_id() == outer_trace);
+                {
+                    auto disabled = ScopedTracingContext::create_disabled_scope();
+                    assert(ScopedTracingContext::is_trace_disabled());
+                }
+                assert(!ScopedTracingContext::is_trace_disabled());
+            }
+            assert(ScopedTracingContext::get_current_span_id() == outer_span);
+
+            int result = context_utils::with_span_context(inner_span, []() {
+                return ScopedTracingContext::get_current_span_id() ? 1 : 0;
+            });
+            assert(result == 1 && ScopedTracingContext::get_current_span_id() == outer_span);
+        }
+        assert(!ScopedTracingContext::get_current_trace_id() && !ScopedTracingContext::get_current_span_id());
+        std::cout << "   ✓ Each scope puts back exactly what it found" << std::endl;
+
+        std::cout << "\n2. Testing string keys map onto the slots..." << std::endl;
+        auto& context = ThreadLocalContext::current();
+        context.set(TracingContext::CURRENT_TRACE_ID, outer_trace.to_string());
+        assert(context.get<TraceId>(TracingContext::CURRENT_TRACE_ID) == outer_trace);
+        assert(context.get<std::string>(TracingContext::CURRENT_TRACE_ID) == outer_trace.to_string());
+        context.set("request", std::string("r-1"));
+        {
+            ScopedContext scope("request", std::string("r-2"));
+            assert(context.get<std::string>("request") == "r-2");
+        }
+        assert(context.get<std::string>("request") == "r-1");
+        auto keys = context.keys();
+        assert(keys.size() == 2);
+
+        auto snapshot = ScopedTracingContext::get_context_snapshot();
+        ScopedTracingContext::clear_all();
+        {
+            auto restored = ScopedTracingContext::restore_from_snapshot(snapshot);
+            assert(ScopedTracingContext::get_current_trace_id() == outer_trace);
+        }
+        assert(!ScopedTracingContext::get_current_trace_id());
+        std::cout << "   ✓ Snapshots and named variables round-trip" << std::endl;
+
+        std::cout << "\n3. Testing extension slots..." << std::endl;
+        auto slot = ScopedTracingContext::allocate_extension_slot();
+        assert(slot && *slot < TracingSlots::kExtensionSlots);
+        assert(!ScopedTracingContext::get_extension(*slot));
+        {
+            auto scope = ScopedTracingContext::create_extension_scope(*slot, 42);
+            assert(ScopedTracingContext::get_extension(*slot) == 42u);
+        }
+        assert(!ScopedTracingContext::get_extension(*slot));
+        while (ScopedTracingContext::allocate_extension_slot()) {}
+        assert(!ScopedTracingContext::get_extension(TracingSlots::kExtensionSlots));
+        std::cout << "   ✓ Slots are handed out once and restored with the scope" << std::endl;
+
+        std::cout << "\n4. Testing threads have their own slots..." << std::endl;
+        ScopedTracingContext::set_current_trace_id(outer_trace);
+        std::thread([&outer_trace]() {
+            assert(!ScopedTracingContext::get_current_trace_id());
+            ScopedTracingContext::set_current_trace_id(TraceId::generate());
+            assert(ScopedTracingContext::get_current_trace_id() != outer_trace);
+        }).join();
+        assert(ScopedTracingContext::get_current_trace_id() == outer_trace);
+        ScopedTracingContext::clear_all();
+        std::cout << "   ✓ Other threads do not see this thread's context" << std::endl;
+
+        std::cout << "\n✅ All tracing scope tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
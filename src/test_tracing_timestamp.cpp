@@ -0,0 +1,48 @@
+#include "tracing/timestamp.h"
+#include <iostream>
+#include <cassert>
+#include <thread>
+
+using namespace openai_agents::tracing;
+
+int main() {
+    std::cout << "Testing tracing timestamps" << std::endl;
+    std::cout << "==========================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing ISO 8601 formatting..." << std::endl;
+        assert(format_timestamp(0) == "1970-01-01T00:00:00.000000Z");
+        assert(format_timestamp(1738324800123456789LL) == "2025-01-31T12:00:00.123456Z");
+        assert(format_timestamp(1709164800LL * 1000000000LL) == "2024-02-29T00:00:00.000000Z");
+        assert(format_timestamp(951782400LL * 1000000000LL) == "2000-02-29T00:00:00.000000Z");
+        assert(format_timestamp(-1) == "1969-12-31T23:59:59.999999Z");
+        assert(format_timestamp(4102444799999999999LL) == "2099-12-31T23:59:59.999999Z");
+        std::cout << "   ✓ Dates, leap days and pre-epoch times format correctly" << std::endl;
+
+        std::cout << "\n2. Testing the clock..." << std::endl;
+        int64_t wall = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        int64_t first = now_ns();
+        assert(first - wall < 1000000000LL && wall - first < 1000000000LL);
+
+        int64_t previous = first;
+        for (int i = 0; i < 100000; i++) {
+            int64_t current = now_ns();
+            assert(current >= previous);
+            previous = current;
+        }
+
+        int64_t before = now_ns();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int64_t elapsed = now_ns() - before;
+        assert(elapsed >= 20000000LL && elapsed < 2000000000LL);
+        std::cout << "   ✓ Readings track wall time and never go backwards" << std::endl;
+
+        std::cout << "\n✅ All tracing timestamp tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,116 @@
+#include "memory/vector_memory.h"
+#include <iostream>
+#include <cassert>
+#include <random>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+int main() {
+    std::cout << "Testing vector memory retrieval" << std::endl;
+    std::cout << "===============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing graph search against exact search..." << std::endl;
+        const size_t dimension = 32;
+        const size_t count = 2000;
+        std::mt19937 rng(7);
+        std::normal_distribution<float> gaussian;
+        std::vector<std::vector<float>> vectors(count, std::vector<float>(dimension));
+        HnswIndex index(dimension);
+        std::vector<uint64_t> all;
+        for (size_t i = 0; i < count; i++) {
+            for (auto& value : vectors[i]) value = gaussian(rng);
+            index.add(i, vectors[i].data());
+            all.push_back(i);
+        }
+        size_t hits = 0;
+        for (size_t q = 0; q < 50; q++) {
+            auto approximate = index.search(vectors[q * 7].data(), 10);
+            auto exact = index.search_exact(vectors[q * 7].data(), 10, all);
+            assert(approximate.size() == 10 && approximate[0].label == q * 7);
+            for (const auto& match : approximate) {
+                for (const auto& truth : exact) {
+                    if (truth.label == match.label) hits++;
+                }
+            }
+        }
+        assert(hits >= 50 * 10 * 9 / 10);
+        std::cout << "   ✓ Recall@10 is at least 90%" << std::endl;
+
+        std::cout << "\n2. Testing removals are compacted away..." << std::endl;
+        size_t removed = 0;
+        for (size_t i = 0; i < count; i += 4) {
+            assert(index.remove(i));
+            removed++;
+        }
+        assert(!index.remove(0));
+        assert(index.size() == count - removed);
+        assert(index.removed_count() == removed && index.rebuild_count() == 0);
+        for (size_t i = 1; i < count; i += 4) {
+            index.remove(i);
+            index.remove(i + 1);
+        }
+        assert(index.rebuild_count() == 1);
+        assert(index.size() == count / 4);
+        assert(index.node_count() - index.removed_count() == index.size());
+        assert(index.removed_count() < index.size());
+        auto after = index.search(vectors[3].data(), 5);
+        assert(!after.empty() && after[0].label == 3);
+        for (const auto& match : after) assert(match.label % 4 == 3);
+        std::cout << "   ✓ The graph is rebuilt once tombstones dominate" << std::endl;
+
+        std::cout << "\n3. Testing relevant items across sessions..." << std::endl;
+        auto memory = std::make_shared<VectorMemory>(std::make_shared<HashingEmbedder>(128));
+        auto backing = std::make_shared<MemorySession>("vector_a");
+        backing->add_items_sync({message("we talked about the garden tomatoes")});
+        auto session = std::make_shared<VectorMemorySession>(backing, memory);
+        session->add_items_sync({message("the invoice is due friday"),
+                                 message("water the tomatoes in the garden"),
+                                 message("the car needs new tires")});
+        auto other = std::make_shared<VectorMemorySession>(std::make_shared<MemorySession>("vector_b"), memory);
+        other->add_items_sync({message("garden tomatoes need water")});
+
+        auto relevant = session->get_relevant_items("garden tomatoes", 2).get();
+        assert(relevant.size() == 2);
+        for (const auto& item : relevant) {
+            assert(content_of(item).find("tomatoes") != std::string::npos);
+        }
+        assert(memory->search("garden tomatoes", 3).size() == 3);
+        assert(memory->search_session("vector_b", "tires", 5).size() == 1);
+        std::cout << "   ✓ Similar history is returned, scoped to the session" << std::endl;
+
+        std::cout << "\n4. Testing pops and clears leave the index..." << std::endl;
+        session->pop_item_sync();
+        assert(memory->get_session_item_count("vector_a") == 3);
+        session->clear_session_sync();
+        assert(memory->get_session_item_count("vector_a") == 0);
+        auto stats = memory->get_index_stats();
+        assert(stats.live_vectors == 1);
+        assert(stats.removed_vectors + stats.live_vectors <= 5);
+        assert(stats.rebuilds >= 1);
+        std::cout << "   ✓ Index counts follow the sessions" << std::endl;
+
+        std::cout << "\n5. Testing the default falls back to recent items..." << std::endl;
+        MemorySession plain("vector_plain");
+        plain.add_items_sync({message("old"), message("new")});
+        auto recent = plain.get_relevant_items("anything", 1).get();
+        assert(recent.size() == 1 && content_of(recent[0]) == "new");
+        std::cout << "   ✓ Sessions without an index return their newest items" << std::endl;
+
+        std::cout << "\n✅ All vector memory tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
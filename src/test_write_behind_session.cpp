@@ -0,0 +1,120 @@
+#include "memory/session.h"
+#include <iostream>
+#include <cassert>
+
+using namespace openai_agents;
+using namespace openai_agents::memory;
+
+static std::shared_ptr<Item> message(const std::string& content) {
+    return std::make_shared<MessageItem>("user", content);
+}
+
+static std::string content_of(const std::shared_ptr<Item>& item) {
+    return std::static_pointer_cast<MessageItem>(item)->get_content();
+}
+
+// Backing session whose writes always fail
+class FailingSession : public MemorySession {
+public:
+    using MemorySession::MemorySession;
+
+    std::future<void> add_items(const std::vector<std::shared_ptr<Item>>& /*items*/) override {
+        std::promise<void> failed;
+        failed.set_exception(std::make_exception_ptr(std::runtime_error("backing unavailable")));
+        return failed.get_future();
+    }
+};
+
+template<typename Predicate>
+static bool eventually(Predicate predicate) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) return true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return predicate();
+}
+
+int main() {
+    std::cout << "Testing write-behind session" << std::endl;
+    std::cout << "============================" << std::endl;
+
+    try {
+        std::cout << "\n1. Testing reads merge the unflushed tail..." << std::endl;
+        auto backing = std::make_shared<MemorySession>("write_behind");
+        WriteBehindOptions options;
+        options.max_buffered_items = 4;
+        options.max_delay = std::chrono::seconds(60);
+        {
+            auto session = std::make_shared<WriteBehindSession>(backing, options);
+            session->add_items_sync({message("a"), message("b"), message("c")});
+            assert(session->get_buffered_count() == 3);
+            assert(backing->get_item_count() == 0);
+            assert(session->get_item_count() == 3);
+            auto items = session->get_items_sync(2);
+            assert(items.size() == 2 && content_of(items[0]) == "b");
+            assert(content_of(session->pop_item_sync()) == "c");
+            std::cout << "   ✓ Buffered items are visible before they are flushed" << std::endl;
+
+            std::cout << "\n2. Testing the size trigger..." << std::endl;
+            session->add_items_sync({message("d"), message("e"), message("f")});
+            assert(eventually([&]() { return backing->get_item_count() == 5; }));
+            assert(session->get_flushed_count() == 5);
+            assert(session->get_buffered_count() == 0);
+            std::cout << "   ✓ A full buffer is flushed in the background" << std::endl;
+
+            std::cout << "\n3. Testing the destructor flushes..." << std::endl;
+            session->add_items_sync({message("g")});
+        }
+        assert(backing->get_item_count() == 6);
+        assert(content_of(backing->get_items_sync(1)[0]) == "g");
+        std::cout << "   ✓ Pending items reach the backing session" << std::endl;
+
+        std::cout << "\n4. Testing the delay trigger and the durability bound..." << std::endl;
+        auto delayed_backing = std::make_shared<MemorySession>("delayed");
+        WriteBehindOptions delayed;
+        delayed.max_delay = std::chrono::milliseconds(10);
+        auto timed = std::make_shared<WriteBehindSession>(delayed_backing, delayed);
+        timed->add_items_sync({message("late")});
+        assert(eventually([&]() { return delayed_backing->get_item_count() == 1; }));
+
+        auto durable_backing = std::make_shared<MemorySession>("durable");
+        WriteBehindOptions durable;
+        durable.max_unflushed_items = 1;
+        durable.max_delay = std::chrono::seconds(60);
+        auto bounded = std::make_shared<WriteBehindSession>(durable_backing, durable);
+        bounded->add_items_sync({message("now")});
+        assert(durable_backing->get_item_count() == 1);
+        std::cout << "   ✓ Old or over-limit buffers are flushed promptly" << std::endl;
+
+        std::cout << "\n5. Testing scans flush through the future..." << std::endl;
+        auto scanned_backing = std::make_shared<MemorySession>("scanned");
+        auto scanned = std::make_shared<WriteBehindSession>(scanned_backing, options);
+        scanned->add_items_sync({message("x"), message("y")});
+        auto page = scanned->scan(std::nullopt, 10).get();
+        assert(page.items.size() == 2 && content_of(page.items[0]) == "x");
+        assert(scanned->get_buffered_count() == 0);
+        auto reversed = scanned->scan_reverse(std::nullopt, 1).get();
+        assert(reversed.items.size() == 1 && content_of(reversed.items[0]) == "y");
+
+        auto failing = std::make_shared<WriteBehindSession>(std::make_shared<FailingSession>("failing"), options);
+        failing->add_items_sync({message("lost")});
+        auto failed_scan = failing->scan();
+        bool surfaced = false;
+        try {
+            failed_scan.get();
+        } catch (const std::runtime_error&) {
+            surfaced = true;
+        }
+        assert(surfaced);
+        assert(failing->get_buffered_count() == 1);
+        std::cout << "   ✓ Buffered items are paged and flush errors reach the caller's future" << std::endl;
+
+        std::cout << "\n✅ All write-behind session tests passed!" << std::endl;
+        return 0;
+
+    } catch (const std::exception& e) {
+        std::cerr << "\n❌ Test failed with error: " << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -15,8 +15,9 @@ std::unique_ptr<Span<TSpanData>> SpanFactory::create_span_impl(
     auto processor = resolve_processor(options);
     auto span_id = trace_utils::generate_span_id();
     
-    // Check if tracing is disabled
-    if (ScopedTracingContext::is_trace_disabled()) {
+    // Check if tracing is disabled or the head sampler leaves this span out
+    if (ScopedTracingContext::is_trace_disabled() ||
+        (head_sampler_ && !head_sampler_->should_sample(trace_id, span_data))) {
         auto no_op_span = std::make_unique<NoOpSpan<TSpanData>>(span_data);
         if (options.auto_start) {
             no_op_span->start(options.mark_as_current);
@@ -24,6 +25,15 @@ std::unique_ptr<Span<TSpanData>> SpanFactory::create_span_impl(
         return std::move(no_op_span);
     }
     
+    // Under tail sampling the trace manager holds the span until its trace finishes
+    try {
+        if (processor && GlobalTraceManager::is_initialized()) {
+            processor = GlobalTraceManager::instance().get_span_processor(trace_id, processor);
+        }
+    } catch (const std::exception& e) {
+        logger::debug("Failed to resolve span processor: " + std::string(e.what()));
+    }
+    
     // Create real span
     auto span = std::make_unique<SpanImpl<TSpanData>>(
         trace_id, span_id, parent_span_id, span_data, processor
@@ -45,7 +55,7 @@ std::unique_ptr<Span<TSpanData>> SpanFactory::create_span_impl(
     return std::move(span);
 }
 
-std::string SpanFactory::resolve_trace_id(const SpanCreationOptions& options) {
+TraceId SpanFactory::resolve_trace_id(const SpanCreationOptions& options) {
     if (options.trace_id) {
         return *options.trace_id;
     }
@@ -67,7 +77,7 @@ std::string SpanFactory::resolve_trace_id(const SpanCreationOptions& options) {
     return trace_utils::generate_trace_id();
 }
 
-std::optional<std::string> SpanFactory::resolve_parent_span_id(const SpanCreationOptions& options) {
+std::optional<SpanId> SpanFactory::resolve_parent_span_id(const SpanCreationOptions& options) {
     if (options.parent_span_id) {
         return options.parent_span_id;
     }
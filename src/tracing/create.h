@@ -11,6 +11,7 @@
 #include "traces.h"
 #include "scope.h"
 #include "processor_interface.h"
+#include "sampling.h"
 #include <memory>
 #include <functional>
 
@@ -21,8 +22,8 @@ namespace tracing {
  * Span creation options
  */
 struct SpanCreationOptions {
-    std::optional<std::string> trace_id;
-    std::optional<std::string> parent_span_id;
+    std::optional<TraceId> trace_id;
+    std::optional<SpanId> parent_span_id;
     bool auto_start = true;
     bool mark_as_current = false;
     std::shared_ptr<TracingProcessor> processor;
@@ -36,6 +37,7 @@ struct SpanCreationOptions {
 class SpanFactory {
 private:
     std::shared_ptr<TracingProcessor> default_processor_;
+    std::shared_ptr<HeadSampler> head_sampler_;
     
 public:
     /**
@@ -146,6 +148,20 @@ public:
         return default_processor_;
     }
     
+    /**
+     * Set the head sampler; spans it leaves out are created as no-op spans
+     */
+    void set_head_sampler(std::shared_ptr<HeadSampler> sampler) {
+        head_sampler_ = sampler;
+    }
+    
+    /**
+     * Get the head sampler
+     */
+    std::shared_ptr<HeadSampler> get_head_sampler() const {
+        return head_sampler_;
+    }
+    
 private:
     /**
      * Generic span creation helper
@@ -159,12 +175,12 @@ private:
     /**
      * Resolve the trace ID for a new span
      */
-    std::string resolve_trace_id(const SpanCreationOptions& options);
+    TraceId resolve_trace_id(const SpanCreationOptions& options);
     
     /**
      * Resolve the parent span ID
      */
-    std::optional<std::string> resolve_parent_span_id(const SpanCreationOptions& options);
+    std::optional<SpanId> resolve_parent_span_id(const SpanCreationOptions& options);
     
     /**
      * Resolve the processor to use
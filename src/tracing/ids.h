@@ -0,0 +1,244 @@
+#pragma once
+
+/**
+ * Trace and Span IDs for OpenAI Agents Framework Tracing
+ *
+ * IDs are fixed-size byte arrays (16 bytes for traces, 8 for spans) that
+ * are compared, hashed and copied without allocating. They are drawn from
+ * a per-thread xoshiro256** generator, so creating one costs a few
+ * nanoseconds and takes no lock. The string form, a prefix followed by
+ * lowercase hex (trace_<32 hex>, span_<16 hex>), is only produced when
+ * spans and traces are exported.
+ */
+
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace openai_agents {
+namespace tracing {
+
+namespace detail {
+
+inline uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+inline uint64_t rotl(uint64_t x, int k) {
+    return (x << k) | (x >> (64 - k));
+}
+
+// xoshiro256** state, seeded once per thread from std::random_device
+struct RandomState {
+    uint64_t s[4];
+
+    RandomState() {
+        std::random_device device;
+        uint64_t seed = (static_cast<uint64_t>(device()) << 32) ^ device();
+        seed ^= static_cast<uint64_t>(std::hash<const void*>()(this));
+        for (auto& word : s) {
+            word = splitmix64(seed);
+        }
+    }
+
+    uint64_t next() {
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+};
+
+inline int hex_value(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+} // namespace detail
+
+/**
+ * Random 64-bit value from the calling thread's generator
+ */
+inline uint64_t random_u64() {
+    static thread_local detail::RandomState state;
+    return state.next();
+}
+
+/**
+ * Fixed-size identifier; Tag supplies the byte size and string prefix
+ */
+template<typename Tag>
+class FixedId {
+public:
+    static constexpr size_t kSize = Tag::size;
+    static constexpr size_t kHexSize = kSize * 2;
+
+private:
+    std::array<uint8_t, kSize> bytes_{};
+
+public:
+    /**
+     * The all-zero ID, which is never generated
+     */
+    FixedId() = default;
+
+    /**
+     * Generate a new random ID
+     */
+    static FixedId generate() {
+        FixedId id;
+        do {
+            for (size_t i = 0; i < kSize; i += 8) {
+                uint64_t word = random_u64();
+                std::memcpy(id.bytes_.data() + i, &word, 8);
+            }
+        } while (!id.is_valid());
+        return id;
+    }
+
+    /**
+     * Parse the string form, with or without the prefix
+     */
+    static std::optional<FixedId> parse(std::string_view text) {
+        std::string_view prefix(Tag::prefix);
+        if (text.substr(0, prefix.size()) == prefix) {
+            text.remove_prefix(prefix.size());
+        }
+        if (text.size() != kHexSize) {
+            return std::nullopt;
+        }
+
+        FixedId id;
+        for (size_t i = 0; i < kSize; i++) {
+            int high = detail::hex_value(text[2 * i]);
+            int low = detail::hex_value(text[2 * i + 1]);
+            if (high < 0 || low < 0) {
+                return std::nullopt;
+            }
+            id.bytes_[i] = static_cast<uint8_t>((high << 4) | low);
+        }
+        return id;
+    }
+
+    /**
+     * Parse the string form; any other string maps to an ID derived from
+     * its hash, so the same caller-chosen string always gives the same ID
+     */
+    static FixedId from_string(std::string_view text) {
+        if (auto parsed = parse(text)) {
+            return *parsed;
+        }
+
+        uint64_t hash = 0xcbf29ce484222325ULL;
+        for (char c : text) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 0x100000001b3ULL;
+        }
+        FixedId id;
+        for (size_t i = 0; i < kSize; i += 8) {
+            uint64_t word = detail::splitmix64(hash);
+            std::memcpy(id.bytes_.data() + i, &word, 8);
+        }
+        return id;
+    }
+
+    /**
+     * Whether this is a real ID rather than the all-zero default
+     */
+    bool is_valid() const {
+        for (uint8_t byte : bytes_) {
+            if (byte != 0) return true;
+        }
+        return false;
+    }
+
+    const std::array<uint8_t, kSize>& bytes() const { return bytes_; }
+
+    /**
+     * Write kHexSize lowercase hex characters to out, without the prefix
+     */
+    void write_hex(char* out) const {
+        static constexpr char digits[] = "0123456789abcdef";
+        for (size_t i = 0; i < kSize; i++) {
+            out[2 * i] = digits[bytes_[i] >> 4];
+            out[2 * i + 1] = digits[bytes_[i] & 0x0f];
+        }
+    }
+
+    std::string to_hex() const {
+        std::string hex(kHexSize, '0');
+        write_hex(&hex[0]);
+        return hex;
+    }
+
+    /**
+     * The exported form: prefix followed by hex
+     */
+    std::string to_string() const {
+        std::string_view prefix(Tag::prefix);
+        std::string result(prefix.size() + kHexSize, '0');
+        std::memcpy(&result[0], prefix.data(), prefix.size());
+        write_hex(&result[prefix.size()]);
+        return result;
+    }
+
+    /**
+     * The first eight bytes as an integer; uniformly distributed for
+     * generated IDs
+     */
+    uint64_t low_bits() const {
+        uint64_t value;
+        std::memcpy(&value, bytes_.data(), 8);
+        return value;
+    }
+
+    friend bool operator==(const FixedId& a, const FixedId& b) { return a.bytes_ == b.bytes_; }
+    friend bool operator!=(const FixedId& a, const FixedId& b) { return a.bytes_ != b.bytes_; }
+    friend bool operator<(const FixedId& a, const FixedId& b) { return a.bytes_ < b.bytes_; }
+};
+
+struct TraceIdTag {
+    static constexpr size_t size = 16;
+    static constexpr const char* prefix = "trace_";
+};
+
+struct SpanIdTag {
+    static constexpr size_t size = 8;
+    static constexpr const char* prefix = "span_";
+};
+
+using TraceId = FixedId<TraceIdTag>;
+using SpanId = FixedId<SpanIdTag>;
+
+} // namespace tracing
+} // namespace openai_agents
+
+namespace std {
+
+template<typename Tag>
+struct hash<openai_agents::tracing::FixedId<Tag>> {
+    size_t operator()(const openai_agents::tracing::FixedId<Tag>& id) const {
+        // Generated IDs are already random; mix anyway for parsed ones
+        uint64_t value = id.low_bits();
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        return static_cast<size_t>(value);
+    }
+};
+
+} // namespace std
\ No newline at end of file
@@ -13,6 +13,12 @@
 #include <vector>
 #include <optional>
 #include <functional>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
 
 namespace openai_agents {
 namespace tracing {
@@ -324,32 +330,376 @@ public:
 };
 
 /**
- * Async processor that queues operations for background processing
+ * Bounded lock-free queue for many producers and one consumer
+ * 
+ * Each cell carries a sequence number that tells producers whether it is
+ * free and the consumer whether it is filled, so pushes cost one CAS and
+ * pops none. Capacity is rounded up to a power of two.
+ */
+template<typename T>
+class MpscRingBuffer {
+private:
+    struct Cell {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+    
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> tail_{0};  // next slot to claim, shared by producers
+    alignas(64) std::atomic<size_t> head_{0};  // next slot to read, written by the consumer only
+    
+public:
+    explicit MpscRingBuffer(size_t capacity) {
+        size_t size = 2;
+        while (size < capacity) {
+            size <<= 1;
+        }
+        cells_ = std::make_unique<Cell[]>(size);
+        mask_ = size - 1;
+        for (size_t i = 0; i < size; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+    
+    MpscRingBuffer(const MpscRingBuffer&) = delete;
+    MpscRingBuffer& operator=(const MpscRingBuffer&) = delete;
+    
+    /**
+     * Add a value; returns false without blocking if the queue is full
+     */
+    bool try_push(T&& value) {
+        size_t position = tail_.load(std::memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells_[position & mask_];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+            if (lag == 0) {
+                if (tail_.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (lag < 0) {
+                return false;
+            } else {
+                position = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+    
+    /**
+     * Take the oldest value; consumer thread only
+     */
+    bool try_pop(T& value) {
+        size_t position = head_.load(std::memory_order_relaxed);
+        Cell& cell = cells_[position & mask_];
+        size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        if (static_cast<std::ptrdiff_t>(sequence - (position + 1)) < 0) {
+            return false;
+        }
+        value = std::move(cell.value);
+        cell.value = T();
+        cell.sequence.store(position + mask_ + 1, std::memory_order_release);
+        head_.store(position + 1, std::memory_order_relaxed);
+        return true;
+    }
+    
+    size_t size_approx() const {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t head = head_.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+    
+    size_t capacity() const { return mask_ + 1; }
+};
+
+/**
+ * What AsyncProcessor does when its queue is full
+ */
+enum class OverflowPolicy {
+    Drop,   // discard the record and count it; the caller never waits
+    Block   // wait for the exporter to make room
+};
+
+struct AsyncProcessorOptions {
+    size_t queue_capacity = 8192;
+    size_t max_batch_size = 512;
+    // Longest a record waits before the exporter wakes on its own
+    std::chrono::milliseconds max_delay{200};
+    OverflowPolicy overflow_policy = OverflowPolicy::Drop;
+};
+
+/**
+ * Async processor that exports from a background thread
+ * 
+ * Callers push records into a lock-free ring and return at once; they
+ * only touch the exporter's lock to wake it when the queue is half full,
+ * or to sleep until the exporter makes room under OverflowPolicy::Block.
+ * The exporter thread drains the ring every max_delay, passing spans to
+ * the wrapped processor through process_spans_batch. Spans and traces
+ * reach it in the order they were queued. flush() waits until everything
+ * queued before it has been exported, and stopping exports every record
+ * that was accepted.
  */
 class AsyncProcessor : public TracingProcessor {
 private:
+    struct Record {
+        bool is_trace = false;
+        nlohmann::json data;
+    };
+    
     std::unique_ptr<TracingProcessor> processor_;
-    // Implementation would include threading and queueing
-    // This is a simplified interface
+    AsyncProcessorOptions options_;
+    MpscRingBuffer<Record> queue_;
+    
+    std::atomic<uint64_t> enqueued_{0};
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<uint64_t> exported_{0};
+    std::atomic<uint64_t> failed_{0};
+    
+    mutable std::mutex mutex_;
+    std::condition_variable wake_cv_;
+    std::condition_variable drained_cv_;
+    std::condition_variable space_cv_;
+    std::atomic<bool> exporter_waiting_{false};
+    std::atomic<uint32_t> blocked_producers_{0};
+    std::atomic<uint32_t> active_producers_{0};
+    uint64_t flush_target_ = 0;
+    bool stopping_ = false;
+    std::atomic<bool> stopped_{false};
+    std::thread exporter_;
     
 public:
-    explicit AsyncProcessor(std::unique_ptr<TracingProcessor> processor)
-        : processor_(std::move(processor)) {}
+    explicit AsyncProcessor(
+        std::unique_ptr<TracingProcessor> processor,
+        const AsyncProcessorOptions& options = AsyncProcessorOptions()
+    ) : processor_(std::move(processor)),
+        options_(options),
+        queue_(options.queue_capacity) {
+        options_.max_batch_size = std::max<size_t>(options_.max_batch_size, 1);
+        exporter_ = std::thread([this]() { run(); });
+    }
+    
+    ~AsyncProcessor() override {
+        stop();
+    }
     
     void process_span(const nlohmann::json& span_data) override {
-        // Queue for async processing
-        processor_->process_span(span_data);
+        enqueue(Record{false, span_data});
     }
     
     void process_trace(const nlohmann::json& trace_data) override {
-        // Queue for async processing
-        processor_->process_trace(trace_data);
+        enqueue(Record{true, trace_data});
     }
     
-    void flush() override { processor_->flush(); }
-    void shutdown() override { processor_->shutdown(); }
-    nlohmann::json get_config() const override { return processor_->get_config(); }
-    nlohmann::json get_status() const override { return processor_->get_status(); }
+    void process_spans_batch(const std::vector<nlohmann::json>& spans_data) override {
+        for (const auto& span_data : spans_data) {
+            enqueue(Record{false, span_data});
+        }
+    }
+    
+    void process_traces_batch(const std::vector<nlohmann::json>& traces_data) override {
+        for (const auto& trace_data : traces_data) {
+            enqueue(Record{true, trace_data});
+        }
+    }
+    
+    void flush() override {
+        if (!stopped_.load()) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            uint64_t target = enqueued_.load();
+            flush_target_ = std::max(flush_target_, target);
+            wake_cv_.notify_one();
+            drained_cv_.wait(lock, [this, target]() {
+                return stopping_ || exported_.load() + failed_.load() >= target;
+            });
+        }
+        processor_->flush();
+    }
+    
+    void shutdown() override {
+        stop();
+        processor_->shutdown();
+    }
+    
+    nlohmann::json get_config() const override {
+        return nlohmann::json{
+            {"type", "async"},
+            {"queue_capacity", queue_.capacity()},
+            {"max_batch_size", options_.max_batch_size},
+            {"max_delay_ms", options_.max_delay.count()},
+            {"overflow_policy", options_.overflow_policy == OverflowPolicy::Drop ? "drop" : "block"},
+            {"processor", processor_->get_config()}
+        };
+    }
+    
+    nlohmann::json get_status() const override {
+        return nlohmann::json{
+            {"status", stopped_.load() ? "stopped" : "active"},
+            {"queued", queue_.size_approx()},
+            {"enqueued", get_enqueued_count()},
+            {"dropped", get_dropped_count()},
+            {"exported", get_exported_count()},
+            {"failed", get_failed_count()},
+            {"processor", processor_->get_status()}
+        };
+    }
+    
+    uint64_t get_enqueued_count() const { return enqueued_.load(std::memory_order_relaxed); }
+    uint64_t get_dropped_count() const { return dropped_.load(std::memory_order_relaxed); }
+    uint64_t get_exported_count() const { return exported_.load(std::memory_order_relaxed); }
+    uint64_t get_failed_count() const { return failed_.load(std::memory_order_relaxed); }
+    
+private:
+    void enqueue(Record&& record) {
+        // Counted before stopped_ is checked, so stop() can wait out pushes
+        // that raced it and export what they left in the queue
+        struct Active {
+            std::atomic<uint32_t>& producers;
+            ~Active() { producers.fetch_sub(1); }
+        };
+        active_producers_.fetch_add(1);
+        Active active{active_producers_};
+        
+        if (stopped_.load()) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        
+        while (!queue_.try_push(std::move(record))) {
+            if (options_.overflow_policy == OverflowPolicy::Drop || stopped_.load()) {
+                dropped_.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wait_for_space();
+        }
+        enqueued_.fetch_add(1, std::memory_order_relaxed);
+        
+        // Only a filling queue is worth a wakeup; otherwise the exporter's
+        // own timer picks the record up
+        if (queue_.size_approx() * 2 >= queue_.capacity() &&
+            exporter_waiting_.load(std::memory_order_relaxed)) {
+            wake_exporter();
+        }
+    }
+    
+    void wake_exporter() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        wake_cv_.notify_one();
+    }
+    
+    // Sleeps until the exporter has popped records; the timeout only
+    // bounds the wait if a wakeup is missed
+    void wait_for_space() {
+        std::unique_lock<std::mutex> lock(mutex_);
+        blocked_producers_.fetch_add(1);
+        // Pairs with the exporter's fence, so either it sees this producer
+        // or the predicate below sees its pops
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wake_cv_.notify_one();
+        space_cv_.wait_for(lock, options_.max_delay, [this]() {
+            return stopping_ || queue_.size_approx() < queue_.capacity();
+        });
+        blocked_producers_.fetch_sub(1);
+    }
+    
+    void stop() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (stopping_) return;
+            stopping_ = true;
+        }
+        stopped_.store(true);
+        wake_cv_.notify_one();
+        space_cv_.notify_all();
+        if (exporter_.joinable()) {
+            exporter_.join();
+        }
+        
+        // Producers that passed the stopped_ check before it was set may
+        // have pushed after the exporter's last pass
+        while (active_producers_.load() != 0) {
+            std::this_thread::yield();
+        }
+        std::vector<Record> records;
+        std::vector<nlohmann::json> spans;
+        Record record;
+        while (queue_.try_pop(record)) {
+            records.push_back(std::move(record));
+        }
+        export_records(records, spans);
+        
+        std::lock_guard<std::mutex> lock(mutex_);
+        drained_cv_.notify_all();
+    }
+    
+    void run() {
+        std::vector<Record> records;
+        std::vector<nlohmann::json> spans;
+        records.reserve(options_.max_batch_size);
+        
+        while (true) {
+            records.clear();
+            Record record;
+            while (records.size() < options_.max_batch_size && queue_.try_pop(record)) {
+                records.push_back(std::move(record));
+            }
+            
+            if (!records.empty()) {
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (blocked_producers_.load(std::memory_order_relaxed) > 0) {
+                    std::lock_guard<std::mutex> lock(mutex_);
+                    space_cv_.notify_all();
+                }
+                export_records(records, spans);
+                std::lock_guard<std::mutex> lock(mutex_);
+                drained_cv_.notify_all();
+                continue;
+            }
+            
+            // Queue is empty: producers that stopped pushing have been exported
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (stopping_ && queue_.size_approx() == 0) {
+                break;
+            }
+            drained_cv_.notify_all();
+            exporter_waiting_.store(true, std::memory_order_relaxed);
+            wake_cv_.wait_for(lock, options_.max_delay, [this]() {
+                return stopping_ || (blocked_producers_.load() > 0 && queue_.size_approx() > 0) ||
+                       flush_target_ > exported_.load() + failed_.load();
+            });
+            exporter_waiting_.store(false, std::memory_order_relaxed);
+        }
+    }
+    
+    void export_records(std::vector<Record>& records, std::vector<nlohmann::json>& spans) {
+        auto export_spans = [this, &spans]() {
+            if (spans.empty()) return;
+            try {
+                processor_->process_spans_batch(spans);
+                exported_.fetch_add(spans.size());
+            } catch (const std::exception&) {
+                failed_.fetch_add(spans.size());
+            }
+            spans.clear();
+        };
+        
+        for (auto& record : records) {
+            if (!record.is_trace) {
+                spans.push_back(std::move(record.data));
+                continue;
+            }
+            export_spans();
+            try {
+                processor_->process_trace(record.data);
+                exported_.fetch_add(1);
+            } catch (const std::exception&) {
+                failed_.fetch_add(1);
+            }
+        }
+        export_spans();
+    }
 };
 
 /**
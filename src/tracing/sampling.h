@@ -0,0 +1,123 @@
+#pragma once
+
+/**
+ * Trace Sampling for OpenAI Agents Framework Tracing
+ *
+ * Head sampling decides when a span is created whether it is recorded at
+ * all. The decision is a threshold on the trace ID, so every process and
+ * thread makes the same choice for a trace, and a trace kept at some rate
+ * is also kept at every higher rate. Rates can differ per span type and
+ * per agent name.
+ *
+ * Tail sampling is configured on TraceManager: spans are held back until
+ * their trace finishes, then exported only if the trace had an error,
+ * ran longer than a latency threshold, or passes a rate.
+ */
+
+#include "ids.h"
+#include "span_data.h"
+#include <algorithm>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace openai_agents {
+namespace tracing {
+
+/**
+ * Whether a trace falls within the given sampling rate (0.0 to 1.0)
+ */
+inline bool sample_trace_id(const TraceId& trace_id, double rate) {
+    if (rate >= 1.0) return true;
+    if (rate <= 0.0) return false;
+    // Top 53 bits of the ID as a uniform value in [0, 1)
+    double position = static_cast<double>(trace_id.low_bits() >> 11) * (1.0 / 9007199254740992.0);
+    return position < rate;
+}
+
+/**
+ * Head sampling rates
+ */
+struct HeadSamplingOptions {
+    // Rate for spans without a more specific rate
+    double default_rate = 1.0;
+    // Rates by span type, e.g. "generation" or "function"
+    std::unordered_map<std::string, double> span_type_rates;
+    // Rates for agent spans by agent name; override span_type_rates
+    std::unordered_map<std::string, double> agent_rates;
+};
+
+/**
+ * Deterministic head sampler keyed on trace ID
+ */
+class HeadSampler {
+private:
+    HeadSamplingOptions options_;
+
+public:
+    explicit HeadSampler(const HeadSamplingOptions& options = HeadSamplingOptions{})
+        : options_(options) {}
+
+    /**
+     * Get the rate that applies to a span
+     */
+    double get_rate(const SpanData& span_data) const {
+        if (!options_.agent_rates.empty()) {
+            if (auto agent = dynamic_cast<const AgentSpanData*>(&span_data)) {
+                auto it = options_.agent_rates.find(agent->name);
+                if (it != options_.agent_rates.end()) {
+                    return it->second;
+                }
+            }
+        }
+        if (!options_.span_type_rates.empty()) {
+            auto it = options_.span_type_rates.find(span_data.get_type());
+            if (it != options_.span_type_rates.end()) {
+                return it->second;
+            }
+        }
+        return options_.default_rate;
+    }
+
+    /**
+     * Check if a span in the given trace should be recorded
+     */
+    bool should_sample(const TraceId& trace_id, const SpanData& span_data) const {
+        return sample_trace_id(trace_id, get_rate(span_data));
+    }
+
+    const HeadSamplingOptions& get_options() const { return options_; }
+};
+
+/**
+ * Tail sampling policy; a finished trace is exported if any rule keeps it
+ */
+struct TailSamplingOptions {
+    // Keep traces with at least one span that recorded an error
+    bool keep_errors = true;
+    // Keep traces that ran at least this long
+    std::optional<std::chrono::nanoseconds> latency_threshold;
+    // Fraction of the remaining traces to keep
+    double rate = 0.0;
+    // A trace buffering more spans than this is kept and passed through
+    // from then on, so a runaway trace cannot exhaust memory
+    size_t max_spans_per_trace = 10000;
+};
+
+/**
+ * Tail sampling counters
+ */
+struct TailSamplingStats {
+    size_t traces_kept = 0;
+    size_t traces_dropped = 0;
+    size_t kept_for_error = 0;
+    size_t kept_for_latency = 0;
+    size_t kept_for_rate = 0;
+    size_t kept_for_overflow = 0;
+    size_t spans_dropped = 0;
+    size_t buffered_spans = 0;
+};
+
+} // namespace tracing
+} // namespace openai_agents
\ No newline at end of file
@@ -1,4 +1,5 @@
 #include "scope.h"
+#include <atomic>
 
 namespace openai_agents {
 namespace tracing {
@@ -6,5 +7,14 @@ namespace tracing {
 // Thread-local storage for tracing context
 thread_local TracingContext ThreadLocalContext::context_;
 
+std::optional<size_t> ScopedTracingContext::allocate_extension_slot() {
+    static std::atomic<size_t> next_slot{0};
+    size_t slot = next_slot.fetch_add(1);
+    if (slot >= TracingSlots::kExtensionSlots) {
+        return std::nullopt;
+    }
+    return slot;
+}
+
 } // namespace tracing
 } // namespace openai_agents
\ No newline at end of file
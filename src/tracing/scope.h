@@ -7,6 +7,7 @@
  * similar to Python's contextvars but implemented for C++.
  */
 
+#include "ids.h"
 #include <string>
 #include <optional>
 #include <unordered_map>
@@ -14,28 +15,103 @@
 #include <thread>
 #include <mutex>
 #include <any>
+#include <array>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 namespace openai_agents {
 namespace tracing {
 
+/**
+ * Fixed-layout part of the tracing context
+ * 
+ * The current trace ID, span ID and disabled flag are plain fields, so
+ * reading, changing, saving and restoring them is a few loads and
+ * stores. A small extension area gives other components integer slots
+ * with the same cost (see ScopedTracingContext::allocate_extension_slot).
+ */
+struct TracingSlots {
+    static constexpr size_t kExtensionSlots = 4;
+    
+    TraceId trace_id;
+    SpanId span_id;
+    bool has_trace_id = false;
+    bool has_span_id = false;
+    bool disabled = false;
+    uint8_t extension_mask = 0;  // bit i set when extensions[i] holds a value
+    std::array<uint64_t, kExtensionSlots> extensions{};
+};
+
 /**
  * Thread-local context storage for tracing information
  * 
  * This class manages tracing context in a thread-safe manner,
  * providing the equivalent of Python's contextvars functionality.
+ * The built-in keys are stored in TracingSlots; any other key goes to
+ * a copy-on-write map, so copying a context never allocates and only
+ * writes to the map do.
  */
 class TracingContext {
+public:
+    // Built-in keys, backed by the fixed slots
+    static constexpr const char* CURRENT_TRACE_ID = "current_trace_id";
+    static constexpr const char* CURRENT_SPAN_ID = "current_span_id";
+    static constexpr const char* TRACE_DISABLED = "trace_disabled";
+    
 private:
-    std::unordered_map<std::string, std::any> context_vars_;
+    using Variables = std::unordered_map<std::string, std::any>;
+    
+    TracingSlots slots_;
+    std::shared_ptr<const Variables> context_vars_;
+    
+    // Copy of the variables for writing; shared copies are left untouched
+    Variables& mutable_vars() {
+        auto vars = context_vars_ ? std::make_shared<Variables>(*context_vars_) : std::make_shared<Variables>();
+        Variables& result = *vars;
+        context_vars_ = std::move(vars);
+        return result;
+    }
     
 public:
+    /**
+     * Get the fixed slots
+     */
+    TracingSlots& slots() { return slots_; }
+    const TracingSlots& slots() const { return slots_; }
+    
     /**
      * Get a context variable
+     * 
+     * Built-in keys read the slots: IDs as TraceId/SpanId or as their
+     * string form, the disabled flag as bool.
      */
     template<typename T>
     std::optional<T> get(const std::string& key) const {
-        auto it = context_vars_.find(key);
-        if (it != context_vars_.end()) {
+        if (key == CURRENT_TRACE_ID) {
+            if (!slots_.has_trace_id) return std::nullopt;
+            if constexpr (std::is_same_v<T, TraceId>) return slots_.trace_id;
+            else if constexpr (std::is_same_v<T, std::string>) return slots_.trace_id.to_string();
+            else return std::nullopt;
+        }
+        if (key == CURRENT_SPAN_ID) {
+            if (!slots_.has_span_id) return std::nullopt;
+            if constexpr (std::is_same_v<T, SpanId>) return slots_.span_id;
+            else if constexpr (std::is_same_v<T, std::string>) return slots_.span_id.to_string();
+            else return std::nullopt;
+        }
+        if (key == TRACE_DISABLED) {
+            if (!slots_.disabled) return std::nullopt;
+            if constexpr (std::is_same_v<T, bool>) return true;
+            else return std::nullopt;
+        }
+        
+        if (!context_vars_) {
+            return std::nullopt;
+        }
+        auto it = context_vars_->find(key);
+        if (it != context_vars_->end()) {
             try {
                 return std::any_cast<T>(it->second);
             } catch (const std::bad_any_cast&) {
@@ -47,31 +123,72 @@ public:
     
     /**
      * Set a context variable
+     * 
+     * Built-in keys accept the types get() returns for them; values of
+     * other types are ignored.
      */
     template<typename T>
     void set(const std::string& key, const T& value) {
-        context_vars_[key] = value;
+        if (key == CURRENT_TRACE_ID) {
+            if constexpr (std::is_same_v<T, TraceId>) {
+                slots_.trace_id = value;
+                slots_.has_trace_id = true;
+            } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+                slots_.trace_id = TraceId::from_string(value);
+                slots_.has_trace_id = true;
+            }
+            return;
+        }
+        if (key == CURRENT_SPAN_ID) {
+            if constexpr (std::is_same_v<T, SpanId>) {
+                slots_.span_id = value;
+                slots_.has_span_id = true;
+            } else if constexpr (std::is_convertible_v<T, std::string_view>) {
+                slots_.span_id = SpanId::from_string(value);
+                slots_.has_span_id = true;
+            }
+            return;
+        }
+        if (key == TRACE_DISABLED) {
+            if constexpr (std::is_same_v<T, bool>) {
+                slots_.disabled = value;
+            }
+            return;
+        }
+        mutable_vars()[key] = value;
     }
     
     /**
      * Remove a context variable
      */
     void remove(const std::string& key) {
-        context_vars_.erase(key);
+        if (key == CURRENT_TRACE_ID) {
+            slots_.has_trace_id = false;
+        } else if (key == CURRENT_SPAN_ID) {
+            slots_.has_span_id = false;
+        } else if (key == TRACE_DISABLED) {
+            slots_.disabled = false;
+        } else if (context_vars_ && context_vars_->count(key)) {
+            mutable_vars().erase(key);
+        }
     }
     
     /**
      * Clear all context variables
      */
     void clear() {
-        context_vars_.clear();
+        slots_ = TracingSlots{};
+        context_vars_.reset();
     }
     
     /**
      * Check if a context variable exists
      */
     bool has(const std::string& key) const {
-        return context_vars_.find(key) != context_vars_.end();
+        if (key == CURRENT_TRACE_ID) return slots_.has_trace_id;
+        if (key == CURRENT_SPAN_ID) return slots_.has_span_id;
+        if (key == TRACE_DISABLED) return slots_.disabled;
+        return context_vars_ && context_vars_->find(key) != context_vars_->end();
     }
     
     /**
@@ -79,31 +196,16 @@ public:
      */
     std::vector<std::string> keys() const {
         std::vector<std::string> result;
-        for (const auto& [key, _] : context_vars_) {
-            result.push_back(key);
+        if (slots_.has_trace_id) result.push_back(CURRENT_TRACE_ID);
+        if (slots_.has_span_id) result.push_back(CURRENT_SPAN_ID);
+        if (slots_.disabled) result.push_back(TRACE_DISABLED);
+        if (context_vars_) {
+            for (const auto& [key, _] : *context_vars_) {
+                result.push_back(key);
+            }
         }
         return result;
     }
-    
-    /**
-     * Copy constructor
-     */
-    TracingContext(const TracingContext& other) : context_vars_(other.context_vars_) {}
-    
-    /**
-     * Assignment operator
-     */
-    TracingContext& operator=(const TracingContext& other) {
-        if (this != &other) {
-            context_vars_ = other.context_vars_;
-        }
-        return *this;
-    }
-    
-    /**
-     * Default constructor
-     */
-    TracingContext() = default;
 };
 
 /**
@@ -123,6 +225,13 @@ public:
         return context_;
     }
     
+    /**
+     * Get the current thread's fixed slots
+     */
+    static TracingSlots& slots() {
+        return context_.slots();
+    }
+    
     /**
      * Get a copy of the current context
      */
@@ -149,6 +258,8 @@ public:
  * RAII context manager for scoped context changes
  * 
  * Automatically restores the previous context when the scope ends.
+ * Saving and restoring copy the fixed slots and a pointer to the
+ * variables, so neither allocates.
  */
 class ScopedContext {
 private:
@@ -156,6 +267,12 @@ private:
     bool should_restore_;
     
 public:
+    /**
+     * Save the current context, to be restored when the scope ends
+     */
+    ScopedContext()
+        : previous_context_(ThreadLocalContext::copy()), should_restore_(true) {}
+    
     /**
      * Create a scoped context with the given context
      */
@@ -227,103 +344,163 @@ public:
 class ScopedTracingContext {
 public:
     // Context variable keys
-    static constexpr const char* CURRENT_TRACE_ID = "current_trace_id";
-    static constexpr const char* CURRENT_SPAN_ID = "current_span_id";
-    static constexpr const char* TRACE_DISABLED = "trace_disabled";
+    static constexpr const char* CURRENT_TRACE_ID = TracingContext::CURRENT_TRACE_ID;
+    static constexpr const char* CURRENT_SPAN_ID = TracingContext::CURRENT_SPAN_ID;
+    static constexpr const char* TRACE_DISABLED = TracingContext::TRACE_DISABLED;
     
     /**
      * Get the current trace ID
      */
-    static std::optional<std::string> get_current_trace_id() {
-        return ThreadLocalContext::current().get<std::string>(CURRENT_TRACE_ID);
+    static std::optional<TraceId> get_current_trace_id() {
+        const auto& slots = ThreadLocalContext::slots();
+        return slots.has_trace_id ? std::optional<TraceId>(slots.trace_id) : std::nullopt;
     }
     
     /**
      * Set the current trace ID
      */
-    static void set_current_trace_id(const std::string& trace_id) {
-        ThreadLocalContext::current().set(CURRENT_TRACE_ID, trace_id);
+    static void set_current_trace_id(const TraceId& trace_id) {
+        auto& slots = ThreadLocalContext::slots();
+        slots.trace_id = trace_id;
+        slots.has_trace_id = true;
     }
     
     /**
      * Reset the current trace ID
      */
     static void reset_current_trace() {
-        ThreadLocalContext::current().remove(CURRENT_TRACE_ID);
+        ThreadLocalContext::slots().has_trace_id = false;
     }
     
     /**
      * Get the current span ID
      */
-    static std::optional<std::string> get_current_span_id() {
-        return ThreadLocalContext::current().get<std::string>(CURRENT_SPAN_ID);
+    static std::optional<SpanId> get_current_span_id() {
+        const auto& slots = ThreadLocalContext::slots();
+        return slots.has_span_id ? std::optional<SpanId>(slots.span_id) : std::nullopt;
     }
     
     /**
      * Set the current span ID
      */
-    static void set_current_span_id(const std::string& span_id) {
-        ThreadLocalContext::current().set(CURRENT_SPAN_ID, span_id);
+    static void set_current_span_id(const SpanId& span_id) {
+        auto& slots = ThreadLocalContext::slots();
+        slots.span_id = span_id;
+        slots.has_span_id = true;
     }
     
     /**
      * Reset the current span ID
      */
     static void reset_current_span() {
-        ThreadLocalContext::current().remove(CURRENT_SPAN_ID);
+        ThreadLocalContext::slots().has_span_id = false;
     }
     
     /**
      * Check if tracing is disabled
      */
     static bool is_trace_disabled() {
-        auto disabled = ThreadLocalContext::current().get<bool>(TRACE_DISABLED);
-        return disabled.value_or(false);
+        return ThreadLocalContext::slots().disabled;
     }
     
     /**
      * Disable tracing for the current context
      */
     static void disable_tracing() {
-        ThreadLocalContext::current().set(TRACE_DISABLED, true);
+        ThreadLocalContext::slots().disabled = true;
     }
     
     /**
      * Enable tracing for the current context
      */
     static void enable_tracing() {
-        ThreadLocalContext::current().remove(TRACE_DISABLED);
+        ThreadLocalContext::slots().disabled = false;
+    }
+    
+    /**
+     * Reserve one of the TracingSlots::kExtensionSlots extension slots for
+     * the caller's use, process-wide; nullopt once all are taken
+     */
+    static std::optional<size_t> allocate_extension_slot();
+    
+    /**
+     * Get the value in an extension slot
+     */
+    static std::optional<uint64_t> get_extension(size_t slot) {
+        const auto& slots = ThreadLocalContext::slots();
+        if (slot >= TracingSlots::kExtensionSlots || !(slots.extension_mask & (1u << slot))) {
+            return std::nullopt;
+        }
+        return slots.extensions[slot];
+    }
+    
+    /**
+     * Set the value in an extension slot
+     */
+    static void set_extension(size_t slot, uint64_t value) {
+        if (slot >= TracingSlots::kExtensionSlots) {
+            return;
+        }
+        auto& slots = ThreadLocalContext::slots();
+        slots.extensions[slot] = value;
+        slots.extension_mask = static_cast<uint8_t>(slots.extension_mask | (1u << slot));
+    }
+    
+    /**
+     * Reset an extension slot
+     */
+    static void reset_extension(size_t slot) {
+        if (slot >= TracingSlots::kExtensionSlots) {
+            return;
+        }
+        auto& slots = ThreadLocalContext::slots();
+        slots.extension_mask = static_cast<uint8_t>(slots.extension_mask & ~(1u << slot));
     }
     
     /**
      * Create a scoped trace context
      */
-    static ScopedContext create_trace_scope(const std::string& trace_id) {
-        return ScopedContext(CURRENT_TRACE_ID, trace_id);
+    static ScopedContext create_trace_scope(const TraceId& trace_id) {
+        ScopedContext scope;
+        set_current_trace_id(trace_id);
+        return scope;
     }
     
     /**
      * Create a scoped span context
      */
-    static ScopedContext create_span_scope(const std::string& span_id) {
-        return ScopedContext(CURRENT_SPAN_ID, span_id);
+    static ScopedContext create_span_scope(const SpanId& span_id) {
+        ScopedContext scope;
+        set_current_span_id(span_id);
+        return scope;
     }
     
     /**
      * Create a scoped trace and span context
      */
-    static ScopedContext create_trace_span_scope(const std::string& trace_id, const std::string& span_id) {
-        auto context = ThreadLocalContext::copy();
-        context.set(CURRENT_TRACE_ID, trace_id);
-        context.set(CURRENT_SPAN_ID, span_id);
-        return ScopedContext(context);
+    static ScopedContext create_trace_span_scope(const TraceId& trace_id, const SpanId& span_id) {
+        ScopedContext scope;
+        set_current_trace_id(trace_id);
+        set_current_span_id(span_id);
+        return scope;
     }
     
     /**
      * Create a scoped disabled tracing context
      */
     static ScopedContext create_disabled_scope() {
-        return ScopedContext(TRACE_DISABLED, true);
+        ScopedContext scope;
+        disable_tracing();
+        return scope;
+    }
+    
+    /**
+     * Create a scoped extension slot value
+     */
+    static ScopedContext create_extension_scope(size_t slot, uint64_t value) {
+        ScopedContext scope;
+        set_extension(slot, value);
+        return scope;
     }
     
     /**
@@ -341,12 +518,12 @@ public:
         
         auto trace_id = get_current_trace_id();
         if (trace_id) {
-            snapshot[CURRENT_TRACE_ID] = *trace_id;
+            snapshot[CURRENT_TRACE_ID] = trace_id->to_string();
         }
         
         auto span_id = get_current_span_id();
         if (span_id) {
-            snapshot[CURRENT_SPAN_ID] = *span_id;
+            snapshot[CURRENT_SPAN_ID] = span_id->to_string();
         }
         
         if (is_trace_disabled()) {
@@ -364,12 +541,12 @@ public:
         
         auto trace_it = snapshot.find(CURRENT_TRACE_ID);
         if (trace_it != snapshot.end()) {
-            context.set(CURRENT_TRACE_ID, trace_it->second);
+            context.set(CURRENT_TRACE_ID, TraceId::from_string(trace_it->second));
         }
         
         auto span_it = snapshot.find(CURRENT_SPAN_ID);
         if (span_it != snapshot.end()) {
-            context.set(CURRENT_SPAN_ID, span_it->second);
+            context.set(CURRENT_SPAN_ID, SpanId::from_string(span_it->second));
         }
         
         auto disabled_it = snapshot.find(TRACE_DISABLED);
@@ -390,7 +567,7 @@ namespace context_utils {
  * Run a function with a specific tracing context
  */
 template<typename Func>
-auto with_trace_context(const std::string& trace_id, Func&& func) -> decltype(func()) {
+auto with_trace_context(const TraceId& trace_id, Func&& func) -> decltype(func()) {
     auto scope = ScopedTracingContext::create_trace_scope(trace_id);
     return func();
 }
@@ -399,7 +576,7 @@ auto with_trace_context(const std::string& trace_id, Func&& func) -> decltype(fu
  * Run a function with a specific span context
  */
 template<typename Func>
-auto with_span_context(const std::string& span_id, Func&& func) -> decltype(func()) {
+auto with_span_context(const SpanId& span_id, Func&& func) -> decltype(func()) {
     auto scope = ScopedTracingContext::create_span_scope(span_id);
     return func();
 }
@@ -417,7 +594,7 @@ auto with_disabled_tracing(Func&& func) -> decltype(func()) {
  * Run a function with a complete trace and span context
  */
 template<typename Func>
-auto with_trace_span_context(const std::string& trace_id, const std::string& span_id, Func&& func) -> decltype(func()) {
+auto with_trace_span_context(const TraceId& trace_id, const SpanId& span_id, Func&& func) -> decltype(func()) {
     auto scope = ScopedTracingContext::create_trace_span_scope(trace_id, span_id);
     return func();
 }
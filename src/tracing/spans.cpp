@@ -1,31 +1,15 @@
 #include "spans.h"
 #include "processor_interface.h"
 #include "scope.h"
-#include <sstream>
-#include <iomanip>
-#include <ctime>
 
 namespace openai_agents {
 namespace tracing {
 
-template<typename TSpanData>
-std::string SpanImpl<TSpanData>::current_time_iso() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-    return ss.str();
-}
-
 template<typename TSpanData>
 SpanImpl<TSpanData>::SpanImpl(
-    const std::string& trace_id,
-    const std::string& span_id,
-    const std::optional<std::string>& parent_id,
+    const TraceId& trace_id,
+    const SpanId& span_id,
+    const std::optional<SpanId>& parent_id,
     const TSpanData& span_data,
     std::shared_ptr<TracingProcessor> processor
 ) : trace_id_(trace_id),
@@ -37,7 +21,7 @@ SpanImpl<TSpanData>::SpanImpl(
 
 template<typename TSpanData>
 void SpanImpl<TSpanData>::start(bool mark_as_current) {
-    started_at_ = current_time_iso();
+    started_at_ = now_ns();
     
     if (mark_as_current) {
         is_current_ = true;
@@ -52,7 +36,7 @@ void SpanImpl<TSpanData>::start(bool mark_as_current) {
 
 template<typename TSpanData>
 void SpanImpl<TSpanData>::finish(bool reset_current) {
-    ended_at_ = current_time_iso();
+    ended_at_ = now_ns();
     
     if (reset_current || is_current_) {
         try {
@@ -82,17 +66,17 @@ std::optional<nlohmann::json> SpanImpl<TSpanData>::export_span() const {
     try {
         nlohmann::json span_json;
         
-        span_json["trace_id"] = trace_id_;
-        span_json["span_id"] = span_id_;
+        span_json["trace_id"] = trace_id_.to_string();
+        span_json["span_id"] = span_id_.to_string();
         if (parent_id_) {
-            span_json["parent_id"] = *parent_id_;
+            span_json["parent_id"] = parent_id_->to_string();
         }
         
         if (started_at_) {
-            span_json["started_at"] = *started_at_;
+            span_json["started_at"] = format_timestamp(*started_at_);
         }
         if (ended_at_) {
-            span_json["ended_at"] = *ended_at_;
+            span_json["ended_at"] = format_timestamp(*ended_at_);
         }
         
         // Export span data
@@ -155,17 +139,17 @@ std::optional<nlohmann::json> AnySpan::export_span() const {
     try {
         nlohmann::json span_json;
         
-        span_json["trace_id"] = trace_id_;
-        span_json["span_id"] = span_id_;
+        span_json["trace_id"] = trace_id_.to_string();
+        span_json["span_id"] = span_id_.to_string();
         if (parent_id_) {
-            span_json["parent_id"] = *parent_id_;
+            span_json["parent_id"] = parent_id_->to_string();
         }
         
         if (started_at_) {
-            span_json["started_at"] = *started_at_;
+            span_json["started_at"] = format_timestamp(*started_at_);
         }
         if (ended_at_) {
-            span_json["ended_at"] = *ended_at_;
+            span_json["ended_at"] = format_timestamp(*ended_at_);
         }
         
         // Export span data
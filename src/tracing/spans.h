@@ -8,6 +8,8 @@
  */
 
 #include "span_data.h"
+#include "ids.h"
+#include "timestamp.h"
 #include "../logger.h"
 #include <string>
 #include <memory>
@@ -45,12 +47,12 @@ public:
     /**
      * Get the trace ID this span belongs to
      */
-    virtual const std::string& get_trace_id() const = 0;
+    virtual const TraceId& get_trace_id() const = 0;
     
     /**
      * Get the unique span ID
      */
-    virtual const std::string& get_span_id() const = 0;
+    virtual const SpanId& get_span_id() const = 0;
     
     /**
      * Get the span data
@@ -60,7 +62,7 @@ public:
     /**
      * Get the parent span ID (if any)
      */
-    virtual const std::optional<std::string>& get_parent_id() const = 0;
+    virtual const std::optional<SpanId>& get_parent_id() const = 0;
     
     /**
      * Start the span
@@ -87,14 +89,26 @@ public:
     virtual const std::optional<SpanError>& get_error() const = 0;
     
     /**
-     * Get the start time
+     * Get the start time in nanoseconds since the Unix epoch
      */
-    virtual const std::optional<std::string>& get_started_at() const = 0;
+    virtual std::optional<int64_t> get_started_at() const = 0;
     
     /**
-     * Get the end time
+     * Get the end time in nanoseconds since the Unix epoch
      */
-    virtual const std::optional<std::string>& get_ended_at() const = 0;
+    virtual std::optional<int64_t> get_ended_at() const = 0;
+    
+    /**
+     * Get the time between start and finish
+     */
+    std::optional<std::chrono::nanoseconds> get_duration() const {
+        auto started_at = get_started_at();
+        auto ended_at = get_ended_at();
+        if (!started_at || !ended_at) {
+            return std::nullopt;
+        }
+        return std::chrono::nanoseconds(*ended_at - *started_at);
+    }
     
     /**
      * Export the span as JSON
@@ -125,13 +139,13 @@ public:
     explicit NoOpSpan(const TSpanData& span_data) 
         : span_data_(span_data), is_current_(false) {}
     
-    const std::string& get_trace_id() const override {
-        static const std::string no_op = "no-op";
+    const TraceId& get_trace_id() const override {
+        static const TraceId no_op;
         return no_op;
     }
     
-    const std::string& get_span_id() const override {
-        static const std::string no_op = "no-op";
+    const SpanId& get_span_id() const override {
+        static const SpanId no_op;
         return no_op;
     }
     
@@ -139,8 +153,8 @@ public:
         return span_data_;
     }
     
-    const std::optional<std::string>& get_parent_id() const override {
-        static const std::optional<std::string> no_parent = std::nullopt;
+    const std::optional<SpanId>& get_parent_id() const override {
+        static const std::optional<SpanId> no_parent = std::nullopt;
         return no_parent;
     }
     
@@ -163,14 +177,12 @@ public:
         return no_error;
     }
     
-    const std::optional<std::string>& get_started_at() const override {
-        static const std::optional<std::string> no_time = std::nullopt;
-        return no_time;
+    std::optional<int64_t> get_started_at() const override {
+        return std::nullopt;
     }
     
-    const std::optional<std::string>& get_ended_at() const override {
-        static const std::optional<std::string> no_time = std::nullopt;
-        return no_time;
+    std::optional<int64_t> get_ended_at() const override {
+        return std::nullopt;
     }
     
     std::optional<nlohmann::json> export_span() const override {
@@ -193,35 +205,30 @@ public:
 template<typename TSpanData>
 class SpanImpl : public Span<TSpanData> {
 private:
-    std::string trace_id_;
-    std::string span_id_;
-    std::optional<std::string> parent_id_;
+    TraceId trace_id_;
+    SpanId span_id_;
+    std::optional<SpanId> parent_id_;
     TSpanData span_data_;
-    std::optional<std::string> started_at_;
-    std::optional<std::string> ended_at_;
+    std::optional<int64_t> started_at_;
+    std::optional<int64_t> ended_at_;
     std::optional<SpanError> error_;
     std::shared_ptr<TracingProcessor> processor_;
     bool is_current_;
     
-    /**
-     * Get current time in ISO format
-     */
-    std::string current_time_iso() const;
-    
 public:
     SpanImpl(
-        const std::string& trace_id,
-        const std::string& span_id,
-        const std::optional<std::string>& parent_id,
+        const TraceId& trace_id,
+        const SpanId& span_id,
+        const std::optional<SpanId>& parent_id,
         const TSpanData& span_data,
         std::shared_ptr<TracingProcessor> processor
     );
     
-    const std::string& get_trace_id() const override {
+    const TraceId& get_trace_id() const override {
         return trace_id_;
     }
     
-    const std::string& get_span_id() const override {
+    const SpanId& get_span_id() const override {
         return span_id_;
     }
     
@@ -229,7 +236,7 @@ public:
         return span_data_;
     }
     
-    const std::optional<std::string>& get_parent_id() const override {
+    const std::optional<SpanId>& get_parent_id() const override {
         return parent_id_;
     }
     
@@ -245,11 +252,11 @@ public:
         return error_;
     }
     
-    const std::optional<std::string>& get_started_at() const override {
+    std::optional<int64_t> get_started_at() const override {
         return started_at_;
     }
     
-    const std::optional<std::string>& get_ended_at() const override {
+    std::optional<int64_t> get_ended_at() const override {
         return ended_at_;
     }
     
@@ -360,12 +367,12 @@ using MCPListToolsSpan = Span<MCPListToolsSpanData>;
  */
 class AnySpan {
 private:
-    std::string trace_id_;
-    std::string span_id_;
-    std::optional<std::string> parent_id_;
+    TraceId trace_id_;
+    SpanId span_id_;
+    std::optional<SpanId> parent_id_;
     std::unique_ptr<SpanData> span_data_;
-    std::optional<std::string> started_at_;
-    std::optional<std::string> ended_at_;
+    std::optional<int64_t> started_at_;
+    std::optional<int64_t> ended_at_;
     std::optional<SpanError> error_;
     
 public:
@@ -379,12 +386,18 @@ public:
           ended_at_(span.get_ended_at()),
           error_(span.get_error()) {}
     
-    const std::string& get_trace_id() const { return trace_id_; }
-    const std::string& get_span_id() const { return span_id_; }
-    const std::optional<std::string>& get_parent_id() const { return parent_id_; }
+    const TraceId& get_trace_id() const { return trace_id_; }
+    const SpanId& get_span_id() const { return span_id_; }
+    const std::optional<SpanId>& get_parent_id() const { return parent_id_; }
     const SpanData& get_span_data() const { return *span_data_; }
-    const std::optional<std::string>& get_started_at() const { return started_at_; }
-    const std::optional<std::string>& get_ended_at() const { return ended_at_; }
+    std::optional<int64_t> get_started_at() const { return started_at_; }
+    std::optional<int64_t> get_ended_at() const { return ended_at_; }
+    std::optional<std::chrono::nanoseconds> get_duration() const {
+        if (!started_at_ || !ended_at_) {
+            return std::nullopt;
+        }
+        return std::chrono::nanoseconds(*ended_at_ - *started_at_);
+    }
     const std::optional<SpanError>& get_error() const { return error_; }
     
     std::optional<nlohmann::json> export_span() const;
@@ -0,0 +1,77 @@
+#pragma once
+
+/**
+ * Timestamps for OpenAI Agents Framework Tracing
+ *
+ * Spans and traces record time as int64 nanoseconds since the Unix epoch.
+ * The wall clock is read once per process; every later reading adds
+ * steady_clock time to that anchor, so timestamps never go backwards
+ * and differences between them are exact durations. ISO 8601 strings
+ * are only produced when spans and traces are exported.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+
+namespace openai_agents {
+namespace tracing {
+
+/**
+ * Current time in nanoseconds since the Unix epoch
+ */
+inline int64_t now_ns() {
+    using namespace std::chrono;
+
+    struct Anchor {
+        int64_t wall_ns;
+        steady_clock::time_point steady;
+    };
+    static const Anchor anchor{
+        duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count(),
+        steady_clock::now()
+    };
+
+    return anchor.wall_ns + duration_cast<nanoseconds>(steady_clock::now() - anchor.steady).count();
+}
+
+/**
+ * Format nanoseconds since the Unix epoch as an ISO 8601 UTC string
+ * with microsecond precision, e.g. 2025-01-31T12:00:00.123456Z
+ */
+inline std::string format_timestamp(int64_t ns) {
+    constexpr int64_t ns_per_day = 86400LL * 1000000000LL;
+    int64_t days = ns / ns_per_day;
+    int64_t rest = ns % ns_per_day;
+    if (rest < 0) {
+        rest += ns_per_day;
+        days--;
+    }
+
+    // Civil date from days since 1970-01-01 (proleptic Gregorian)
+    int64_t z = days + 719468;
+    int64_t era = (z >= 0 ? z : z - 146096) / 146097;
+    int64_t doe = z - era * 146097;
+    int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    int64_t mp = (5 * doy + 2) / 153;
+    int64_t day = doy - (153 * mp + 2) / 5 + 1;
+    int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    int64_t year = yoe + era * 400 + (month <= 2 ? 1 : 0);
+
+    int64_t seconds = rest / 1000000000LL;
+    int64_t micros = (rest % 1000000000LL) / 1000;
+
+    char buffer[40];
+    int length = std::snprintf(
+        buffer, sizeof(buffer), "%04lld-%02lld-%02lldT%02lld:%02lld:%02lld.%06lldZ",
+        static_cast<long long>(year), static_cast<long long>(month), static_cast<long long>(day),
+        static_cast<long long>(seconds / 3600), static_cast<long long>(seconds / 60 % 60),
+        static_cast<long long>(seconds % 60), static_cast<long long>(micros)
+    );
+    return std::string(buffer, length > 0 ? static_cast<size_t>(length) : 0);
+}
+
+} // namespace tracing
+} // namespace openai_agents
\ No newline at end of file
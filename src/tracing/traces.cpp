@@ -1,28 +1,14 @@
 #include "traces.h"
 #include "processor_interface.h"
-#include <sstream>
-#include <iomanip>
-#include <random>
 #include <algorithm>
+#include <deque>
 
 namespace openai_agents {
 namespace tracing {
 
 // Trace implementation
-std::string Trace::current_time_iso() const {
-    auto now = std::chrono::system_clock::now();
-    auto time_t = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()) % 1000;
-    
-    std::stringstream ss;
-    ss << std::put_time(std::gmtime(&time_t), "%Y-%m-%dT%H:%M:%S");
-    ss << '.' << std::setfill('0') << std::setw(3) << ms.count() << 'Z';
-    return ss.str();
-}
-
-Trace::Trace(const std::string& trace_id) : trace_id_(trace_id) {
-    started_at_ = current_time_iso();
+Trace::Trace(const TraceId& trace_id) : trace_id_(trace_id) {
+    started_at_ = now_ns();
 }
 
 std::vector<const AnySpan*> Trace::get_spans() const {
@@ -34,7 +20,7 @@ std::vector<const AnySpan*> Trace::get_spans() const {
     return result;
 }
 
-const AnySpan* Trace::get_span_by_id(const std::string& span_id) const {
+const AnySpan* Trace::get_span_by_id(const SpanId& span_id) const {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     for (const auto& span : spans_) {
         if (span->get_span_id() == span_id) {
@@ -55,7 +41,7 @@ std::vector<const AnySpan*> Trace::get_root_spans() const {
     return result;
 }
 
-std::vector<const AnySpan*> Trace::get_child_spans(const std::string& parent_span_id) const {
+std::vector<const AnySpan*> Trace::get_child_spans(const SpanId& parent_span_id) const {
     std::lock_guard<std::mutex> lock(spans_mutex_);
     std::vector<const AnySpan*> result;
     for (const auto& span : spans_) {
@@ -68,7 +54,7 @@ std::vector<const AnySpan*> Trace::get_child_spans(const std::string& parent_spa
 
 void Trace::finish() {
     if (!is_finished_.exchange(true)) {
-        ended_at_ = current_time_iso();
+        ended_at_ = now_ns();
     }
 }
 
@@ -76,12 +62,12 @@ std::optional<nlohmann::json> Trace::export_trace() const {
     try {
         nlohmann::json trace_json;
         
-        trace_json["trace_id"] = trace_id_;
+        trace_json["trace_id"] = trace_id_.to_string();
         if (started_at_) {
-            trace_json["started_at"] = *started_at_;
+            trace_json["started_at"] = format_timestamp(*started_at_);
         }
         if (ended_at_) {
-            trace_json["ended_at"] = *ended_at_;
+            trace_json["ended_at"] = format_timestamp(*ended_at_);
         }
         trace_json["is_finished"] = is_finished_.load();
         
@@ -109,23 +95,25 @@ std::optional<nlohmann::json> Trace::export_trace() const {
         }
         
         // Export spans
-        std::lock_guard<std::mutex> lock(spans_mutex_);
         nlohmann::json spans_json = nlohmann::json::array();
-        for (const auto& span : spans_) {
-            auto span_json = span->export_span();
-            if (span_json) {
-                spans_json.push_back(*span_json);
+        {
+            std::lock_guard<std::mutex> lock(spans_mutex_);
+            for (const auto& span : spans_) {
+                auto span_json = span->export_span();
+                if (span_json) {
+                    spans_json.push_back(*span_json);
+                }
             }
         }
         trace_json["spans"] = spans_json;
         
-        // Add statistics
+        // Add statistics (get_stats takes the spans lock itself)
         auto stats = get_stats();
         nlohmann::json stats_json;
         stats_json["total_spans"] = stats.total_spans;
         stats_json["error_spans"] = stats.error_spans;
         if (stats.duration) {
-            stats_json["duration_ms"] = stats.duration->count();
+            stats_json["duration_ms"] = std::chrono::duration<double, std::milli>(*stats.duration).count();
         }
         stats_json["span_types"] = stats.span_types;
         trace_json["stats"] = stats_json;
@@ -161,18 +149,240 @@ Trace::TraceStats Trace::get_stats() const {
     return stats;
 }
 
-std::optional<std::chrono::milliseconds> Trace::get_duration() const {
-    if (started_at_ && ended_at_) {
-        try {
-            // Parse ISO timestamps and calculate duration
-            // This is a simplified implementation
-            // In a real implementation, you'd use a proper datetime parsing library
-            return std::chrono::milliseconds(1000); // Placeholder
-        } catch (const std::exception&) {
-            return std::nullopt;
+std::optional<std::chrono::nanoseconds> Trace::get_duration() const {
+    if (!started_at_) {
+        return std::nullopt;
+    }
+    int64_t end = ended_at_ ? *ended_at_ : now_ns();
+    return std::chrono::nanoseconds(end - *started_at_);
+}
+
+// Tail sampling: spans of tracked traces are held until the trace finishes
+class TailSampler : public std::enable_shared_from_this<TailSampler> {
+private:
+    using HeldSpan = std::pair<std::shared_ptr<TracingProcessor>, nlohmann::json>;
+    
+    struct PendingTrace {
+        std::vector<HeldSpan> spans;
+        bool has_error = false;
+        bool passthrough = false;  // kept early after overflowing
+    };
+    
+    // Decisions remembered for spans that finish after their trace
+    static constexpr size_t kMaxRememberedDecisions = 4096;
+    
+    TailSamplingOptions options_;
+    mutable std::mutex mutex_;
+    std::unordered_map<TraceId, PendingTrace> pending_;
+    std::unordered_map<TraceId, bool> decisions_;
+    std::deque<TraceId> decision_order_;
+    std::unordered_map<TracingProcessor*, std::shared_ptr<TracingProcessor>> routers_;
+    TailSamplingStats stats_;
+    
+    void remember_decision(const TraceId& trace_id, bool keep) {
+        if (decisions_.emplace(trace_id, keep).second) {
+            decision_order_.push_back(trace_id);
+            if (decision_order_.size() > kMaxRememberedDecisions) {
+                decisions_.erase(decision_order_.front());
+                decision_order_.pop_front();
+            }
+        }
+    }
+    
+    // Sends held spans on, one batch per run of spans with the same processor
+    static void forward(std::vector<HeldSpan>& spans) {
+        size_t start = 0;
+        while (start < spans.size()) {
+            size_t end = start;
+            std::vector<nlohmann::json> batch;
+            while (end < spans.size() && spans[end].first == spans[start].first) {
+                batch.push_back(std::move(spans[end].second));
+                end++;
+            }
+            try {
+                spans[start].first->process_spans_batch(batch);
+            } catch (const std::exception& e) {
+                logger::error("Failed to process sampled spans: " + std::string(e.what()));
+            }
+            start = end;
+        }
+    }
+    
+public:
+    explicit TailSampler(const TailSamplingOptions& options) : options_(options) {}
+    
+    void track(const TraceId& trace_id) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.try_emplace(trace_id);
+    }
+    
+    std::shared_ptr<TracingProcessor> router_for(
+        const TraceId& trace_id,
+        const std::shared_ptr<TracingProcessor>& processor
+    );
+    
+    void add_span(const std::shared_ptr<TracingProcessor>& processor, const nlohmann::json& span_data) {
+        std::optional<TraceId> trace_id;
+        auto it = span_data.find("trace_id");
+        if (it != span_data.end() && it->is_string()) {
+            trace_id = TraceId::parse(it->get_ref<const std::string&>());
+        }
+        
+        std::vector<HeldSpan> release;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto pending = trace_id ? pending_.find(*trace_id) : pending_.end();
+            if (pending != pending_.end() && !pending->second.passthrough) {
+                PendingTrace& trace = pending->second;
+                trace.has_error = trace.has_error || span_data.contains("error");
+                trace.spans.emplace_back(processor, span_data);
+                stats_.buffered_spans++;
+                if (trace.spans.size() <= options_.max_spans_per_trace) {
+                    return;
+                }
+                
+                // Too large to hold: keep it and let the rest through
+                trace.passthrough = true;
+                stats_.kept_for_overflow++;
+                stats_.buffered_spans -= trace.spans.size();
+                release.swap(trace.spans);
+            } else if (pending == pending_.end() && trace_id) {
+                auto decision = decisions_.find(*trace_id);
+                if (decision != decisions_.end() && !decision->second) {
+                    stats_.spans_dropped++;
+                    return;
+                }
+            }
+        }
+        
+        if (release.empty()) {
+            processor->process_span(span_data);
+        } else {
+            forward(release);
+        }
+    }
+    
+    // Decides a finished trace and forwards or drops its held spans.
+    // Returns whether the trace itself should be exported.
+    bool finish(const TraceId& trace_id, std::optional<std::chrono::nanoseconds> duration) {
+        PendingTrace trace;
+        bool keep = true;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            auto it = pending_.find(trace_id);
+            if (it == pending_.end()) {
+                // Started before sampling was enabled
+                return true;
+            }
+            trace = std::move(it->second);
+            pending_.erase(it);
+            stats_.buffered_spans -= trace.spans.size();
+            
+            if (trace.passthrough) {
+                keep = true;
+            } else if (options_.keep_errors && trace.has_error) {
+                stats_.kept_for_error++;
+            } else if (options_.latency_threshold && duration && *duration >= *options_.latency_threshold) {
+                stats_.kept_for_latency++;
+            } else if (sample_trace_id(trace_id, options_.rate)) {
+                stats_.kept_for_rate++;
+            } else {
+                keep = false;
+            }
+            
+            if (keep) {
+                stats_.traces_kept++;
+            } else {
+                stats_.traces_dropped++;
+                stats_.spans_dropped += trace.spans.size();
+            }
+            remember_decision(trace_id, keep);
+        }
+        
+        if (keep) {
+            forward(trace.spans);
+        }
+        return keep;
+    }
+    
+    // Exports everything still held, undecided
+    void release_all() {
+        std::vector<HeldSpan> release;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (auto& [_, trace] : pending_) {
+                for (auto& span : trace.spans) {
+                    release.push_back(std::move(span));
+                }
+            }
+            pending_.clear();
+            stats_.buffered_spans = 0;
+        }
+        forward(release);
+    }
+    
+    void clear() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.clear();
+        decisions_.clear();
+        decision_order_.clear();
+        stats_.buffered_spans = 0;
+    }
+    
+    TailSamplingStats get_stats() const {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return stats_;
+    }
+};
+
+// Processor handed to spans of a tracked trace; passes them to the sampler
+class TailSamplingRouter : public TracingProcessor {
+private:
+    std::weak_ptr<TailSampler> sampler_;
+    std::shared_ptr<TracingProcessor> processor_;
+    
+public:
+    TailSamplingRouter(std::weak_ptr<TailSampler> sampler, std::shared_ptr<TracingProcessor> processor)
+        : sampler_(std::move(sampler)), processor_(std::move(processor)) {}
+    
+    void process_span(const nlohmann::json& span_data) override {
+        if (auto sampler = sampler_.lock()) {
+            sampler->add_span(processor_, span_data);
+        } else {
+            processor_->process_span(span_data);
+        }
+    }
+    
+    void process_trace(const nlohmann::json& trace_data) override {
+        processor_->process_trace(trace_data);
+    }
+    
+    void flush() override { processor_->flush(); }
+    void shutdown() override { processor_->shutdown(); }
+    nlohmann::json get_config() const override { return processor_->get_config(); }
+    nlohmann::json get_status() const override { return processor_->get_status(); }
+};
+
+std::shared_ptr<TracingProcessor> TailSampler::router_for(
+    const TraceId& trace_id,
+    const std::shared_ptr<TracingProcessor>& processor
+) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto pending = pending_.find(trace_id);
+    bool held = pending != pending_.end() && !pending->second.passthrough;
+    if (!held) {
+        // Spans of a trace that was already dropped are dropped too
+        auto decision = decisions_.find(trace_id);
+        if (decision == decisions_.end() || decision->second) {
+            return processor;
         }
     }
-    return std::nullopt;
+    
+    auto& router = routers_[processor.get()];
+    if (!router) {
+        router = std::make_shared<TailSamplingRouter>(weak_from_this(), processor);
+    }
+    return router;
 }
 
 // TraceManager implementation
@@ -181,6 +391,13 @@ TraceManager::TraceManager(
     size_t max_finished_traces
 ) : processor_(processor), max_finished_traces_(max_finished_traces) {}
 
+TraceManager::~TraceManager() {
+    // Spans still held for tail sampling are exported rather than lost
+    if (tail_sampler_) {
+        tail_sampler_->release_all();
+    }
+}
+
 void TraceManager::cleanup_finished_traces() {
     if (finished_traces_.size() > max_finished_traces_) {
         size_t to_remove = finished_traces_.size() - max_finished_traces_;
@@ -188,23 +405,26 @@ void TraceManager::cleanup_finished_traces() {
     }
 }
 
-std::string TraceManager::create_trace(const std::optional<std::string>& trace_id) {
-    std::string id = trace_id.value_or(trace_utils::generate_trace_id());
+TraceId TraceManager::create_trace(const std::optional<TraceId>& trace_id) {
+    TraceId id = trace_id ? *trace_id : trace_utils::generate_trace_id();
     
     std::lock_guard<std::mutex> lock(traces_mutex_);
     auto trace = std::make_unique<Trace>(id);
     active_traces_[id] = std::move(trace);
+    if (tail_sampler_) {
+        tail_sampler_->track(id);
+    }
     
     return id;
 }
 
-Trace* TraceManager::get_active_trace(const std::string& trace_id) {
+Trace* TraceManager::get_active_trace(const TraceId& trace_id) {
     std::lock_guard<std::mutex> lock(traces_mutex_);
     auto it = active_traces_.find(trace_id);
     return (it != active_traces_.end()) ? it->second.get() : nullptr;
 }
 
-const Trace* TraceManager::get_finished_trace(const std::string& trace_id) const {
+const Trace* TraceManager::get_finished_trace(const TraceId& trace_id) const {
     std::lock_guard<std::mutex> lock(traces_mutex_);
     auto it = std::find_if(finished_traces_.begin(), finished_traces_.end(),
         [&trace_id](const auto& trace) {
@@ -213,14 +433,20 @@ const Trace* TraceManager::get_finished_trace(const std::string& trace_id) const
     return (it != finished_traces_.end()) ? it->get() : nullptr;
 }
 
-void TraceManager::finish_trace(const std::string& trace_id) {
+void TraceManager::finish_trace(const TraceId& trace_id) {
     std::lock_guard<std::mutex> lock(traces_mutex_);
     auto it = active_traces_.find(trace_id);
     if (it != active_traces_.end()) {
         it->second->finish();
         
+        // Tail sampling decides now whether the trace and its held spans are exported
+        bool keep = true;
+        if (tail_sampler_) {
+            keep = tail_sampler_->finish(trace_id, it->second->get_duration());
+        }
+        
         // Send to processor if available
-        if (processor_) {
+        if (processor_ && keep) {
             try {
                 auto exported = it->second->export_trace();
                 if (exported) {
@@ -239,18 +465,18 @@ void TraceManager::finish_trace(const std::string& trace_id) {
     }
 }
 
-std::vector<std::string> TraceManager::get_active_trace_ids() const {
+std::vector<TraceId> TraceManager::get_active_trace_ids() const {
     std::lock_guard<std::mutex> lock(traces_mutex_);
-    std::vector<std::string> result;
+    std::vector<TraceId> result;
     for (const auto& [id, _] : active_traces_) {
         result.push_back(id);
     }
     return result;
 }
 
-std::vector<std::string> TraceManager::get_finished_trace_ids() const {
+std::vector<TraceId> TraceManager::get_finished_trace_ids() const {
     std::lock_guard<std::mutex> lock(traces_mutex_);
-    std::vector<std::string> result;
+    std::vector<TraceId> result;
     for (const auto& trace : finished_traces_) {
         result.push_back(trace->get_trace_id());
     }
@@ -287,6 +513,9 @@ void TraceManager::clear_all_traces() {
     std::lock_guard<std::mutex> lock(traces_mutex_);
     active_traces_.clear();
     finished_traces_.clear();
+    if (tail_sampler_) {
+        tail_sampler_->clear();
+    }
 }
 
 std::vector<nlohmann::json> TraceManager::export_all_traces() const {
@@ -328,12 +557,60 @@ void TraceManager::set_processor(std::shared_ptr<TracingProcessor> processor) {
     processor_ = processor;
 }
 
+void TraceManager::enable_tail_sampling(const TailSamplingOptions& options) {
+    std::shared_ptr<TailSampler> previous;
+    {
+        std::lock_guard<std::mutex> lock(traces_mutex_);
+        previous = std::move(tail_sampler_);
+        tail_sampler_ = std::make_shared<TailSampler>(options);
+    }
+    if (previous) {
+        previous->release_all();
+    }
+}
+
+void TraceManager::disable_tail_sampling() {
+    std::shared_ptr<TailSampler> previous;
+    {
+        std::lock_guard<std::mutex> lock(traces_mutex_);
+        previous = std::move(tail_sampler_);
+    }
+    if (previous) {
+        previous->release_all();
+    }
+}
+
+bool TraceManager::is_tail_sampling_enabled() const {
+    std::lock_guard<std::mutex> lock(traces_mutex_);
+    return tail_sampler_ != nullptr;
+}
+
+TailSamplingStats TraceManager::get_tail_sampling_stats() const {
+    std::lock_guard<std::mutex> lock(traces_mutex_);
+    return tail_sampler_ ? tail_sampler_->get_stats() : TailSamplingStats{};
+}
+
+std::shared_ptr<TracingProcessor> TraceManager::get_span_processor(
+    const TraceId& trace_id,
+    std::shared_ptr<TracingProcessor> processor
+) {
+    std::shared_ptr<TailSampler> sampler;
+    {
+        std::lock_guard<std::mutex> lock(traces_mutex_);
+        sampler = tail_sampler_;
+    }
+    if (!sampler || !processor) {
+        return processor;
+    }
+    return sampler->router_for(trace_id, processor);
+}
+
 Trace* TraceManager::get_current_trace() {
     auto trace_id = ScopedTracingContext::get_current_trace_id();
     return trace_id ? get_active_trace(*trace_id) : nullptr;
 }
 
-std::string TraceManager::start_current_trace(const std::optional<std::string>& trace_id) {
+TraceId TraceManager::start_current_trace(const std::optional<TraceId>& trace_id) {
     auto id = create_trace(trace_id);
     ScopedTracingContext::set_current_trace_id(id);
     return id;
@@ -378,13 +655,13 @@ bool GlobalTraceManager::is_initialized() {
 }
 
 // TraceGuard implementation
-TraceGuard::TraceGuard(const std::optional<std::string>& trace_id)
+TraceGuard::TraceGuard(const std::optional<TraceId>& trace_id)
     : should_finish_(true), scope_(ScopedTracingContext::create_disabled_scope()) {
     trace_id_ = GlobalTraceManager::instance().start_current_trace(trace_id);
     scope_ = ScopedTracingContext::create_trace_scope(trace_id_);
 }
 
-TraceGuard::TraceGuard(const std::string& existing_trace_id, bool should_finish)
+TraceGuard::TraceGuard(const TraceId& existing_trace_id, bool should_finish)
     : trace_id_(existing_trace_id), should_finish_(should_finish),
       scope_(ScopedTracingContext::create_trace_scope(existing_trace_id)) {}
 
@@ -401,33 +678,15 @@ Trace* TraceGuard::get_trace() const {
 // Utility functions
 namespace trace_utils {
 
-std::string generate_trace_id() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    
-    std::stringstream ss;
-    ss << "trace_";
-    for (int i = 0; i < 16; ++i) {
-        ss << std::hex << dis(gen);
-    }
-    return ss.str();
+TraceId generate_trace_id() {
+    return TraceId::generate();
 }
 
-std::string generate_span_id() {
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_int_distribution<> dis(0, 15);
-    
-    std::stringstream ss;
-    ss << "span_";
-    for (int i = 0; i < 12; ++i) {
-        ss << std::hex << dis(gen);
-    }
-    return ss.str();
+SpanId generate_span_id() {
+    return SpanId::generate();
 }
 
-std::string get_or_create_current_trace() {
+TraceId get_or_create_current_trace() {
     auto trace_id = ScopedTracingContext::get_current_trace_id();
     if (trace_id) {
         return *trace_id;
@@ -9,6 +9,7 @@
 
 #include "spans.h"
 #include "scope.h"
+#include "sampling.h"
 #include "../logger.h"
 #include <string>
 #include <vector>
@@ -30,39 +31,34 @@ class TracingProcessor;
  */
 class Trace {
 private:
-    std::string trace_id_;
+    TraceId trace_id_;
     std::vector<std::unique_ptr<AnySpan>> spans_;
-    std::optional<std::string> started_at_;
-    std::optional<std::string> ended_at_;
+    std::optional<int64_t> started_at_;
+    std::optional<int64_t> ended_at_;
     std::unordered_map<std::string, std::any> metadata_;
     mutable std::mutex spans_mutex_;
     std::atomic<bool> is_finished_{false};
     
-    /**
-     * Get current time in ISO format
-     */
-    std::string current_time_iso() const;
-    
 public:
     /**
      * Create a new trace with the given ID
      */
-    explicit Trace(const std::string& trace_id);
+    explicit Trace(const TraceId& trace_id);
     
     /**
      * Get the trace ID
      */
-    const std::string& get_trace_id() const { return trace_id_; }
+    const TraceId& get_trace_id() const { return trace_id_; }
     
     /**
-     * Get the start time
+     * Get the start time in nanoseconds since the Unix epoch
      */
-    const std::optional<std::string>& get_started_at() const { return started_at_; }
+    std::optional<int64_t> get_started_at() const { return started_at_; }
     
     /**
-     * Get the end time
+     * Get the end time in nanoseconds since the Unix epoch
      */
-    const std::optional<std::string>& get_ended_at() const { return ended_at_; }
+    std::optional<int64_t> get_ended_at() const { return ended_at_; }
     
     /**
      * Check if the trace is finished
@@ -79,7 +75,7 @@ public:
         
         // Set start time if this is the first span
         if (spans_.size() == 1 && !started_at_) {
-            started_at_ = current_time_iso();
+            started_at_ = now_ns();
         }
     }
     
@@ -114,7 +110,7 @@ public:
     /**
      * Get a span by its ID
      */
-    const AnySpan* get_span_by_id(const std::string& span_id) const;
+    const AnySpan* get_span_by_id(const SpanId& span_id) const;
     
     /**
      * Get the root spans (spans with no parent)
@@ -124,7 +120,7 @@ public:
     /**
      * Get child spans of a given span
      */
-    std::vector<const AnySpan*> get_child_spans(const std::string& parent_span_id) const;
+    std::vector<const AnySpan*> get_child_spans(const SpanId& parent_span_id) const;
     
     /**
      * Get metadata
@@ -171,16 +167,16 @@ public:
     struct TraceStats {
         size_t total_spans = 0;
         size_t error_spans = 0;
-        std::optional<std::chrono::milliseconds> duration;
+        std::optional<std::chrono::nanoseconds> duration;
         std::unordered_map<std::string, size_t> span_types;
     };
     
     TraceStats get_stats() const;
     
     /**
-     * Get trace duration in milliseconds
+     * Get trace duration; for an unfinished trace, the time elapsed so far
      */
-    std::optional<std::chrono::milliseconds> get_duration() const;
+    std::optional<std::chrono::nanoseconds> get_duration() const;
     
     // Non-copyable
     Trace(const Trace&) = delete;
@@ -196,12 +192,13 @@ public:
  */
 class TraceManager {
 private:
-    std::unordered_map<std::string, std::unique_ptr<Trace>> active_traces_;
+    std::unordered_map<TraceId, std::unique_ptr<Trace>> active_traces_;
     std::vector<std::unique_ptr<Trace>> finished_traces_;
     mutable std::mutex traces_mutex_;
     std::shared_ptr<TracingProcessor> processor_;
     size_t max_finished_traces_;
     std::atomic<size_t> trace_counter_{0};
+    std::shared_ptr<class TailSampler> tail_sampler_;
     
     /**
      * Clean up old finished traces
@@ -217,26 +214,28 @@ public:
         size_t max_finished_traces = 1000
     );
     
+    ~TraceManager();
+    
     /**
      * Create a new trace
      */
-    std::string create_trace(const std::optional<std::string>& trace_id = std::nullopt);
+    TraceId create_trace(const std::optional<TraceId>& trace_id = std::nullopt);
     
     /**
      * Get an active trace by ID
      */
-    Trace* get_active_trace(const std::string& trace_id);
+    Trace* get_active_trace(const TraceId& trace_id);
     
     /**
      * Get a finished trace by ID
      */
-    const Trace* get_finished_trace(const std::string& trace_id) const;
+    const Trace* get_finished_trace(const TraceId& trace_id) const;
     
     /**
      * Add a span to a trace
      */
     template<typename TSpanData>
-    void add_span_to_trace(const std::string& trace_id, const Span<TSpanData>& span) {
+    void add_span_to_trace(const TraceId& trace_id, const Span<TSpanData>& span) {
         std::lock_guard<std::mutex> lock(traces_mutex_);
         auto it = active_traces_.find(trace_id);
         if (it != active_traces_.end()) {
@@ -247,17 +246,17 @@ public:
     /**
      * Finish a trace
      */
-    void finish_trace(const std::string& trace_id);
+    void finish_trace(const TraceId& trace_id);
     
     /**
      * Get all active trace IDs
      */
-    std::vector<std::string> get_active_trace_ids() const;
+    std::vector<TraceId> get_active_trace_ids() const;
     
     /**
      * Get all finished trace IDs
      */
-    std::vector<std::string> get_finished_trace_ids() const;
+    std::vector<TraceId> get_finished_trace_ids() const;
     
     /**
      * Get trace statistics
@@ -266,7 +265,7 @@ public:
         size_t active_traces = 0;
         size_t finished_traces = 0;
         size_t total_spans = 0;
-        std::optional<std::chrono::milliseconds> oldest_active_trace_duration;
+        std::optional<std::chrono::nanoseconds> oldest_active_trace_duration;
     };
     
     ManagerStats get_stats() const;
@@ -291,6 +290,37 @@ public:
      */
     void set_processor(std::shared_ptr<TracingProcessor> processor);
     
+    /**
+     * Hold back the spans of traces started from now on until each trace
+     * finishes, then export them only if the policy keeps the trace.
+     * Replacing an earlier policy releases what it was holding.
+     */
+    void enable_tail_sampling(const TailSamplingOptions& options);
+    
+    /**
+     * Stop tail sampling; spans still held back are exported
+     */
+    void disable_tail_sampling();
+    
+    /**
+     * Check if tail sampling is enabled
+     */
+    bool is_tail_sampling_enabled() const;
+    
+    /**
+     * Get tail sampling counters
+     */
+    TailSamplingStats get_tail_sampling_stats() const;
+    
+    /**
+     * Get the processor a new span in the given trace should report to:
+     * the given processor, or one that holds the span for tail sampling
+     */
+    std::shared_ptr<TracingProcessor> get_span_processor(
+        const TraceId& trace_id,
+        std::shared_ptr<TracingProcessor> processor
+    );
+    
     /**
      * Get the current trace from context
      */
@@ -299,7 +329,7 @@ public:
     /**
      * Create a trace and set it as current
      */
-    std::string start_current_trace(const std::optional<std::string>& trace_id = std::nullopt);
+    TraceId start_current_trace(const std::optional<TraceId>& trace_id = std::nullopt);
     
     /**
      * Finish the current trace
@@ -353,7 +383,7 @@ public:
  */
 class TraceGuard {
 private:
-    std::string trace_id_;
+    TraceId trace_id_;
     bool should_finish_;
     ScopedContext scope_;
     
@@ -361,12 +391,12 @@ public:
     /**
      * Create a trace guard with a new trace
      */
-    explicit TraceGuard(const std::optional<std::string>& trace_id = std::nullopt);
+    explicit TraceGuard(const std::optional<TraceId>& trace_id = std::nullopt);
     
     /**
      * Create a trace guard with an existing trace
      */
-    explicit TraceGuard(const std::string& existing_trace_id, bool should_finish);
+    explicit TraceGuard(const TraceId& existing_trace_id, bool should_finish);
     
     /**
      * Destructor - finish trace if needed
@@ -376,7 +406,7 @@ public:
     /**
      * Get the trace ID
      */
-    const std::string& get_trace_id() const { return trace_id_; }
+    const TraceId& get_trace_id() const { return trace_id_; }
     
     /**
      * Get the trace
@@ -421,18 +451,18 @@ namespace trace_utils {
 /**
  * Generate a unique trace ID
  */
-std::string generate_trace_id();
+TraceId generate_trace_id();
 
 /**
  * Generate a unique span ID
  */
-std::string generate_span_id();
+SpanId generate_span_id();
 
 /**
  * Run a function within a trace context
  */
 template<typename Func>
-auto with_trace(Func&& func, const std::optional<std::string>& trace_id = std::nullopt) -> decltype(func()) {
+auto with_trace(Func&& func, const std::optional<TraceId>& trace_id = std::nullopt) -> decltype(func()) {
     auto guard = TraceGuard(trace_id);
     return func();
 }
@@ -440,7 +470,7 @@ auto with_trace(Func&& func, const std::optional<std::string>& trace_id = std::n
 /**
  * Get the current trace or create a new one
  */
-std::string get_or_create_current_trace();
+TraceId get_or_create_current_trace();
 
 /**
  * Check if there's an active trace
@@ -9,12 +9,13 @@
 #include "span_data.h"
 #include "spans.h"
 #include "traces.h"
+#include "ids.h"
 #include <nlohmann/json.hpp>
 #include <string>
 #include <vector>
 #include <chrono>
 #include <optional>
-#include <random>
+#include <cstring>
 
 namespace openai_agents {
 namespace tracing {
@@ -28,22 +29,58 @@ namespace id_gen {
 /**
  * Generate a random hex string of specified length
  */
-std::string random_hex(size_t length);
+inline std::string random_hex(size_t length) {
+    static constexpr char digits[] = "0123456789abcdef";
+    std::string result(length, '0');
+    uint64_t word = 0;
+    for (size_t i = 0; i < length; i++) {
+        if (i % 16 == 0) {
+            word = random_u64();
+        }
+        result[i] = digits[word & 0x0f];
+        word >>= 4;
+    }
+    return result;
+}
 
 /**
  * Generate a trace ID in the standard format
  */
-std::string trace_id();
+inline std::string trace_id() {
+    return TraceId::generate().to_string();
+}
 
 /**
  * Generate a span ID in the standard format
  */
-std::string span_id();
+inline std::string span_id() {
+    return SpanId::generate().to_string();
+}
 
 /**
  * Generate a UUID v4
  */
-std::string uuid();
+inline std::string uuid() {
+    static constexpr char digits[] = "0123456789abcdef";
+    uint8_t bytes[16];
+    uint64_t high = random_u64();
+    uint64_t low = random_u64();
+    std::memcpy(bytes, &high, 8);
+    std::memcpy(bytes + 8, &low, 8);
+    bytes[6] = static_cast<uint8_t>((bytes[6] & 0x0f) | 0x40);  // version 4
+    bytes[8] = static_cast<uint8_t>((bytes[8] & 0x3f) | 0x80);  // RFC 4122 variant
+
+    std::string result(36, '-');
+    size_t pos = 0;
+    for (size_t i = 0; i < 16; i++) {
+        if (i == 4 || i == 6 || i == 8 || i == 10) {
+            pos++;
+        }
+        result[pos++] = digits[bytes[i] >> 4];
+        result[pos++] = digits[bytes[i] & 0x0f];
+    }
+    return result;
+}
 
 } // namespace id_gen
 
@@ -161,7 +198,7 @@ std::vector<const AnySpan*> find_root_spans(const std::vector<const AnySpan*>& s
  */
 std::vector<const AnySpan*> find_child_spans(
     const std::vector<const AnySpan*>& spans, 
-    const std::string& parent_span_id
+    const SpanId& parent_span_id
 );
 
 /**